@@ -85,6 +85,12 @@ struct json_obj_token {
 struct json_obj_descr {
 	const char *field_name;
 
+	/* Hash of the field name, computed by the JSON_OBJ_DESCR_*
+	 * macros with Z_JSON_NAME_HASH() so that fields can be looked up
+	 * by name without comparing the name of each one.
+	 */
+	uint8_t field_name_hash;
+
 	/* Alignment can be 1, 2, 4, or 8.  The macros to create
 	 * a struct json_obj_descr will store the alignment's
 	 * power of 2 in order to keep this value in the 0-3 range
@@ -137,6 +143,16 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				 __alignof__(type) == 2 ? 1 : \
 				 __alignof__(type) == 4 ? 2 : 3)
 
+/* Hash of a field name given as a string literal, from its length and
+ * its first, middle and last characters so that it folds to a constant.
+ * Must match the hash json.c computes for the keys it parses.
+ */
+#define Z_JSON_NAME_HASH(name_) \
+	((uint8_t)(((sizeof(name_) - 1U) * 31U) + \
+		   ((uint8_t)(name_)[0] * 7U) + \
+		   ((uint8_t)(name_)[(sizeof(name_) - 1U) / 2U] * 3U) + \
+		   (uint8_t)(name_)[(sizeof(name_) > 1U) ? (sizeof(name_) - 2U) : 0U]))
+
 /**
  * @brief Helper macro to declare a descriptor for supported primitive
  * values.
@@ -160,6 +176,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 #define JSON_OBJ_DESCR_PRIM(struct_, field_name_, type_) \
 	{ \
 		.field_name = (#field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(#field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = sizeof(#field_name_) - 1, \
 		.type = type_, \
@@ -193,6 +210,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 #define JSON_OBJ_DESCR_OBJECT(struct_, field_name_, sub_descr_) \
 	{ \
 		.field_name = (#field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(#field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = (sizeof(#field_name_) - 1), \
 		.type = JSON_TOK_OBJECT_START, \
@@ -279,6 +297,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 			     len_field_, elem_type_) \
 	{ \
 		.field_name = (#field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(#field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = sizeof(#field_name_) - 1, \
 		.type = JSON_TOK_ARRAY_START, \
@@ -330,6 +349,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				 len_field_, elem_descr_, elem_descr_len_) \
 	{ \
 		.field_name = (#field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(#field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = sizeof(#field_name_) - 1, \
 		.type = JSON_TOK_ARRAY_START, \
@@ -391,6 +411,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				   elem_descr_, elem_descr_len_) \
 	{ \
 		.field_name = (#field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(#field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = sizeof(#field_name_) - 1, \
 		.type = JSON_TOK_ARRAY_START, \
@@ -425,6 +446,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				  struct_field_name_, type_) \
 	{ \
 		.field_name = (json_field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(json_field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = sizeof(json_field_name_) - 1, \
 		.type = type_, \
@@ -448,6 +470,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				    struct_field_name_, sub_descr_) \
 	{ \
 		.field_name = (json_field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(json_field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = (sizeof(json_field_name_) - 1), \
 		.type = JSON_TOK_OBJECT_START, \
@@ -481,6 +504,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				   elem_type_) \
 	{ \
 		.field_name = (json_field_name_), \
+		.field_name_hash = Z_JSON_NAME_HASH(json_field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = sizeof(json_field_name_) - 1, \
 		.type = JSON_TOK_ARRAY_START, \
@@ -540,6 +564,7 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				       elem_descr_len_) \
 	{ \
 		.field_name = json_field_name_, \
+		.field_name_hash = Z_JSON_NAME_HASH(json_field_name_), \
 		.align_shift = Z_ALIGN_SHIFT(struct_), \
 		.field_name_len = sizeof(json_field_name_) - 1, \
 		.type = JSON_TOK_ARRAY_START, \
@@ -658,6 +683,75 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/**
+ * @brief State for collecting an object delivered in several fragments
+ *
+ * Opaque to users; set up with json_obj_buffered_init().
+ */
+struct json_obj_buffered {
+	char *buf;
+	size_t buf_size;
+	size_t len;
+	const struct json_obj_descr *descr;
+	size_t descr_len;
+	void *val;
+	int64_t result;
+	uint16_t depth;
+	bool in_string : 1;
+	bool escaped : 1;
+	bool space : 1;
+	bool done : 1;
+};
+
+/**
+ * @brief Initialize buffered parsing of a JSON-encoded object
+ *
+ * This is a buffering helper, not an incremental parser: the fragments
+ * handed over with json_obj_buffered_feed(), for example straight from a
+ * chain of network buffers, are copied into @a buf, and the object is
+ * parsed with json_obj_parse() once its closing brace has arrived.  The
+ * fragments are only scanned on the way to find where the object ends,
+ * so there is no need to know the payload length up front.
+ *
+ * Decoded strings, opaque values and encoded objects point into @a buf,
+ * which must therefore outlive the use of @a val.  It only has to be
+ * large enough for the object with its insignificant whitespace removed.
+ *
+ * @param state Parser state to initialize
+ * @param buf Buffer the object is collected into
+ * @param buf_size Size of @a buf
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array, with the
+ * same limit as for json_obj_parse()
+ * @param val Pointer to the struct to hold the decoded values
+ *
+ * @return 0 on success, -EINVAL if no buffer was provided.
+ */
+int json_obj_buffered_init(struct json_obj_buffered *state, char *buf, size_t buf_size,
+			   const struct json_obj_descr *descr, size_t descr_len,
+			   void *val);
+
+/**
+ * @brief Append the next fragment of an object to its buffer
+ *
+ * Once the fragment holding the closing brace of the object has been
+ * fed, the buffered object is decoded with json_obj_parse(), and that
+ * result is returned for this and any later call.  Only whitespace may
+ * follow the object.
+ *
+ * @param state Parser state set up by json_obj_buffered_init()
+ * @param data Next fragment of the JSON-encoded object
+ * @param len Length of @a data
+ *
+ * @retval -EAGAIN The object is not complete yet, feed more data.
+ * @retval -ENOMEM The object does not fit into the buffer.
+ * @retval -EINVAL The data is not a well-formed object.
+ * @return Otherwise, as for json_obj_parse(): bitmap of decoded fields
+ * on success, or a negative error code.
+ */
+int64_t json_obj_buffered_feed(struct json_obj_buffered *state, const char *data,
+			       size_t len);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -35,6 +35,10 @@ struct thread_analyzer_info {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	k_thread_runtime_stats_t  usage;
 #endif
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	/** Wakeup latency statistics */
+	struct k_wakeup_stats wakeup;
+#endif
 #endif
 };
 
@@ -62,6 +62,7 @@ extern "C" {
 #define DISK_STATUS_WR_PROTECT		0x04
 
 struct disk_operations;
+struct disk_cache;
 
 /**
  * @brief Disk info
@@ -75,6 +76,10 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+	/** Sector cache, see disk_access_cache_attach() */
+	struct disk_cache *cache;
+#endif
 };
 
 /**
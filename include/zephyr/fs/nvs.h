@@ -44,6 +44,12 @@ extern "C" {
  * @param nvs_lock Mutex
  * @param flash_device Flash Device runtime structure
  * @param flash_parameters Flash memory parameters structure
+ * @param gc_addr Address of the next allocation table entry to move by the incremental
+ * garbage collection
+ * @param gc_stop_addr Address of the last allocation table entry to move by the incremental
+ * garbage collection
+ * @param gc_state State of the incremental garbage collection
+ * @param gc_dirty Flag indicating if entries were written since the last garbage collection
  */
 struct nvs_fs {
 	off_t offset;
@@ -58,8 +64,39 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_GC_INCREMENTAL
+	uint32_t gc_addr;
+	uint32_t gc_stop_addr;
+	uint8_t gc_state;
+	bool gc_dirty;
+#endif
+};
+
+/**
+ * @brief Non-volatile Storage entry, as found by nvs_foreach()
+ *
+ * @param ate_addr Address of the allocation table entry
+ * @param id Id of the entry
+ * @param len Length of the data, 0 for a deleted entry
+ */
+struct nvs_entry {
+	uint32_t ate_addr;
+	uint16_t id;
+	uint16_t len;
 };
 
+/**
+ * @brief Callback called by nvs_foreach() for each entry
+ *
+ * @param fs Pointer to file system
+ * @param entry Entry found
+ * @param arg Argument given to nvs_foreach()
+ *
+ * @return 0 to continue with the next entry, other values stop nvs_foreach() which returns
+ * them.
+ */
+typedef int (*nvs_foreach_cb_t)(struct nvs_fs *fs, const struct nvs_entry *entry, void *arg);
+
 /**
  * @}
  */
@@ -155,6 +192,40 @@ ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len);
  */
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, uint16_t cnt);
 
+/**
+ * @brief nvs_foreach
+ *
+ * Walk the allocation table once, from the most recent entry to the oldest one, and call a
+ * callback for each valid entry. The first entry found for an id is its most recent one, the
+ * older ones and deleted entries are found as well. Walking all the entries this way is much
+ * faster than reading each id, which walks the allocation table for each read.
+ *
+ * The callback must not write to the file system.
+ *
+ * @param fs Pointer to file system
+ * @param cb Callback called for each entry
+ * @param arg Argument passed to the callback
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ * @return Value returned by the callback to stop the walk.
+ */
+int nvs_foreach(struct nvs_fs *fs, nvs_foreach_cb_t cb, void *arg);
+
+/**
+ * @brief nvs_entry_read
+ *
+ * Read the data of an entry found by nvs_foreach(). If the entry was moved by a garbage
+ * collection since, the most recent entry of its id is read instead.
+ *
+ * @param fs Pointer to file system
+ * @param entry Entry found by nvs_foreach()
+ * @param data Pointer to data buffer
+ * @param len Number of bytes to be read
+ *
+ * @return Number of bytes read, as nvs_read().
+ */
+ssize_t nvs_entry_read(struct nvs_fs *fs, const struct nvs_entry *entry, void *data, size_t len);
+
 /**
  * @brief nvs_calc_free_space
  *
@@ -168,6 +239,26 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_step
+ *
+ * Perform one bounded step of the incremental garbage collection.
+ *
+ * When the free space of the sector being written falls below
+ * @kconfig{CONFIG_NVS_GC_WATERMARK} percent, the sector is closed and the oldest sector is
+ * garbage collected over several calls: each moves at most @kconfig{CONFIG_NVS_GC_STEP_ATES}
+ * entries to the new sector or erases the collected sector. Calling it from a work queue or an
+ * idle hook until it returns 0 keeps space available, so that nvs_write() does not need to
+ * garbage collect itself. A nvs_write() called while entries are being moved first moves the
+ * remaining ones.
+ *
+ * @param fs Pointer to file system
+ * @retval 0 Nothing left to do
+ * @retval 1 More steps are needed
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs);
+
 /**
  * @}
  */
@@ -2771,6 +2771,20 @@ extern struct k_work_q k_sys_work_q;
  * @{
  */
 
+/**
+ * @brief Contention statistics of a mutex or semaphore
+ *
+ * Collected when @kconfig{CONFIG_CONTENTION_STATS} is enabled.
+ */
+struct k_contention_stats {
+	/** Lock or take attempts that found the object unavailable */
+	uint32_t contended;
+	/** Contended attempts satisfied by adaptive spinning */
+	uint32_t spin_acquired;
+	/** Contended attempts that pended the calling thread */
+	uint32_t blocked;
+};
+
 /**
  * Mutex Structure
  * @ingroup mutex_apis
@@ -2787,6 +2801,11 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+#ifdef CONFIG_CONTENTION_STATS
+	/** Contention statistics */
+	struct k_contention_stats contention;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 };
 
@@ -2878,6 +2897,18 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
  */
 __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
+#if defined(CONFIG_CONTENTION_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the contention statistics of a mutex.
+ *
+ * @param mutex Address of the mutex.
+ * @param stats Where to store the statistics.
+ * @param reset If true, clear the statistics of @a mutex after reading them.
+ */
+void k_mutex_contention_get(struct k_mutex *mutex,
+			    struct k_contention_stats *stats, bool reset);
+#endif
+
 /**
  * @}
  */
@@ -2971,6 +3002,10 @@ struct k_sem {
 
 	_POLL_EVENT;
 
+#ifdef CONFIG_CONTENTION_STATS
+	struct k_contention_stats contention;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_sem)
 
 };
@@ -3083,6 +3118,18 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 	return sem->count;
 }
 
+#if defined(CONFIG_CONTENTION_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the contention statistics of a semaphore.
+ *
+ * @param sem Address of the semaphore.
+ * @param stats Where to store the statistics.
+ * @param reset If true, clear the statistics of @a sem after reading them.
+ */
+void k_sem_contention_get(struct k_sem *sem, struct k_contention_stats *stats,
+			  bool reset);
+#endif
+
 /**
  * @brief Statically define and initialize a semaphore.
  *
@@ -4449,6 +4496,65 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends @a num_msgs consecutive messages from @a data to
+ * message queue @a msgq, in order, as if by repeated calls to
+ * k_msgq_put(), but taking the queue's lock and rescheduling woken
+ * receivers only once for all messages that can be sent without
+ * waiting.  If the queue fills up, the routine waits for space for the
+ * remaining messages until @a timeout expires.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages, at most INT_MAX.
+ * @param timeout Non-negative waiting period to add all messages,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, which is less than @a num_msgs if
+ *         the waiting period expired or the queue was purged after
+ *         some messages were sent.
+ * @retval -ENOMSG Returned without waiting, or queue purged, before
+ *         any message was sent.
+ * @retval -EAGAIN Waiting period timed out before any message was sent.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq into consecutive locations of @a data, in "first in, first
+ * out" order, taking the queue's lock and rescheduling woken senders
+ * only once.  It only waits while the queue is empty: as soon as one
+ * message is received, it returns with whatever other messages were
+ * available at that point.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold up to @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive, at most INT_MAX.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4858,6 +4964,70 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/** Buffer segment of a vectored pipe transfer */
+struct k_pipe_iovec {
+	/** Segment start address */
+	void *buf;
+	/** Segment length in bytes */
+	size_t len;
+};
+
+/**
+ * @brief Write data gathered from several buffers to a pipe.
+ *
+ * This routine behaves as k_pipe_put() called with the concatenation of
+ * the @a iovcnt segments of @a iov, but without staging them in a
+ * contiguous buffer, and taking the pipe's lock and rescheduling woken
+ * readers once for all data that can be written without waiting.
+ *
+ * @note Not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of buffer segments to write, in order.
+ * @param iovcnt Number of segments in @a iov.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ */
+int k_pipe_put_vec(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe, scattering it to several buffers.
+ *
+ * This routine behaves as k_pipe_get() called with a buffer made of the
+ * concatenation of the @a iovcnt segments of @a iov, filling them in
+ * order, and taking the pipe's lock and rescheduling woken writers once
+ * for all data that can be read without waiting.
+ *
+ * @note Not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of buffer segments to fill, in order.
+ * @param iovcnt Number of segments in @a iov.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ */
+int k_pipe_get_vec(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -5948,6 +6118,39 @@ extern void k_sys_runtime_stats_enable(void);
  */
 extern void k_sys_runtime_stats_disable(void);
 
+#if defined(CONFIG_SCHED_WAKEUP_LATENCY) || defined(__DOXYGEN__)
+/**
+ * @brief Get the wakeup latency statistics of a thread
+ *
+ * The wakeup latency is the time from the thread being made ready, for
+ * example by the object it was pending on or by the expiry of a sleep,
+ * to it being switched in.  Latencies are in hardware cycles (see
+ * k_cycle_get_32()).
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy statistics into.
+ * @param reset If true, clear the statistics of @a thread after reading them.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_wakeup_stats_get(k_tid_t thread, struct k_wakeup_stats *stats,
+			      bool reset);
+
+/**
+ * @brief Get the run queue depth statistics of a CPU
+ *
+ * The depth of the run queue @a cpu picks threads from is sampled every
+ * time it switches to a thread.  Without CONFIG_SMP the run queue
+ * includes the running thread.  Unless the run queues are per CPU, all
+ * CPUs sample the same queue.
+ *
+ * @param cpu Index of the CPU.
+ * @param stats Pointer to struct to copy statistics into.
+ * @param reset If true, clear the statistics of @a cpu after reading them.
+ * @return -EINVAL if null pointers or invalid CPU, otherwise 0
+ */
+int k_sched_runq_stats_get(int cpu, struct k_runq_stats *stats, bool reset);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
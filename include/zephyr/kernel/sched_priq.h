@@ -9,6 +9,7 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/dlist.h>
 #include <zephyr/sys/rb.h>
+#include <zephyr/types.h>
 
 /* Two abstractions are defined here for "thread priority queues".
  *
@@ -57,4 +58,28 @@ struct _priq_mq {
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
 
+/* Two-level bitmap variant of the multi-queue, with one FIFO list per
+ * priority level for the whole priority range.  The first level has a
+ * bit per 32-level group which is set if any level of the group is
+ * non-empty, so finding the best thread is two count-trailing-zero
+ * operations and adding or removing one is O(1), however many threads
+ * are queued.  The struct is only a few words larger than an array of
+ * list heads, and an all-zero struct is a valid empty queue (lists are
+ * initialized when they become non-empty), so it can back wait queues
+ * as well as the run queue.  Like the multi-queue, it cannot be used
+ * with deadline scheduling.
+ */
+#define Z_PRIQ_BM_LEVELS (CONFIG_NUM_COOP_PRIORITIES + \
+			  CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define Z_PRIQ_BM_GROUPS DIV_ROUND_UP(Z_PRIQ_BM_LEVELS, 32)
+
+struct _priq_bm {
+	uint32_t groups; /* bit 1<<g set if bitmap[g] is non-zero */
+	uint32_t bitmap[Z_PRIQ_BM_GROUPS]; /* bit set if queue is non-empty */
+	sys_dlist_t queues[Z_PRIQ_BM_LEVELS];
+};
+
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq);
+struct k_thread *z_priq_bm_next(struct _priq_bm *pq, struct k_thread *thread);
+
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
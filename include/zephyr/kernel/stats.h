@@ -25,4 +25,32 @@ struct k_cycle_stats {
 	bool      track_usage;  /* true if gathering usage stats */
 };
 
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+/*
+ * [k_wakeup_stats] tracks the time a thread spends between being made
+ * ready and being switched in.  Bucket 0 of the histogram counts
+ * latencies below 1 us, bucket n latencies in [2^(n-1), 2^n) us; the
+ * last bucket also counts everything longer.
+ */
+
+struct k_wakeup_stats {
+	uint32_t  count;        /* # of wakeups measured */
+	uint32_t  longest;      /* longest latency in cycles */
+	uint64_t  total;        /* sum of all latencies in cycles */
+	uint32_t  hist[CONFIG_SCHED_WAKEUP_LATENCY_BUCKETS];
+};
+
+/*
+ * [k_runq_stats] tracks the depth of the run queue a CPU schedules
+ * from, sampled every time the CPU switches to a thread.
+ */
+
+struct k_runq_stats {
+	uint32_t  depth;        /* depth when the stats were read */
+	uint32_t  peak;         /* deepest sample */
+	uint32_t  num_samples;  /* # of samples */
+	uint64_t  total;        /* sum of all samples */
+};
+#endif
+
 #endif
@@ -140,6 +140,11 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	uint32_t ready_stamp;          /* Made ready at, 0 once switched in */
+	struct k_wakeup_stats wakeup;  /* Track wakeup latency statistics */
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
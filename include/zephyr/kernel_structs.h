@@ -92,6 +92,13 @@ struct _ready_q {
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
+#elif defined(CONFIG_SCHED_BITMAP)
+	struct _priq_bm runq;
+#endif
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	/* number of threads in runq */
+	uint32_t depth;
 #endif
 };
 
@@ -142,6 +149,10 @@ struct _cpu {
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	struct k_cycle_stats usage;
 #endif
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	struct k_runq_stats runq_stats;
+#endif
 #endif
 
 	/* Per CPU architecture specifics */
@@ -221,6 +232,14 @@ extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 #define Z_WAIT_Q_INIT(wait_q) { { { .lessthan_fn = z_priq_rb_lessthan } } }
 
+#elif defined(CONFIG_WAITQ_BITMAP)
+
+typedef struct {
+	struct _priq_bm waitq;
+} _wait_q_t;
+
+#define Z_WAIT_Q_INIT(wait_q) { { 0 } }
+
 #else
 
 typedef struct {
@@ -237,10 +256,20 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbnode node;
+	/* FIFO tie-breaker for timeouts expiring on the same tick */
+	uint32_t order_key;
+	bool linked;
+#else
 	sys_dnode_t node;
+#endif
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  With
+	 * CONFIG_TIMEOUT_QUEUE_SCALABLE this is the absolute expiry
+	 * tick rather than a delta from the previous timeout.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
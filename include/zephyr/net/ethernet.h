@@ -173,6 +173,9 @@ enum ethernet_hw_caps {
 
 	/** TXTIME supported */
 	ETHERNET_TXTIME			= BIT(19),
+
+	/** TCP segmentation offload supported for large TCP packets */
+	ETHERNET_HW_TX_TCP_SEG		= BIT(20),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -282,6 +282,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** epoll registrations of the socket */
+	sys_slist_t epoll_watchers;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -322,6 +327,10 @@ __net_socket struct net_context {
 #endif
 #if defined(CONFIG_NET_CONTEXT_DSCP_ECN)
 		uint8_t dscp_ecn;
+#endif
+#if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
+		/** Return the destination address of received packets */
+		bool recv_pktinfo;
 #endif
 	} options;
 
@@ -1073,6 +1082,7 @@ enum net_context_option {
 	NET_OPT_RCVBUF		= 6,
 	NET_OPT_SNDBUF		= 7,
 	NET_OPT_DSCP_ECN	= 8,
+	NET_OPT_RECV_PKTINFO	= 9,
 };
 
 /**
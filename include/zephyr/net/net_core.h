@@ -149,6 +149,15 @@ int net_send_data(struct net_pkt *pkt);
 #define NET_TC_COUNT 0
 #endif /* CONFIG_NET_TC_TX_COUNT && CONFIG_NET_TC_RX_COUNT */
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+#define NET_RX_FLOW_QUEUES CONFIG_NET_RX_FLOW_QUEUES
+#else
+#define NET_RX_FLOW_QUEUES 1
+#endif
+
+/* Total number of RX queues, each traffic class has its flow queues */
+#define NET_RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_RX_FLOW_QUEUES)
+
 /* @endcond */
 
 /**
@@ -292,6 +292,19 @@ struct cmsghdr {
 #define CMSG_LEN(length) (ALIGN_D(sizeof(struct cmsghdr)) + length)
 #endif
 
+/** Ancillary data of a received IPv4 packet, see IP_PKTINFO */
+struct in_pktinfo {
+	unsigned int   ipi_ifindex;  /* Interface the packet arrived on */
+	struct in_addr ipi_spec_dst; /* Local address of the packet */
+	struct in_addr ipi_addr;     /* Destination address in the header */
+};
+
+/** Ancillary data of a received IPv6 packet, see IPV6_RECVPKTINFO */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /* Destination address in the header */
+	unsigned int    ipi6_ifindex; /* Interface the packet arrived on */
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 /* Packet types.  */
@@ -266,6 +266,13 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Payload length of the segments a large TCP packet is cut into
+	 * before it is sent, 0 if the packet is sent as is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 	/* TODO: Evolve this into a union of orthogonal
 	 *       control block declarations if further L2
@@ -943,6 +950,31 @@ static inline void net_pkt_set_vlan_tci(struct net_pkt *pkt, uint16_t tci)
 }
 #endif
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 static inline struct net_ptp_time *net_pkt_timestamp(struct net_pkt *pkt)
 {
@@ -1973,6 +2005,15 @@ struct net_pkt *net_pkt_rx_clone(struct net_pkt *pkt, k_timeout_t timeout);
 struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt,
 				      k_timeout_t timeout);
 
+/**
+ * @brief Copy the attributes of pkt, but not its data, to another packet.
+ *
+ * @param pkt Original pkt
+ * @param clone_pkt Packet receiving the attributes, its link layer
+ *        addresses are only copied if it already has a buffer.
+ */
+void net_pkt_copy_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt);
+
 /**
  * @brief Read some data from a net_pkt
  *
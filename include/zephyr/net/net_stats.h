@@ -163,6 +163,16 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of times the congestion window was reduced after duplicate
+	 * ACKs, entering fast recovery.
+	 */
+	net_stats_t fast_recovery;
+
+	/** Number of retransmission timeouts, each of which collapses the
+	 * congestion window to one segment.
+	 */
+	net_stats_t rto;
 };
 
 /**
@@ -274,6 +284,17 @@ struct net_stats_tc {
 	} recv[NET_TC_RX_STATS_COUNT];
 };
 
+/**
+ * @brief RX flow queue statistics
+ */
+struct net_stats_rx_queue {
+	/** Number of packets steered to the queue */
+	net_stats_t pkts;
+
+	/** Number of bytes steered to the queue */
+	net_stats_t bytes;
+};
+
 
 /**
  * @brief Power management statistics
@@ -347,6 +368,11 @@ struct net_stats {
 	struct net_stats_tc tc;
 #endif
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	/** RX flow queue statistics */
+	struct net_stats_rx_queue rx_queue[NET_RX_QUEUE_COUNT];
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
@@ -39,6 +39,12 @@ struct zsock_pollfd {
 	short revents;
 };
 
+/** Message sent or received by zsock_sendmmsg() and zsock_recvmmsg() */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr; /* Message */
+	unsigned int msg_len;  /* Number of bytes transferred */
+};
+
 /* ZSOCK_POLL* values are compatible with Linux */
 /** zsock_poll: Poll for readability */
 #define ZSOCK_POLLIN 1
@@ -63,6 +69,12 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmsg: ancillary data was discarded for lack of space (output
+ *  value only)
+ */
+#define ZSOCK_MSG_CTRUNC 0x08
+/** zsock_recvmmsg: only block until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -419,6 +431,63 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Receive a message from an arbitrary network address
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description.
+ * This function is also exposed as ``recvmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * The ancillary data returned for a datagram is the destination address
+ * of the packet, if enabled with the ``IP_PKTINFO`` or ``IPV6_RECVPKTINFO``
+ * socket options.
+ * @endrst
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Send several messages with one call
+ *
+ * @details
+ * @rst
+ * Send the messages of ``msgvec`` in turn, like ``zsock_sendmsg()`` would,
+ * and store the number of bytes sent for each in its ``msg_len``.
+ * At most :kconfig:option:`CONFIG_NET_SOCKETS_MMSG_VLEN_MAX` messages are
+ * sent per call.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set if none could be.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several messages with one call
+ *
+ * @details
+ * @rst
+ * Receive messages into ``msgvec`` in turn, like ``zsock_recvmsg()``
+ * would, and store the number of bytes received for each in its
+ * ``msg_len``. With ``ZSOCK_MSG_WAITFORONE`` only the first message is
+ * waited for, and the call returns once no more are queued. Unlike
+ * Linux there is no timeout argument, use ``SO_RCVTIMEO`` instead.
+ * At most :kconfig:option:`CONFIG_NET_SOCKETS_MMSG_VLEN_MAX` messages are
+ * received per call.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 with errno set if none
+ *         could be.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -437,6 +506,63 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Data received with zsock_recv_zerocopy()
+ */
+struct zsock_recv_zc {
+	/** Array provided by the caller, filled in with the fragments of
+	 *  the received data
+	 */
+	struct iovec *iov;
+	/** Number of entries in @a iov, set by the caller and updated to
+	 *  the number of fragments filled in
+	 */
+	size_t iovlen;
+
+	/** @cond INTERNAL_HIDDEN */
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	size_t len;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Instead of copying the received data to a buffer of the caller, point
+ * the entries of @a zc->iov at the network buffers holding it. Data of
+ * at most one received packet is returned per call: if a TCP segment
+ * has more fragments than @a zc->iovlen, the rest is returned by the
+ * next call, while the rest of a datagram is discarded.
+ *
+ * The buffers stay valid until they are given back with
+ * zsock_recv_zerocopy_release(), which must follow every successful call,
+ * even if the socket is closed in the meantime. For a TCP socket the
+ * receive window is only opened again when the buffers are given back.
+ *
+ * This function is only available to supervisor threads, and not for TLS
+ * or offloaded sockets. It needs
+ * :kconfig:option:`CONFIG_NET_SOCKETS_RECV_ZEROCOPY`.
+ *
+ * @param sock Socket to receive from
+ * @param zc Description of the received data
+ * @param flags ZSOCK_MSG_DONTWAIT, and ZSOCK_MSG_TRUNC to return the
+ *        length of a whole datagram
+ *
+ * @return Number of bytes the fragments add up to, 0 at the end of a
+ *         stream, or -1 with errno set on error.
+ */
+ssize_t zsock_recv_zerocopy(int sock, struct zsock_recv_zc *zc, int flags);
+
+/**
+ * @brief Give back the buffers of zsock_recv_zerocopy()
+ *
+ * @param zc Description of the received data, filled in by
+ *        zsock_recv_zerocopy()
+ */
+void zsock_recv_zerocopy_release(struct zsock_recv_zc *zc);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -683,6 +809,7 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 #if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
 
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
 
 /** POSIX wrapper for @ref zsock_socket */
 static inline int socket(int family, int type, int proto)
@@ -784,6 +911,26 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+/** POSIX wrapper for @ref zsock_recvmsg */
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+/** Linux compatible wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+/** Linux compatible wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -887,6 +1034,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_CTRUNC */
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
+/** Linux compatible wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -988,15 +1139,28 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Name of the congestion control algorithm, e.g. "newreno" */
+#define TCP_CONGESTION 13
 
 /* Socket options for IPPROTO_IP level */
 /** sockopt: Set or receive the Type-Of-Service value for an outgoing packet. */
 #define IP_TOS 1
+/** sockopt: Return the destination address of received packets as
+ *  ancillary data of zsock_recvmsg()
+ */
+#define IP_PKTINFO 8
 
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
 
+/** sockopt: Return the destination address of received packets as
+ *  ancillary data of zsock_recvmsg()
+ */
+#define IPV6_RECVPKTINFO 49
+/** Type of the ancillary data returned with IPV6_RECVPKTINFO */
+#define IPV6_PKTINFO 50
+
 /** sockopt: Set or receive the traffic class value for an outgoing packet. */
 #define IPV6_TCLASS 67
 
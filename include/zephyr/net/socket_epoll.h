@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ZSOCK_EPOLL* values are compatible with Linux */
+/** zsock_epoll_ctl: Descriptor is readable */
+#define ZSOCK_EPOLLIN ZSOCK_POLLIN
+/** zsock_epoll_ctl: Descriptor is writable */
+#define ZSOCK_EPOLLOUT ZSOCK_POLLOUT
+/** zsock_epoll_wait: Error condition, always reported */
+#define ZSOCK_EPOLLERR ZSOCK_POLLERR
+/** zsock_epoll_wait: Closed connection, always reported */
+#define ZSOCK_EPOLLHUP ZSOCK_POLLHUP
+/** zsock_epoll_ctl: Disable the descriptor once an event was reported */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+
+/** zsock_epoll_ctl: Register a descriptor */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Remove a registered descriptor */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a registered descriptor */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** User data returned along with the events of a descriptor */
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zsock_epoll_data_t;
+
+/** Events of a descriptor, as registered or as reported */
+struct zsock_epoll_event {
+	uint32_t events;         /* ZSOCK_EPOLL* mask */
+	zsock_epoll_data_t data; /* User data */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * An epoll instance keeps a persistent set of descriptors, registered with
+ * :c:func:`zsock_epoll_ctl()`, and :c:func:`zsock_epoll_wait()` only
+ * returns those which are ready. Unlike :c:func:`zsock_poll()`, the set is
+ * not passed, copied and validated again on every call. Net sockets,
+ * socketpairs and eventfds can be registered. See `Linux manual page
+ * <https://man7.org/linux/man-pages/man7/epoll.7.html>`__ for a normative
+ * description; only level triggered mode is supported.
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param flags Must be 0
+ *
+ * @return New descriptor on success, -1 with errno set on error
+ */
+__syscall int zsock_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a descriptor of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for normative description. A closed descriptor is dropped from the
+ * instance, as if it had been removed.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for registered descriptors to become ready
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for normative description. When more than @p maxevents descriptors are
+ * ready, the following call carries on where this one stopped.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+/** @cond INTERNAL_HIDDEN */
+
+/**
+ * @brief How an object can be registered with an epoll instance
+ *
+ * Filled in by the ZFD_IOCTL_EPOLL_WATCH ioctl of the objects which support
+ * it. The object keeps the list of its registrations and calls
+ * zsock_epoll_notify() on it whenever it may have become ready, and
+ * zsock_epoll_detach() when it is closed.
+ */
+struct zsock_epoll_watch {
+	/** Registrations of the object */
+	sys_slist_t *watchers;
+	/** ZSOCK_POLL* events the object does not notify, polled instead */
+	uint32_t polled;
+	/** Type a user thread must have been granted, K_OBJ_ANY if none */
+	enum k_objects otype;
+};
+
+/**
+ * @brief Queue the registrations of an object to their epoll instances
+ *
+ * May be called from any context, including ISRs.
+ *
+ * @param watchers Registrations of the object.
+ */
+void zsock_epoll_notify(sys_slist_t *watchers);
+
+/**
+ * @brief Drop the registrations of an object being closed
+ *
+ * @param watchers Registrations of the object.
+ */
+void zsock_epoll_detach(sys_slist_t *watchers);
+
+/** @endcond */
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define epoll_event zsock_epoll_event
+#define epoll_data_t zsock_epoll_data_t
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+/** Linux compatible wrapper for @ref zsock_epoll_create */
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create(flags);
+}
+
+/** Linux compatible wrapper for @ref zsock_epoll_ctl */
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+/** Linux compatible wrapper for @ref zsock_epoll_wait */
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -42,6 +42,8 @@ struct zperf_upload_params {
 
 struct zperf_download_params {
 	uint16_t port;
+	/* Receive with zsock_recv_zerocopy() instead of copying (TCP only) */
+	bool zerocopy;
 };
 
 struct zperf_results {
@@ -55,6 +57,8 @@ struct zperf_results {
 	uint32_t client_time_in_us;
 	uint32_t packet_size;
 	uint32_t nb_packets_errors;
+	/* CPU load during the session in permille, 0 if not measured */
+	uint32_t cpu_load;
 };
 
 /**
@@ -141,6 +145,10 @@ int zperf_udp_download(const struct zperf_download_params *param,
  *
  * @note Only one TCP server instance can run at a time.
  *
+ * @note Receiving with zero-copy needs CONFIG_NET_SOCKETS_RECV_ZEROCOPY and
+ *       is not available with CONFIG_USERSPACE. The CPU load of a session is
+ *       only measured with CONFIG_SCHED_THREAD_USAGE_ALL.
+ *
  * @param param Download parameters.
  * @param callback Session results callback.
  * @param user_data A pointer to the user data to be provided with the callback.
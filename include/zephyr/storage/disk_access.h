@@ -100,6 +100,126 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+/** Keep written sectors in the cache until it is flushed */
+#define DISK_CACHE_WRITE_BACK BIT(0)
+
+/**
+ * @brief Disk sector cache entry
+ *
+ * Internal to the disk access layer.
+ */
+struct disk_cache_entry {
+	/** Node in the least recently used list */
+	sys_dnode_t node;
+	/** Cached sector */
+	uint32_t sector;
+	/** The entry holds the data of @a sector */
+	bool valid;
+	/** The data is newer than on the disk */
+	bool dirty;
+};
+
+/**
+ * @brief Disk sector cache statistics
+ */
+struct disk_cache_stats {
+	/** Sectors read from the cache */
+	uint32_t hits;
+	/** Sectors read from the disk into the cache */
+	uint32_t misses;
+	/** Dirty sectors written back to the disk */
+	uint32_t write_backs;
+};
+
+/**
+ * @brief Disk sector cache
+ *
+ * Defined with DISK_CACHE_DEFINE(), the members are internal to the disk
+ * access layer.
+ */
+struct disk_cache {
+	/** Entries, the first one the most recently used */
+	sys_dlist_t lru;
+	/** Entry array */
+	struct disk_cache_entry *entries;
+	/** Sector data of the entries */
+	uint8_t *data;
+	/** Number of entries */
+	uint32_t count;
+	/** Sector size in bytes */
+	uint32_t sector_size;
+	/** DISK_CACHE_* flags */
+	uint32_t flags;
+	/** Statistics */
+	struct disk_cache_stats stats;
+	/** Lock protecting the cache */
+	struct k_mutex lock;
+};
+
+/**
+ * @brief Statically define a disk sector cache.
+ *
+ * @param _name Name of the cache.
+ * @param _sectors Number of sectors cached.
+ * @param _sector_size Sector size in bytes of the disk the cache is for.
+ */
+#define DISK_CACHE_DEFINE(_name, _sectors, _sector_size)			\
+	static struct disk_cache_entry _name##_entries[_sectors];		\
+	static uint8_t _name##_data[_sectors][_sector_size] __aligned(4);	\
+	static struct disk_cache _name = {					\
+		.entries = _name##_entries,					\
+		.data = &_name##_data[0][0],					\
+		.count = _sectors,						\
+		.sector_size = _sector_size,					\
+	}
+
+/**
+ * @brief Cache the sectors of a disk
+ *
+ * Single sector reads and writes, as of file system metadata, go through
+ * a least recently used cache of sectors. Transfers of several sectors,
+ * as of file data, go straight to the disk, so that they do not evict
+ * the metadata, but see the sectors written to the cache and not flushed
+ * yet.
+ *
+ * With DISK_CACHE_WRITE_BACK, written sectors only reach the disk when
+ * evicted from the cache, or when the cache is flushed by
+ * disk_access_cache_flush() or a DISK_IOCTL_CTRL_SYNC request. Otherwise
+ * they are written to the disk at once.
+ *
+ * @param[in] pdrv          Disk name
+ * @param[in] cache         Cache defined with DISK_CACHE_DEFINE(), not used
+ *                          by another disk, or NULL to flush and remove the
+ *                          cache of the disk
+ * @param[in] flags         DISK_CACHE_* flags
+ *
+ * @return 0 on success, -EINVAL if the disk does not exist or its sectors
+ * are not of the size of the cache ones, negative errno code of flushing
+ * the former cache on fail
+ */
+int disk_access_cache_attach(const char *pdrv, struct disk_cache *cache,
+			     uint32_t flags);
+
+/**
+ * @brief Write the dirty sectors of the disk cache to the disk
+ *
+ * @param[in] pdrv          Disk name
+ *
+ * @return 0 on success, -EINVAL if the disk has no cache, negative errno
+ * code on fail
+ */
+int disk_access_cache_flush(const char *pdrv);
+
+/**
+ * @brief Get the statistics of the disk cache
+ *
+ * @param[in] pdrv          Disk name
+ * @param[out] stats        Statistics since the cache was attached
+ *
+ * @return 0 on success, -EINVAL if the disk has no cache
+ */
+int disk_access_cache_stats(const char *pdrv, struct disk_cache_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
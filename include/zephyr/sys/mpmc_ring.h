@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPMC_RING_H_
+#define ZEPHYR_INCLUDE_SYS_MPMC_RING_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Multi producer, multi consumer lock-free ring API
+ * @defgroup mpmc_ring_apis MPMC ring APIs
+ * @ingroup datastructure_apis
+ *
+ * A bounded queue of fixed size messages which any number of threads
+ * and ISRs can put to and get from concurrently without taking a lock.
+ *
+ * Each slot carries a sequence number telling whether it is ready to
+ * be written or read for a given lap around the ring, so producers and
+ * consumers only contend on a single compare-and-swap of the head or
+ * tail index and never on each other's slots.  The operations never
+ * block: a producer that finds the ring full, or a consumer that finds
+ * it empty, fails immediately.  A message whose producer has claimed a
+ * slot but was preempted before filling it holds up consumers of that
+ * slot until the producer resumes, and they see the ring as empty in
+ * the meantime.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Slot: sequence number followed by the message, in atomic_t units so
+ * every slot's sequence number stays naturally aligned.
+ */
+#define Z_MPMC_RING_SLOT_WORDS(msg_size) \
+	(1 + DIV_ROUND_UP(msg_size, sizeof(atomic_t)))
+
+/** @endcond */
+
+/**
+ * @brief Size, in atomic_t units, of the storage for a ring.
+ *
+ * @param msg_size Size of a message in bytes.
+ * @param num_msgs Number of slots, must be a power of two.
+ */
+#define MPMC_RING_BUF_WORDS(msg_size, num_msgs) \
+	(Z_MPMC_RING_SLOT_WORDS(msg_size) * (num_msgs))
+
+/**
+ * @brief MPMC ring
+ *
+ * Opaque; initialize with MPMC_RING_DEFINE() or mpmc_ring_init().
+ */
+struct mpmc_ring {
+	/** Next position to write, shared by producers */
+	atomic_t head;
+	/** Next position to read, shared by consumers */
+	atomic_t tail;
+	atomic_t *buf;
+	size_t msg_size;
+	size_t slot_words;
+	uint32_t mask;
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+#define Z_MPMC_RING_INITIALIZER(buf_, msg_size_, num_msgs_) \
+	{ \
+		.head = ATOMIC_INIT(0), \
+		.tail = ATOMIC_INIT(0), \
+		.buf = buf_, \
+		.msg_size = msg_size_, \
+		.slot_words = Z_MPMC_RING_SLOT_WORDS(msg_size_), \
+		.mask = (num_msgs_) - 1, \
+	}
+
+/** @endcond */
+
+/**
+ * @brief Statically define and initialize an MPMC ring.
+ *
+ * @param name Name of the ring.
+ * @param msg_size Size of a message in bytes.
+ * @param num_msgs Number of messages the ring can hold, must be a power
+ * of two.
+ */
+#define MPMC_RING_DEFINE(name, msg_size, num_msgs) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(num_msgs), \
+		     "MPMC ring size must be a power of two"); \
+	static atomic_t _mpmc_ring_buf_##name[MPMC_RING_BUF_WORDS(msg_size, num_msgs)]; \
+	struct mpmc_ring name = \
+		Z_MPMC_RING_INITIALIZER(_mpmc_ring_buf_##name, msg_size, num_msgs)
+
+/**
+ * @brief Initialize an MPMC ring.
+ *
+ * @param ring Ring to initialize.
+ * @param buf Zeroed or otherwise unused storage of at least
+ * MPMC_RING_BUF_WORDS(@a msg_size, @a num_msgs) words.
+ * @param msg_size Size of a message in bytes.
+ * @param num_msgs Number of messages the ring can hold, must be a power
+ * of two.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @a num_msgs is not a power of two or @a msg_size is 0.
+ */
+int mpmc_ring_init(struct mpmc_ring *ring, atomic_t *buf, size_t msg_size,
+		   uint32_t num_msgs);
+
+/**
+ * @brief Copy a message into the ring.
+ *
+ * Lock-free, and may be called from ISRs.
+ *
+ * @param ring Ring.
+ * @param data Message of the ring's message size.
+ *
+ * @retval 0 on success.
+ * @retval -ENOSPC if the ring is full.
+ */
+int mpmc_ring_put(struct mpmc_ring *ring, const void *data);
+
+/**
+ * @brief Copy the oldest message out of the ring.
+ *
+ * Lock-free, and may be called from ISRs.
+ *
+ * @param ring Ring.
+ * @param data Buffer of the ring's message size.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if the ring is empty.
+ */
+int mpmc_ring_get(struct mpmc_ring *ring, void *data);
+
+/**
+ * @brief Number of messages in the ring.
+ *
+ * Only a snapshot when other contexts are using the ring; messages
+ * being written or read at that time may or may not be included.
+ *
+ * @param ring Ring.
+ *
+ * @return Number of messages.
+ */
+static inline uint32_t mpmc_ring_num_used_get(struct mpmc_ring *ring)
+{
+	unsigned long tail = (unsigned long)atomic_get(&ring->tail);
+	unsigned long head = (unsigned long)atomic_get(&ring->head);
+
+	return MIN((uint32_t)(head - tail), ring->mask + 1);
+}
+
+#if defined(CONFIG_MULTITHREADING) || defined(__DOXYGEN__)
+
+/**
+ * @brief Message queue on top of an MPMC ring
+ *
+ * Drop-in alternative to @ref k_msgq for queues that are mostly
+ * neither full nor empty: messages go through the lock-free ring and
+ * the scheduler is only involved when a thread actually has to sleep,
+ * or has to be woken up because one is sleeping.  Unlike k_msgq,
+ * messages are not handed directly to a waiting thread, and neither
+ * peeking, purging nor user mode access is supported.
+ */
+struct mpmc_msgq {
+	struct mpmc_ring ring;
+	/** Number of threads sleeping until a message is available */
+	atomic_t get_waiters;
+	/** Number of threads sleeping until space is available */
+	atomic_t put_waiters;
+	struct k_sem data_sem;
+	struct k_sem space_sem;
+};
+
+/**
+ * @brief Statically define and initialize an MPMC message queue.
+ *
+ * @param name Name of the message queue.
+ * @param msg_size Size of a message in bytes.
+ * @param num_msgs Maximum number of messages, must be a power of two.
+ */
+#define MPMC_MSGQ_DEFINE(name, msg_size, num_msgs) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(num_msgs), \
+		     "MPMC message queue size must be a power of two"); \
+	static atomic_t _mpmc_msgq_buf_##name[MPMC_RING_BUF_WORDS(msg_size, num_msgs)]; \
+	struct mpmc_msgq name = { \
+		.ring = Z_MPMC_RING_INITIALIZER(_mpmc_msgq_buf_##name, \
+						msg_size, num_msgs), \
+		.get_waiters = ATOMIC_INIT(0), \
+		.put_waiters = ATOMIC_INIT(0), \
+		.data_sem = Z_SEM_INITIALIZER(name.data_sem, 0, K_SEM_MAX_LIMIT), \
+		.space_sem = Z_SEM_INITIALIZER(name.space_sem, 0, K_SEM_MAX_LIMIT), \
+	}
+
+/**
+ * @brief Initialize an MPMC message queue.
+ *
+ * @param msgq Message queue.
+ * @param buf Zeroed or otherwise unused storage of at least
+ * MPMC_RING_BUF_WORDS(@a msg_size, @a num_msgs) words.
+ * @param msg_size Size of a message in bytes.
+ * @param num_msgs Maximum number of messages, must be a power of two.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @a num_msgs is not a power of two or @a msg_size is 0.
+ */
+int mpmc_msgq_init(struct mpmc_msgq *msgq, atomic_t *buf, size_t msg_size,
+		   uint32_t num_msgs);
+
+/**
+ * @brief Send a message, as k_msgq_put().
+ *
+ * @note Can be called by ISRs, with @a timeout set to K_NO_WAIT.
+ *
+ * @param msgq Message queue.
+ * @param data Message to send.
+ * @param timeout How long to wait for space in the queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -ENOMSG Returned without waiting, queue full.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int mpmc_msgq_put(struct mpmc_msgq *msgq, const void *data, k_timeout_t timeout);
+
+/**
+ * @brief Receive a message, as k_msgq_get().
+ *
+ * @note Can be called by ISRs, with @a timeout set to K_NO_WAIT.
+ *
+ * @param msgq Message queue.
+ * @param data Buffer for the received message.
+ * @param timeout How long to wait for a message.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Returned without waiting, queue empty.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int mpmc_msgq_get(struct mpmc_msgq *msgq, void *data, k_timeout_t timeout);
+
+/**
+ * @brief Number of messages in the queue, as k_msgq_num_used_get().
+ *
+ * @param msgq Message queue.
+ *
+ * @return Number of messages.
+ */
+static inline uint32_t mpmc_msgq_num_used_get(struct mpmc_msgq *msgq)
+{
+	return mpmc_ring_num_used_get(&msgq->ring);
+}
+
+#endif /* CONFIG_MULTITHREADING */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPMC_RING_H_ */
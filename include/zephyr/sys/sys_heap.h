@@ -91,6 +91,50 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
 #endif
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+/**
+ * @brief Small allocation cache statistics
+ *
+ * Blocks held in the cache are reported as free bytes by
+ * sys_heap_runtime_stats_get(), since they are available to satisfy
+ * allocations.
+ */
+struct sys_heap_cache_stats {
+	/** Allocations served directly from the cache */
+	uint32_t hits;
+	/** Cacheable allocations that found their size class empty */
+	uint32_t misses;
+	/** Times the cache was drained back into the heap */
+	uint32_t flushes;
+	/** Bytes currently held in the cache */
+	size_t cached_bytes;
+};
+
+/**
+ * @brief Get the small allocation cache statistics of a sys_heap
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache_stats *stats);
+
+/**
+ * @brief Set the small allocation cache depth of a sys_heap
+ *
+ * Sets the maximum number of freed blocks kept per size class.  A
+ * depth of zero disables the cache for this heap.  Lowering the depth
+ * returns all currently cached blocks to the heap.
+ *
+ * @param heap Pointer to sys_heap
+ * @param depth Maximum number of cached blocks per size class
+ */
+void sys_heap_cache_depth_set(struct sys_heap *heap, uint16_t depth);
+
+#endif
+
 /** @brief Initialize sys_heap
  *
  * Initializes a sys_heap struct to manage the specified memory.
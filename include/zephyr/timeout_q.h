@@ -24,7 +24,11 @@ extern "C" {
 
 static inline void z_init_timeout(struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	to->linked = false;
+#else
 	sys_dnode_init(&to->node);
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -34,7 +38,11 @@ int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	return !to->linked;
+#else
 	return !sys_dnode_is_linked(&to->node);
+#endif
 }
 
 static inline void z_init_thread_timeout(struct _thread_base *thread_base)
@@ -1419,6 +1419,50 @@
  */
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
 
+/**
+ * @brief Trace Message Queue batched put attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue batched put attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue batched put attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+
+/**
+ * @brief Trace Message Queue batched get attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue batched get attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue batched get attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
+
 /**
  * @brief Trace Message Queue peek
  * @param msgq Message Queue object
@@ -1633,6 +1677,50 @@
  */
 #define sys_port_trace_k_pipe_get_exit(pipe, timeout, ret)
 
+/**
+ * @brief Trace Pipe vectored put attempt entry
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_put_vec_enter(pipe, timeout)
+
+/**
+ * @brief Trace Pipe vectored put attempt blocking
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_put_vec_blocking(pipe, timeout)
+
+/**
+ * @brief Trace Pipe vectored put attempt outcome
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_put_vec_exit(pipe, timeout, ret)
+
+/**
+ * @brief Trace Pipe vectored get attempt entry
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_get_vec_enter(pipe, timeout)
+
+/**
+ * @brief Trace Pipe vectored get attempt blocking
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_get_vec_blocking(pipe, timeout)
+
+/**
+ * @brief Trace Pipe vectored get attempt outcome
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_get_vec_exit(pipe, timeout, ret)
+
 /**
  * @brief Trace Pipe block put enter
  * @param pipe Pipe object
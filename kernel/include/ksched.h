@@ -93,6 +93,42 @@ static inline bool z_is_idle_thread_object(struct k_thread *thread)
 #endif /* CONFIG_MULTITHREADING */
 }
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+/* True if @a thread is the current thread of another CPU */
+bool z_thread_running_elsewhere(struct k_thread *thread);
+
+/* True if any other CPU is running something else than its idle thread */
+bool z_other_cpus_busy(void);
+
+/* What is left of @a timeout after spinning for @a cycles, so that the
+ * spin counts towards it.  A timeout left at zero still pends, and fails
+ * with -EAGAIN at the next tick.
+ */
+static inline k_timeout_t z_spin_timeout_left(k_timeout_t timeout,
+					      uint32_t cycles)
+{
+	k_ticks_t spun = k_cyc_to_ticks_floor32(cycles);
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return timeout;
+	}
+
+#ifdef CONFIG_TIMEOUT_64BIT
+	if (Z_TICK_ABS(timeout.ticks) >= 0) {
+		return timeout;
+	}
+#endif
+
+	return Z_TIMEOUT_TICKS(MAX(timeout.ticks - spun, 0));
+}
+#endif
+
+#ifdef CONFIG_CONTENTION_STATS
+#define Z_CONTENTION_INC(obj, field) ((obj)->contention.field++)
+#else
+#define Z_CONTENTION_INC(obj, field) do { } while (false)
+#endif
+
 static inline bool z_is_thread_suspended(struct k_thread *thread)
 {
 	return (thread->base.thread_state & _THREAD_SUSPENDED) != 0U;
@@ -428,6 +464,32 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+/* Mark the time @a thread was made ready, for its wakeup latency */
+static inline void z_sched_ready_stamp(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	uint32_t now = k_cycle_get_32();
+
+	/* Zero means "nothing to measure" */
+	thread->base.ready_stamp = (now == 0U) ? 1U : now;
+#else
+	ARG_UNUSED(thread);
+#endif
+}
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+/* Depth of the run queue @a cpu schedules from */
+static inline uint32_t z_sched_runq_depth(struct _cpu *cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+	return cpu->ready_q.depth;
+#else
+	ARG_UNUSED(cpu);
+	return _kernel.ready_q.depth;
+#endif
+}
+#endif
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
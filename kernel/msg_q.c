@@ -285,6 +285,279 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+/* Copy @a num_msgs messages from @a data into the buffer, which must have
+ * room for them, in at most two chunks.
+ */
+static void msgq_buffer_write(struct k_msgq *msgq, const char *data,
+			      uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->write_ptr;
+	size_t first = MIN(len, to_end);
+
+	(void)memcpy(msgq->write_ptr, data, first);
+	(void)memcpy(msgq->buffer_start, data + first, len - first);
+
+	msgq->write_ptr += len;
+	if (msgq->write_ptr >= msgq->buffer_end) {
+		msgq->write_ptr -= msgq->buffer_end - msgq->buffer_start;
+	}
+	msgq->used_msgs += num_msgs;
+}
+
+/* Counterpart of msgq_buffer_write() for the oldest messages */
+static void msgq_buffer_read(struct k_msgq *msgq, char *data,
+			     uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->read_ptr;
+	size_t first = MIN(len, to_end);
+
+	(void)memcpy(data, msgq->read_ptr, first);
+	(void)memcpy(data + first, msgq->buffer_start, len - first);
+
+	msgq->read_ptr += len;
+	if (msgq->read_ptr >= msgq->buffer_end) {
+		msgq->read_ptr -= msgq->buffer_end - msgq->buffer_start;
+	}
+	msgq->used_msgs -= num_msgs;
+}
+
+/*
+ * Move as many of @a num_msgs messages as possible without waiting: first
+ * straight to threads waiting to receive, then into the buffer.  Threads
+ * that are readied are only rescheduled by the caller, once per batch.
+ *
+ * Returns the number of messages moved.
+ */
+static uint32_t msgq_put_locked(struct k_msgq *msgq, const char *data,
+				uint32_t num_msgs, bool *reschedule)
+{
+	struct k_thread *pending_thread;
+	uint32_t count = 0U;
+	uint32_t num_free;
+
+	/* Threads only wait to receive while the queue is empty */
+	while ((count < num_msgs) && (msgq->used_msgs == 0U)) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(pending_thread->base.swap_data, data,
+			     msgq->msg_size);
+		data += msgq->msg_size;
+		count++;
+
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		*reschedule = true;
+	}
+
+	num_free = msgq->max_msgs - msgq->used_msgs;
+	if ((count < num_msgs) && (num_free > 0U)) {
+		uint32_t n = MIN(num_msgs - count, num_free);
+
+		msgq_buffer_write(msgq, data, n);
+		count += n;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	return count;
+}
+
+/*
+ * Take up to @a num_msgs messages from the buffer without waiting, then
+ * refill the space they leave from threads waiting to send.
+ *
+ * Returns the number of messages taken.
+ */
+static uint32_t msgq_get_locked(struct k_msgq *msgq, char *data,
+				uint32_t num_msgs, bool *reschedule)
+{
+	struct k_thread *pending_thread;
+	uint32_t n = MIN(num_msgs, msgq->used_msgs);
+
+	if (n == 0U) {
+		/* Any waiters are receivers, leave them be */
+		return 0U;
+	}
+
+	msgq_buffer_read(msgq, data, n);
+
+	while (msgq->used_msgs < msgq->max_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		msgq_buffer_write(msgq, pending_thread->base.swap_data, 1U);
+
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		*reschedule = true;
+	}
+
+	return n;
+}
+
+/* Time left from @a timeout, which started when @a end was calculated */
+static k_timeout_t msgq_timeout_left(k_timeout_t timeout, uint64_t end)
+{
+	int64_t remaining;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return K_FOREVER;
+	}
+
+	remaining = end - sys_clock_tick_get();
+
+	return remaining > 0 ? K_TICKS(remaining) : K_NO_WAIT;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	bool reschedule = false;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, timeout);
+
+	while (true) {
+		k_timeout_t wait;
+
+		count += msgq_put_locked(msgq, src + (count * msgq->msg_size),
+					 num_msgs - count, &reschedule);
+		if (count == num_msgs) {
+			result = (int)count;
+			break;
+		}
+
+		wait = msgq_timeout_left(timeout, end);
+		if (K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			if (count > 0U) {
+				result = (int)count;
+			} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				result = -ENOMSG;
+			} else {
+				result = -EAGAIN;
+			}
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_many, msgq, timeout);
+
+		/* Queue full: wait until a receiver takes the next message
+		 * into the buffer, as k_msgq_put() would.  Pending also runs
+		 * any thread readied so far.
+		 */
+		_current->base.swap_data = (void *)(src + (count * msgq->msg_size));
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, wait);
+		reschedule = false;
+
+		key = k_spin_lock(&msgq->lock);
+		if (result != 0) {
+			if (count > 0U) {
+				result = (int)count;
+			}
+			break;
+		}
+		count++;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+
+	if (reschedule) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	bool reschedule = false;
+	k_spinlock_key_t key;
+	uint32_t count;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, timeout);
+
+	count = msgq_get_locked(msgq, data, num_msgs, &reschedule);
+	if ((count > 0U) || (num_msgs == 0U)) {
+		result = (int)count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_many, msgq, timeout);
+
+		/* Queue empty: wait for the first message to be handed
+		 * over, then collect whatever else arrived meanwhile.
+		 */
+		_current->base.swap_data = data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+		key = k_spin_lock(&msgq->lock);
+		if (result == 0) {
+			count = 1U + msgq_get_locked(msgq,
+						     (char *)data + msgq->msg_size,
+						     num_msgs - 1U, &reschedule);
+			result = (int)count;
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+
+	if (reschedule) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
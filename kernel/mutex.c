@@ -53,6 +53,10 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 
 	z_waitq_init(&mutex->wait_q);
 
+#ifdef CONFIG_CONTENTION_STATS
+	mutex->contention = (struct k_contention_stats){ 0 };
+#endif
+
 	z_object_init(mutex);
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
@@ -92,11 +96,80 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+/*
+ * Busy wait while the owner of the mutex is running on another CPU, so
+ * likely to unlock it soon.  Not worth it if threads are pending on the
+ * mutex: unlocking hands it over to the first of them.  Called and
+ * returns with the lock held, but drops it while polling.  Returns true
+ * if the mutex is free.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t max = k_us_to_cyc_ceil32(CONFIG_ADAPTIVE_SPIN_MAX_US);
+
+	while (mutex->lock_count != 0U) {
+		struct k_thread *owner = mutex->owner;
+
+		if ((z_waitq_head(&mutex->wait_q) != NULL) ||
+		    !z_thread_running_elsewhere(owner)) {
+			return false;
+		}
+
+		k_spin_unlock(&lock, *key);
+
+		do {
+			if ((k_cycle_get_32() - start) >= max) {
+				*key = k_spin_lock(&lock);
+				return mutex->lock_count == 0U;
+			}
+		} while ((*(volatile uint32_t *)&mutex->lock_count != 0U) &&
+			 (*(struct k_thread * volatile *)&mutex->owner == owner));
+
+		*key = k_spin_lock(&lock);
+	}
+
+	return true;
+}
+#endif
+
+/* Called with the lock held on a mutex owned by another thread, returns
+ * true if it got free while spinning.  The cycles spent spinning are
+ * returned in @a spun.
+ */
+static inline bool mutex_contended(struct k_mutex *mutex,
+				   k_spinlock_key_t *key, k_timeout_t timeout,
+				   uint32_t *spun)
+{
+	Z_CONTENTION_INC(mutex, contended);
+
+#ifdef CONFIG_ADAPTIVE_SPIN
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		uint32_t start = k_cycle_get_32();
+
+		if (mutex_spin(mutex, key)) {
+			Z_CONTENTION_INC(mutex, spin_acquired);
+			return true;
+		}
+
+		*spun = k_cycle_get_32() - start;
+	}
+#else
+	ARG_UNUSED(key);
+	ARG_UNUSED(timeout);
+	ARG_UNUSED(spun);
+#endif
+
+	return false;
+}
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+	uint32_t spun = 0U;
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -104,7 +177,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current) ||
+		   mutex_contended(mutex, &key, timeout, &spun))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
@@ -143,6 +217,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+	Z_CONTENTION_INC(mutex, blocked);
+
+#ifdef CONFIG_ADAPTIVE_SPIN
+	timeout = z_spin_timeout_left(timeout, spun);
+#endif
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
@@ -281,3 +361,18 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_CONTENTION_STATS
+void k_mutex_contention_get(struct k_mutex *mutex,
+			    struct k_contention_stats *stats, bool reset)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = mutex->contention;
+	if (reset) {
+		mutex->contention = (struct k_contention_stats){ 0 };
+	}
+
+	k_spin_unlock(&lock, key);
+}
+#endif
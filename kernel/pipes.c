@@ -366,6 +366,11 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 		}
 	}
 
+	if (dest != NULL) {
+		/* Keep the unfilled destination for the next source */
+		sys_dlist_prepend(dest_list, &dest->node);
+	}
+
 	return num_bytes_written;
 }
 
@@ -520,6 +525,39 @@ int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 #include <syscalls/k_pipe_put_mrsh.c>
 #endif
 
+/**
+ * @brief Refill the pipe buffer from waiting writers after a read
+ */
+static void pipe_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc  pipe_desc[2];
+	sys_dlist_t        src_list;
+	sys_dlist_t        pipe_list;
+
+	if (pipe->bytes_used == pipe->size) {
+		return;
+	}
+
+	/*
+	 * The pipe is not full. If there are any waiting writers,
+	 * refill the pipe.
+	 */
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+}
+
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 			     void *data, size_t bytes_to_read,
 			     size_t *bytes_read, size_t min_xfer,
@@ -617,29 +655,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
-
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
-
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
-
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	pipe_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -728,6 +744,379 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <syscalls/k_pipe_get_mrsh.c>
 #endif
 
+static size_t pipe_iov_total(const struct k_pipe_iovec *iov, size_t iovcnt)
+{
+	size_t total = 0U;
+
+	for (size_t i = 0U; i < iovcnt; i++) {
+		total += iov[i].len;
+	}
+
+	return total;
+}
+
+/* Time left from @a timeout, which started when @a end was calculated */
+static k_timeout_t pipe_timeout_left(k_timeout_t timeout, uint64_t end)
+{
+	int64_t remaining;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return K_FOREVER;
+	}
+
+	remaining = end - sys_clock_tick_get();
+
+	return remaining > 0 ? K_TICKS(remaining) : K_NO_WAIT;
+}
+
+/*
+ * The vectored variants make the same transfers as k_pipe_put() and
+ * k_pipe_get() would for the concatenation of the segments, segment by
+ * segment against one list of destinations (or sources) built under a
+ * single lock acquisition.  Woken threads are rescheduled once per pass.
+ *
+ * When they have to block, they do so on the remainder of the current
+ * segment only, as the pipe descriptor of a waiting thread describes a
+ * single buffer, and carry on with the next segments once it has been
+ * transferred.
+ */
+int k_pipe_put_vec(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	struct _pipe_desc  pipe_desc[2];
+	struct _pipe_desc  isr_desc;
+	struct _pipe_desc *src_desc;
+	sys_dlist_t        dest_list;
+	sys_dlist_t        src_list;
+	size_t             bytes_to_write = pipe_iov_total(iov, iovcnt);
+	size_t             num_bytes_written = 0U;
+	size_t             seg = 0U;
+	size_t             seg_offset = 0U;
+	bool               reschedule_needed = false;
+	uint64_t           end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t   key;
+	int                ret;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, put_vec, pipe, timeout);
+
+	CHECKIF((min_xfer > bytes_to_write) || bytes_written == NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put_vec, pipe, timeout,
+					       -EINVAL);
+
+		return -EINVAL;
+	}
+
+	src_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
+
+	key = k_spin_lock(&pipe->lock);
+
+	while (true) {
+		size_t bytes_can_write;
+		k_timeout_t wait;
+
+		sys_dlist_init(&dest_list);
+
+		bytes_can_write = pipe_waiter_list_populate(&dest_list,
+					&pipe->wait_q.readers,
+					bytes_to_write - num_bytes_written);
+
+		if (pipe->bytes_used != pipe->size) {
+			bytes_can_write += pipe_buffer_list_populate(&dest_list,
+							pipe_desc,
+							pipe->buffer,
+							pipe->size,
+							pipe->write_index,
+							pipe->read_index);
+		}
+
+		if ((bytes_can_write < min_xfer) &&
+		    (K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+
+			/* The request can not be fulfilled. */
+
+			k_spin_unlock(&pipe->lock, key);
+			*bytes_written = 0U;
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put_vec, pipe,
+						       timeout, -EIO);
+
+			return -EIO;
+		}
+
+		/* Feed the segments to the destinations until either runs out */
+
+		for (; seg < iovcnt; seg++, seg_offset = 0U) {
+			size_t bytes_copied;
+
+			src_desc->buffer        = (unsigned char *)iov[seg].buf +
+						  seg_offset;
+			src_desc->bytes_to_xfer = iov[seg].len - seg_offset;
+			src_desc->thread        = _current;
+
+			sys_dlist_init(&src_list);
+			sys_dlist_append(&src_list, &src_desc->node);
+
+			bytes_copied = pipe_write(pipe, &src_list, &dest_list,
+						  &reschedule_needed);
+
+			num_bytes_written += bytes_copied;
+			seg_offset += bytes_copied;
+
+			if (seg_offset < iov[seg].len) {
+				break;
+			}
+		}
+
+		if ((pipe->bytes_used != 0U) && (num_bytes_written != 0U)) {
+			handle_poll_events(pipe);
+		}
+
+		wait = pipe_timeout_left(timeout, end);
+
+		if ((num_bytes_written == bytes_to_write) ||
+		    (K_TIMEOUT_EQ(wait, K_NO_WAIT)) ||
+		    ((num_bytes_written >= min_xfer) && (min_xfer > 0U))) {
+			break;
+		}
+
+		/* Block until the rest of this segment has been read. */
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_pipe, put_vec, pipe, timeout);
+
+		_current->base.swap_data = src_desc;
+
+		z_sched_wait(&pipe->lock, key, &pipe->wait_q.writers, wait, NULL);
+
+		/*
+		 * Taking the lock again also holds us back, on SMP, until
+		 * a reader that is still copying from our buffer is done.
+		 */
+
+		key = k_spin_lock(&pipe->lock);
+		reschedule_needed = false;
+
+		num_bytes_written += iov[seg].len - seg_offset -
+				     src_desc->bytes_to_xfer;
+		seg_offset = iov[seg].len - src_desc->bytes_to_xfer;
+
+		if (src_desc->bytes_to_xfer != 0U) {
+			/* Timed out */
+			break;
+		}
+
+		seg++;
+		seg_offset = 0U;
+	}
+
+	*bytes_written = num_bytes_written;
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	ret = pipe_return_code(min_xfer, bytes_to_write - num_bytes_written,
+			       bytes_to_write);
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* Backwards compatible with k_pipe_put(), see there */
+		ret = 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put_vec, pipe, timeout, ret);
+
+	return ret;
+}
+
+int k_pipe_get_vec(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	struct _pipe_desc   pipe_desc[2];
+	struct _pipe_desc   isr_desc;
+	struct _pipe_desc  *dest_desc;
+	struct _pipe_desc  *src_desc;
+	sys_dlist_t         src_list;
+	size_t              bytes_to_read = pipe_iov_total(iov, iovcnt);
+	size_t              num_bytes_read = 0U;
+	size_t              seg = 0U;
+	size_t              seg_offset = 0U;
+	bool                reschedule_needed = false;
+	uint64_t            end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t    key;
+	int                 ret;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, get_vec, pipe, timeout);
+
+	CHECKIF((min_xfer > bytes_to_read) || bytes_read == NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get_vec, pipe, timeout,
+					       -EINVAL);
+
+		return -EINVAL;
+	}
+
+	dest_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
+
+	key = k_spin_lock(&pipe->lock);
+
+	while (true) {
+		size_t bytes_can_read = 0U;
+		k_timeout_t wait;
+
+		sys_dlist_init(&src_list);
+
+		if (pipe->bytes_used != 0U) {
+			bytes_can_read = pipe_buffer_list_populate(&src_list,
+							pipe_desc,
+							pipe->buffer,
+							pipe->size,
+							pipe->read_index,
+							pipe->write_index);
+		}
+
+		bytes_can_read += pipe_waiter_list_populate(&src_list,
+					&pipe->wait_q.writers,
+					bytes_to_read - num_bytes_read);
+
+		if ((bytes_can_read < min_xfer) &&
+		    (K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+
+			/* The request can not be fulfilled. */
+
+			k_spin_unlock(&pipe->lock, key);
+			*bytes_read = 0U;
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get_vec, pipe,
+						       timeout, -EIO);
+
+			return -EIO;
+		}
+
+		/* Drain the sources into the segments until either runs out */
+
+		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
+		while ((src_desc != NULL) && (seg < iovcnt)) {
+			size_t bytes_copied;
+
+			bytes_copied = pipe_xfer((unsigned char *)iov[seg].buf +
+						 seg_offset,
+						 iov[seg].len - seg_offset,
+						 src_desc->buffer,
+						 src_desc->bytes_to_xfer);
+
+			num_bytes_read += bytes_copied;
+			seg_offset += bytes_copied;
+
+			src_desc->buffer += bytes_copied;
+			src_desc->bytes_to_xfer -= bytes_copied;
+
+			if (src_desc->thread == NULL) {
+
+				/* Reading from the pipe buffer. Update details. */
+
+				pipe->bytes_used -= bytes_copied;
+				pipe->read_index += bytes_copied;
+				if (pipe->read_index >= pipe->size) {
+					pipe->read_index -= pipe->size;
+				}
+			} else if (src_desc->bytes_to_xfer == 0U) {
+
+				/* The thread's write request has been satisfied. */
+
+				z_unpend_thread(src_desc->thread);
+				z_ready_thread(src_desc->thread);
+
+				reschedule_needed = true;
+			}
+
+			if (src_desc->bytes_to_xfer == 0U) {
+				src_desc = (struct _pipe_desc *)
+					   sys_dlist_get(&src_list);
+			}
+
+			if (seg_offset == iov[seg].len) {
+				seg++;
+				seg_offset = 0U;
+			}
+		}
+
+		/* Skip any trailing empty segments */
+
+		while ((seg < iovcnt) && (iov[seg].len == 0U)) {
+			seg++;
+		}
+
+		pipe_refill(pipe, &reschedule_needed);
+
+		wait = pipe_timeout_left(timeout, end);
+
+		if ((num_bytes_read == bytes_to_read) ||
+		    (K_TIMEOUT_EQ(wait, K_NO_WAIT)) ||
+		    ((num_bytes_read >= min_xfer) && (min_xfer > 0U))) {
+			break;
+		}
+
+		/* Block until the rest of this segment has been written. */
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_pipe, get_vec, pipe, timeout);
+
+		dest_desc->buffer        = (unsigned char *)iov[seg].buf +
+					   seg_offset;
+		dest_desc->bytes_to_xfer = iov[seg].len - seg_offset;
+		dest_desc->thread        = _current;
+
+		_current->base.swap_data = dest_desc;
+
+		z_sched_wait(&pipe->lock, key, &pipe->wait_q.readers, wait, NULL);
+
+		/*
+		 * Taking the lock again also holds us back, on SMP, until
+		 * a writer that is still copying into our buffer is done.
+		 */
+
+		key = k_spin_lock(&pipe->lock);
+		reschedule_needed = false;
+
+		num_bytes_read += iov[seg].len - seg_offset -
+				  dest_desc->bytes_to_xfer;
+		seg_offset = iov[seg].len - dest_desc->bytes_to_xfer;
+
+		if (dest_desc->bytes_to_xfer != 0U) {
+			/* Timed out */
+			break;
+		}
+
+		seg++;
+		seg_offset = 0U;
+	}
+
+	*bytes_read = num_bytes_read;
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	ret = pipe_return_code(min_xfer, bytes_to_read - num_bytes_read,
+			       bytes_to_read);
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* Backwards compatible with k_pipe_get(), see there */
+		ret = 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get_vec, pipe, timeout, ret);
+
+	return ret;
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -42,6 +42,17 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 					   struct k_thread *thread);
+#elif defined(CONFIG_SCHED_BITMAP)
+#define _priq_run_add		z_priq_bm_add
+#define _priq_run_remove	z_priq_bm_remove
+#define _priq_run_best		z_priq_bm_best
+#endif
+
+#if defined(CONFIG_SCHED_BITMAP) || defined(CONFIG_WAITQ_BITMAP)
+static ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq,
+					struct k_thread *thread);
+static ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq,
+					   struct k_thread *thread);
 #endif
 
 #if defined(CONFIG_WAITQ_SCALABLE)
@@ -52,6 +63,10 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 #define z_priq_wait_add		z_priq_dumb_add
 #define _priq_wait_remove	z_priq_dumb_remove
 #define _priq_wait_best		z_priq_dumb_best
+#elif defined(CONFIG_WAITQ_BITMAP)
+#define z_priq_wait_add		z_priq_bm_add
+#define _priq_wait_remove	z_priq_bm_remove
+#define _priq_wait_best		z_priq_bm_best
 #endif
 
 struct k_spinlock sched_spinlock;
@@ -230,11 +245,17 @@ static ALWAYS_INLINE void *curr_cpu_runq(void)
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	_priq_run_add(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	CONTAINER_OF(thread_runq(thread), struct _ready_q, runq)->depth++;
+#endif
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	CONTAINER_OF(thread_runq(thread), struct _ready_q, runq)->depth--;
+#endif
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
@@ -601,6 +622,33 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+/* Both are unsynchronized snapshots, which is all the adaptive
+ * spinning heuristics in mutex.c and sem.c need.  Callers must have
+ * interrupts locked so the current CPU can't change under them.
+ */
+bool z_thread_running_elsewhere(struct k_thread *thread)
+{
+	return thread_active_elsewhere(thread);
+}
+
+bool z_other_cpus_busy(void)
+{
+	int currcpu = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if ((i != currcpu) && (curr != NULL) &&
+		    !z_is_idle_thread_object(curr)) {
+			return true;
+		}
+	}
+	return false;
+}
+#endif
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -613,6 +661,7 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_ready_stamp(thread);
 		queue_thread(thread);
 		update_cache(0);
 		flag_ipi();
@@ -904,6 +953,22 @@ void z_unpend_thread(struct k_thread *thread)
 	(void)z_abort_thread_timeout(thread);
 }
 
+/* Wait queues are ordered by priority (the bitmap one even finds a
+ * thread's list by it), so a pended thread has to be requeued.
+ */
+static void set_unqueued_prio(struct k_thread *thread, int prio)
+{
+	if (thread->base.pended_on != NULL) {
+		_wait_q_t *wait_q = pended_on_thread(thread);
+
+		_priq_wait_remove(&wait_q->waitq, thread);
+		thread->base.prio = prio;
+		z_priq_wait_add(&wait_q->waitq, thread);
+	} else {
+		thread->base.prio = prio;
+	}
+}
+
 /* Priority set utility that does no rescheduling, it just changes the
  * run queue state, returning true if a reschedule is needed later.
  */
@@ -925,7 +990,7 @@ bool z_set_prio(struct k_thread *thread, int prio)
 			}
 			update_cache(1);
 		} else {
-			thread->base.prio = prio;
+			set_unqueued_prio(thread, prio);
 		}
 	}
 
@@ -1267,6 +1332,94 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+#if defined(CONFIG_SCHED_BITMAP) || defined(CONFIG_WAITQ_BITMAP)
+BUILD_ASSERT(Z_PRIQ_BM_GROUPS < 32, "Too many priorities for bitmap queue");
+
+static ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq,
+					struct k_thread *thread)
+{
+	int level = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int group = level / 32;
+
+	/* Lists are only valid while their bit is set, so that an
+	 * all-zero queue needs no initialization
+	 */
+	if ((pq->bitmap[group] & BIT(level % 32)) == 0U) {
+		sys_dlist_init(&pq->queues[level]);
+		pq->bitmap[group] |= BIT(level % 32);
+		pq->groups |= BIT(group);
+	}
+	sys_dlist_append(&pq->queues[level], &thread->base.qnode_dlist);
+}
+
+static ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq,
+					   struct k_thread *thread)
+{
+	int level = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int group = level / 32;
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+	if (sys_dlist_is_empty(&pq->queues[level])) {
+		pq->bitmap[group] &= ~BIT(level % 32);
+		if (pq->bitmap[group] == 0U) {
+			pq->groups &= ~BIT(group);
+		}
+	}
+}
+
+/* First thread of the first non-empty level at or after @a level */
+static struct k_thread *priq_bm_first_from(struct _priq_bm *pq, int level)
+{
+	int group = level / 32;
+	uint32_t bits;
+
+	if (group >= Z_PRIQ_BM_GROUPS) {
+		return NULL;
+	}
+
+	bits = pq->bitmap[group] & ~BIT_MASK(level % 32);
+	if (bits == 0U) {
+		uint32_t groups = pq->groups & ~BIT_MASK(group + 1);
+
+		if (groups == 0U) {
+			return NULL;
+		}
+		group = __builtin_ctz(groups);
+		bits = pq->bitmap[group];
+	}
+
+	level = group * 32 + __builtin_ctz(bits);
+
+	return CONTAINER_OF(sys_dlist_peek_head_not_empty(&pq->queues[level]),
+			    struct k_thread, base.qnode_dlist);
+}
+
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq)
+{
+	if (pq->groups == 0U) {
+		return NULL;
+	}
+
+	int group = __builtin_ctz(pq->groups);
+	int level = group * 32 + __builtin_ctz(pq->bitmap[group]);
+
+	return CONTAINER_OF(sys_dlist_peek_head_not_empty(&pq->queues[level]),
+			    struct k_thread, base.qnode_dlist);
+}
+
+struct k_thread *z_priq_bm_next(struct _priq_bm *pq, struct k_thread *thread)
+{
+	int level = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dnode_t *n = sys_dlist_peek_next_no_check(&pq->queues[level],
+						      &thread->base.qnode_dlist);
+
+	if (n != NULL) {
+		return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+	}
+	return priq_bm_first_from(pq, level + 1);
+}
+#endif
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1290,9 +1443,11 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
+#elif defined(CONFIG_SCHED_BITMAP)
+	rq->runq = (struct _priq_bm) { 0 };
 #else
 	sys_dlist_init(&rq->runq);
 #endif
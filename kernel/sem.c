@@ -58,6 +58,9 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 	z_waitq_init(&sem->wait_q);
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&sem->poll_events);
+#endif
+#ifdef CONFIG_CONTENTION_STATS
+	sem->contention = (struct k_contention_stats){ 0 };
 #endif
 	z_object_init(sem);
 
@@ -121,6 +124,41 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <syscalls/k_sem_give_mrsh.c>
 #endif
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+/*
+ * A semaphore has no owner to watch, so busy wait while any other CPU
+ * is running a thread that might give it.  Not done when threads are
+ * already pending, as a give would go to the first of them.  Called and
+ * returns with the lock held, but drops it while polling.  Returns true
+ * if the count is non-zero.
+ */
+static bool sem_spin(struct k_sem *sem, k_spinlock_key_t *key)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t max = k_us_to_cyc_ceil32(CONFIG_ADAPTIVE_SPIN_MAX_US);
+
+	while (sem->count == 0U) {
+		if ((z_waitq_head(&sem->wait_q) != NULL) ||
+		    !z_other_cpus_busy()) {
+			return false;
+		}
+
+		k_spin_unlock(&lock, *key);
+
+		do {
+			if ((k_cycle_get_32() - start) >= max) {
+				*key = k_spin_lock(&lock);
+				return sem->count > 0U;
+			}
+		} while (*(volatile unsigned int *)&sem->count == 0U);
+
+		*key = k_spin_lock(&lock);
+	}
+
+	return true;
+}
+#endif
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret = 0;
@@ -139,14 +177,32 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 		goto out;
 	}
 
+	Z_CONTENTION_INC(sem, contended);
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		k_spin_unlock(&lock, key);
 		ret = -EBUSY;
 		goto out;
 	}
 
+#ifdef CONFIG_ADAPTIVE_SPIN
+	uint32_t start = k_cycle_get_32();
+
+	if (sem_spin(sem, &key)) {
+		Z_CONTENTION_INC(sem, spin_acquired);
+		sem->count--;
+		k_spin_unlock(&lock, key);
+		ret = 0;
+		goto out;
+	}
+
+	timeout = z_spin_timeout_left(timeout, k_cycle_get_32() - start);
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+	Z_CONTENTION_INC(sem, blocked);
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
 out:
@@ -200,3 +256,18 @@ static inline unsigned int z_vrfy_k_sem_count_get(struct k_sem *sem)
 #include <syscalls/k_sem_count_get_mrsh.c>
 
 #endif
+
+#ifdef CONFIG_CONTENTION_STATS
+void k_sem_contention_get(struct k_sem *sem, struct k_contention_stats *stats,
+			  bool reset)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = sem->contention;
+	if (reset) {
+		sem->contention = (struct k_contention_stats){ 0 };
+	}
+
+	k_spin_unlock(&lock, key);
+}
+#endif
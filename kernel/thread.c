@@ -634,6 +634,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	new_thread->base.usage.track_usage =
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	new_thread->base.ready_stamp = 0U;
+	new_thread->base.wakeup = (struct k_wakeup_stats) {};
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
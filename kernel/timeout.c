@@ -14,7 +14,17 @@
 
 static uint64_t curr_tick;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b);
+
+static struct rbtree timeout_tree = {
+	.lessthan_fn = timeout_lessthan,
+};
+
+static uint32_t next_order_key;
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +46,71 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+/* In the scalable backend, dticks holds the absolute expiry tick and
+ * the tree is ordered by it, with order_key preserving insertion
+ * order among timeouts expiring on the same tick.
+ */
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+
+	if (ta->dticks != tb->dticks) {
+		return ta->dticks < tb->dticks;
+	}
+
+	return ta->order_key < tb->order_key;
+}
+
+static struct _timeout *first(void)
+{
+	struct rbnode *n = rb_get_min(&timeout_tree);
+
+	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Ticks from curr_tick until the given queued timeout expires */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks - (int64_t)curr_tick;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	struct _timeout *t;
+
+	to->dticks = curr_tick + dticks;
+	to->order_key = next_order_key++;
+
+	/* Renumber at wraparound, exactly as the scheduler's rbtree
+	 * priority queue does.  Walking in tree order keeps the
+	 * relative order of same-tick timeouts intact.
+	 */
+	if (next_order_key == 0U) {
+		RB_FOR_EACH_CONTAINER(&timeout_tree, t, node) {
+			t->order_key = next_order_key++;
+		}
+		to->order_key = next_order_key++;
+	}
+
+	rb_insert(&timeout_tree, &to->node);
+	to->linked = true;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	rb_remove(&timeout_tree, &t->node);
+	t->linked = false;
+
+	if (timeout_tree.root == NULL) {
+		next_order_key = 0U;
+	}
+}
+
+#else /* !CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +125,31 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	struct _timeout *t;
+
+	to->dticks = dticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -59,6 +159,8 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -71,10 +173,10 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_dticks(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_dticks(to) - ticks_elapsed);
 	}
 
 	return ret;
@@ -91,33 +193,22 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT_NO_MSG(arch_mem_coherent(to));
 #endif
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t dticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
 
-			to->dticks = MAX(1, ticks);
+			dticks = MAX(1, ticks);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+			dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, dticks);
 
 		if (to == first()) {
 			sys_clock_set_timeout(next_timeout(), false);
@@ -130,7 +221,7 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	LOCKED(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
+		if (!z_is_inactive_timeout(to)) {
 			remove_timeout(to);
 			ret = 0;
 		}
@@ -148,12 +239,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	ticks = timeout_dticks(timeout);
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -211,12 +306,15 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t = first();
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_dticks(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_dticks(t);
 
 		curr_tick += dt;
-		t->dticks = 0;
+		if (!IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SCALABLE)) {
+			/* Nothing left to carry into the successor's delta */
+			t->dticks = 0;
+		}
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -225,7 +323,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
+	if (!IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SCALABLE) && (t != NULL)) {
 		t->dticks -= announce_remaining;
 	}
 
@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -71,8 +72,53 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif
 }
 
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+static void sched_wakeup_update(struct _cpu *cpu, struct k_thread *thread)
+{
+	struct k_runq_stats *rq = &cpu->runq_stats;
+	uint32_t depth = z_sched_runq_depth(cpu);
+
+	rq->num_samples++;
+	rq->total += depth;
+	if (rq->peak < depth) {
+		rq->peak = depth;
+	}
+
+	if ((thread->base.ready_stamp != 0U) && thread->base.usage.track_usage) {
+		struct k_wakeup_stats *w = &thread->base.wakeup;
+		uint32_t cycles = k_cycle_get_32() - thread->base.ready_stamp;
+		uint32_t us;
+		int bucket;
+
+		/* A stamp taken at cycle 0 was moved up to 1 */
+		if ((int32_t)cycles < 0) {
+			cycles = 0U;
+		}
+
+		us = k_cyc_to_us_floor32(cycles);
+		bucket = (us == 0U) ? 0 : 32 - u32_count_leading_zeros(us);
+
+		w->count++;
+		w->total += cycles;
+		if (w->longest < cycles) {
+			w->longest = cycles;
+		}
+		w->hist[MIN(bucket, CONFIG_SCHED_WAKEUP_LATENCY_BUCKETS - 1)]++;
+	}
+
+	thread->base.ready_stamp = 0U;
+}
+#endif
+
 void z_sched_usage_start(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	k_spinlock_key_t  wkey = k_spin_lock(&usage_lock);
+
+	sched_wakeup_update(_current_cpu, thread);
+	k_spin_unlock(&usage_lock, wkey);
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	k_spinlock_key_t  key;
 
@@ -343,3 +389,47 @@ void k_sys_runtime_stats_disable(void)
 	k_spin_unlock(&usage_lock, key);
 }
 #endif
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+int k_thread_wakeup_stats_get(k_tid_t thread, struct k_wakeup_stats *stats,
+			      bool reset)
+{
+	k_spinlock_key_t  key;
+
+	CHECKIF((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+
+	*stats = thread->base.wakeup;
+	if (reset) {
+		thread->base.wakeup = (struct k_wakeup_stats) {};
+	}
+
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+int k_sched_runq_stats_get(int cpu, struct k_runq_stats *stats, bool reset)
+{
+	k_spinlock_key_t  key;
+
+	CHECKIF((stats == NULL) || (cpu < 0) || (cpu >= arch_num_cpus())) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+
+	*stats = _kernel.cpus[cpu].runq_stats;
+	stats->depth = z_sched_runq_depth(&_kernel.cpus[cpu]);
+	if (reset) {
+		_kernel.cpus[cpu].runq_stats = (struct k_runq_stats) {};
+	}
+
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+#endif
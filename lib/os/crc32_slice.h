@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_CRC32_SLICE_H_
+#define ZEPHYR_LIB_OS_CRC32_SLICE_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <zephyr/sys/byteorder.h>
+
+/* Slicing-by-N update shared by the reflected CRC-32 variants
+ * (IEEE 802.3 and Castagnoli).  table[0] is the usual byte-wise table
+ * for the polynomial and table[k][n] is the CRC of byte n followed by
+ * k zero bytes, so N input bytes can be folded in with N independent
+ * lookups instead of N dependent ones.  The caller owns any
+ * pre/post-inversion; @a crc is the raw register value.
+ */
+
+#if defined(CONFIG_CRC32_SW_SLICE_BY_8)
+#define CRC32_SLICES 8
+#elif defined(CONFIG_CRC32_SW_SLICE_BY_4)
+#define CRC32_SLICES 4
+#endif
+
+#ifdef CRC32_SLICES
+
+static inline uint32_t crc32_slice_update(const uint32_t table[][256],
+					  uint32_t crc, const uint8_t *data,
+					  size_t len)
+{
+	/* sys_get_le32() keeps this alignment and endian agnostic; the
+	 * compiler folds it into a plain load where that is legal.
+	 */
+	for (; len >= CRC32_SLICES; len -= CRC32_SLICES, data += CRC32_SLICES) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+
+#if CRC32_SLICES == 8
+		uint32_t hi = sys_get_le32(data + 4);
+
+		crc = table[7][lo & 0xff] ^
+		      table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^
+		      table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^
+		      table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^
+		      table[0][hi >> 24];
+#else
+		crc = table[3][lo & 0xff] ^
+		      table[2][(lo >> 8) & 0xff] ^
+		      table[1][(lo >> 16) & 0xff] ^
+		      table[0][lo >> 24];
+#endif
+	}
+
+	for (; len > 0; len--) {
+		crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xff];
+	}
+
+	return crc;
+}
+
+#endif /* CRC32_SLICES */
+
+#endif /* ZEPHYR_LIB_OS_CRC32_SLICE_H_ */
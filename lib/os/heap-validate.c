@@ -83,8 +83,37 @@ static void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Cached chunks are marked used but count as free */
+	*alloc_bytes -= h->cache.cached_bytes;
+	*free_bytes += h->cache.cached_bytes;
+#endif
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+static bool valid_cache(struct z_heap *h)
+{
+	size_t cached_bytes = 0;
+
+	for (int sz = 0; sz < HEAP_CACHE_CLASSES; sz++) {
+		uint32_t n = 0;
+
+		for (chunkid_t c = h->cache.head[sz]; c != 0;
+		     n++, c = next_free_chunk(h, c)) {
+			VALIDATE(n < h->cache.count[sz]);
+			VALIDATE(valid_chunk(h, c));
+			VALIDATE(chunk_used(h, c));
+			VALIDATE(chunk_size(h, c) == sz);
+			cached_bytes += chunksz_to_bytes(h, sz);
+		}
+		VALIDATE(n == h->cache.count[sz]);
+	}
+
+	return cached_bytes == h->cache.cached_bytes;
+}
+#endif
+
 bool sys_heap_validate(struct sys_heap *heap)
 {
 	struct z_heap *h = heap->heap;
@@ -102,6 +131,12 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (!valid_cache(h)) {
+		return false;
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -439,3 +474,22 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 }
 
 #endif
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	stats->hits = heap->heap->cache.hits;
+	stats->misses = heap->heap->cache.misses;
+	stats->flushes = heap->heap->cache.flushes;
+	stats->cached_bytes = heap->heap->cache.cached_bytes;
+
+	return 0;
+}
+
+#endif
@@ -148,6 +148,134 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+/* Pops a cached chunk of exactly @a sz chunk units, or returns 0 */
+static chunkid_t cache_get(struct z_heap *h, chunksz_t sz)
+{
+	struct z_heap_cache *cache = &h->cache;
+	chunkid_t c;
+
+	if (sz >= HEAP_CACHE_CLASSES) {
+		return 0;
+	}
+
+	c = cache->head[sz];
+	if (c == 0U) {
+		cache->misses++;
+		return 0;
+	}
+
+	CHECK(chunk_used(h, c) && chunk_size(h, c) == sz);
+
+	cache->head[sz] = next_free_chunk(h, c);
+	cache->count[sz]--;
+	cache->hits++;
+	cache->cached_bytes -= chunksz_to_bytes(h, sz);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+
+	return c;
+}
+
+/* Parks a just-freed chunk in the cache if its class has room */
+static bool cache_put(struct z_heap *h, chunkid_t c)
+{
+	struct z_heap_cache *cache = &h->cache;
+	chunksz_t sz = chunk_size(h, c);
+
+	if (sz >= HEAP_CACHE_CLASSES || cache->count[sz] >= cache->depth) {
+		return false;
+	}
+
+	set_next_free_chunk(h, c, cache->head[sz]);
+	cache->head[sz] = c;
+	cache->count[sz]++;
+	cache->cached_bytes += chunksz_to_bytes(h, sz);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+
+	return true;
+}
+
+/* Cached chunks stay marked used, so the used bit alone can't catch a
+ * second free of one.  Walks the (depth bounded) list of its class.
+ */
+static inline bool cache_holds(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if (sz >= HEAP_CACHE_CLASSES) {
+		return false;
+	}
+
+	for (chunkid_t i = h->cache.head[sz]; i != 0U;
+	     i = next_free_chunk(h, i)) {
+		if (i == c) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Returns every cached chunk to the heap proper.  Returns true if
+ * there was anything to return.
+ */
+static bool cache_flush(struct z_heap *h)
+{
+	struct z_heap_cache *cache = &h->cache;
+
+	if (cache->cached_bytes == 0U) {
+		return false;
+	}
+
+	for (int sz = 0; sz < HEAP_CACHE_CLASSES; sz++) {
+		while (cache->head[sz] != 0U) {
+			chunkid_t c = cache->head[sz];
+
+			cache->head[sz] = next_free_chunk(h, c);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+			h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+		}
+		cache->count[sz] = 0;
+	}
+
+	cache->cached_bytes = 0;
+	cache->flushes++;
+
+	return true;
+}
+
+#else
+
+static inline chunkid_t cache_get(struct z_heap *h, chunksz_t sz)
+{
+	return 0;
+}
+
+static inline bool cache_put(struct z_heap *h, chunkid_t c)
+{
+	return false;
+}
+
+static inline bool cache_flush(struct z_heap *h)
+{
+	return false;
+}
+
+static inline bool cache_holds(struct z_heap *h, chunkid_t c)
+{
+	return false;
+}
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -172,7 +300,7 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	 * This should catch many double-free cases.
 	 * This is cheap enough so let's do it all the time.
 	 */
-	__ASSERT(chunk_used(h, c),
+	__ASSERT(chunk_used(h, c) && !cache_holds(h, c),
 		 "unexpected heap state (double-free?) for memory at %p", mem);
 
 	/*
@@ -184,7 +312,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +321,11 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+	if (cache_put(h, c)) {
+		return;
+	}
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -270,18 +402,25 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = cache_get(h, chunk_sz);
+
 	if (c == 0U) {
-		return NULL;
-	}
+		c = alloc_chunk(h, chunk_sz);
+		if (c == 0U && cache_flush(h)) {
+			c = alloc_chunk(h, chunk_sz);
+		}
+		if (c == 0U) {
+			return NULL;
+		}
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
-	}
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
 
-	set_chunk_used(h, c, true);
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
@@ -335,6 +474,9 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+	if (c0 == 0 && cache_flush(h)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -482,6 +624,18 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	return ptr2;
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+void sys_heap_cache_depth_set(struct sys_heap *heap, uint16_t depth)
+{
+	struct z_heap *h = heap->heap;
+
+	if (depth < h->cache.depth) {
+		(void)cache_flush(h);
+	}
+	h->cache.depth = depth;
+}
+#endif
+
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
 	IF_ENABLED(CONFIG_MSAN, (__sanitizer_dtor_callback(mem, bytes)));
@@ -517,6 +671,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	h->cache = (struct z_heap_cache) {
+		.depth = CONFIG_SYS_HEAP_CACHE_DEPTH,
+	};
+#endif
+
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
 				     nb_buckets * sizeof(struct z_heap_bucket));
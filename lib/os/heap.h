@@ -65,6 +65,27 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* The small allocation cache keeps one singly-linked LIFO list of
+ * freed chunks per exact chunk size, indexed by that size.  Cached
+ * chunks stay marked used, and the list link lives in the FREE_NEXT
+ * field (i.e. in the former user memory).  The class count is sized
+ * for the larger 8 byte chunk header.
+ */
+#define HEAP_CACHE_CLASSES \
+	((CONFIG_SYS_HEAP_CACHE_MAX_BYTES + 8U + CHUNK_UNIT - 1U) / CHUNK_UNIT + 1U)
+
+struct z_heap_cache {
+	chunkid_t head[HEAP_CACHE_CLASSES];
+	uint16_t count[HEAP_CACHE_CLASSES];
+	uint16_t depth;
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t flushes;
+	size_t cached_bytes;
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +94,9 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct z_heap_cache cache;
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -438,16 +438,18 @@ static bool equivalent_types(enum json_tokens type1, enum json_tokens type2)
 	return type1 == type2;
 }
 
-static int64_t obj_parse(struct json_obj *obj,
+struct obj_index;
+
+static int64_t obj_parse(struct json_obj *obj, struct obj_index *index,
 			 const struct json_obj_descr *descr, size_t descr_len,
 			 void *val);
-static int arr_parse(struct json_obj *obj,
+static int arr_parse(struct json_obj *obj, struct obj_index *index,
 		     const struct json_obj_descr *elem_descr,
 		     size_t max_elements, void *field, void *val);
 
 static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val);
 
-static int64_t decode_value(struct json_obj *obj,
+static int64_t decode_value(struct json_obj *obj, struct obj_index *index,
 			    const struct json_obj_descr *descr,
 			    struct json_token *value, void *field, void *val)
 {
@@ -458,11 +460,11 @@ static int64_t decode_value(struct json_obj *obj,
 
 	switch (descr->type) {
 	case JSON_TOK_OBJECT_START:
-		return obj_parse(obj, descr->object.sub_descr,
+		return obj_parse(obj, index, descr->object.sub_descr,
 				 descr->object.sub_descr_len,
 				 field);
 	case JSON_TOK_ARRAY_START:
-		return arr_parse(obj, descr->array.element_descr,
+		return arr_parse(obj, index, descr->array.element_descr,
 				 descr->array.n_elements, field, val);
 	case JSON_TOK_OBJ_ARRAY: {
 		struct json_obj_token *obj_token = field;
@@ -538,7 +540,7 @@ static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
 	}
 }
 
-static int arr_parse(struct json_obj *obj,
+static int arr_parse(struct json_obj *obj, struct obj_index *index,
 		     const struct json_obj_descr *elem_descr,
 		     size_t max_elements, void *field, void *val)
 {
@@ -566,7 +568,7 @@ static int arr_parse(struct json_obj *obj,
 			return -ENOSPC;
 		}
 
-		if (decode_value(obj, elem_descr, &value, field, NULL) < 0) {
+		if (decode_value(obj, index, elem_descr, &value, field, NULL) < 0) {
 			return -EINVAL;
 		}
 
@@ -620,11 +622,102 @@ static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val)
 	return -EINVAL;
 }
 
-static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
-			 size_t descr_len, void *val)
+/* Open addressing hash table of the fields of a descriptor, holding the
+ * index of each field plus one, or 0 for an empty slot. Fields of the
+ * same hash are found in descriptor order by probing.
+ *
+ * A single table is shared by all the objects of one parse, whatever
+ * their nesting depth, and only rebuilt when an object needs it while it
+ * holds the fields of another descriptor.
+ */
+#define OBJ_INDEX_SIZE 128
+
+BUILD_ASSERT(OBJ_INDEX_SIZE >= 2 * (sizeof(int64_t) * CHAR_BIT - 1),
+	     "Field index must stay at most half full");
+
+struct obj_index {
+	const struct json_obj_descr *descr; /* NULL until first built */
+	size_t descr_len;
+	size_t mask;
+	uint8_t slots[OBJ_INDEX_SIZE];
+};
+
+/* Same as Z_JSON_NAME_HASH() */
+static uint8_t field_name_hash(const char *name, size_t len)
+{
+	if (len == 0) {
+		return 0;
+	}
+
+	return (uint8_t)(len * 31U + (uint8_t)name[0] * 7U +
+			 (uint8_t)name[len / 2] * 3U + (uint8_t)name[len - 1]);
+}
+
+static void obj_index_init(struct obj_index *index,
+			   const struct json_obj_descr *descr, size_t descr_len)
+{
+	size_t size = 8;
+
+	while (size < 2 * descr_len) {
+		size <<= 1;
+	}
+
+	index->descr = descr;
+	index->descr_len = descr_len;
+	index->mask = size - 1;
+	memset(index->slots, 0, size);
+
+	for (size_t i = 0; i < descr_len; i++) {
+		/* Descriptors not set up with the macros have no hash */
+		size_t slot = (descr[i].field_name_hash != 0U) ?
+			descr[i].field_name_hash :
+			field_name_hash(descr[i].field_name, descr[i].field_name_len);
+
+		slot &= index->mask;
+		while (index->slots[slot] != 0U) {
+			slot = (slot + 1) & index->mask;
+		}
+
+		index->slots[slot] = i + 1;
+	}
+}
+
+static bool field_matches(const struct json_obj_descr *descr,
+			  const struct json_obj_key_value *kv)
+{
+	return kv->key_len == descr->field_name_len &&
+	       memcmp(kv->key, descr->field_name, descr->field_name_len) == 0;
+}
+
+/* First field of the key not decoded yet, or SIZE_MAX */
+static size_t obj_index_lookup(const struct obj_index *index,
+			       const struct json_obj_descr *descr,
+			       int64_t decoded_fields,
+			       const struct json_obj_key_value *kv)
+{
+	size_t slot = field_name_hash(kv->key, kv->key_len) & index->mask;
+
+	while (index->slots[slot] != 0U) {
+		size_t i = index->slots[slot] - 1;
+
+		if (!(decoded_fields & ((int64_t)1 << i)) &&
+		    field_matches(&descr[i], kv)) {
+			return i;
+		}
+
+		slot = (slot + 1) & index->mask;
+	}
+
+	return SIZE_MAX;
+}
+
+static int64_t obj_parse(struct json_obj *obj, struct obj_index *index,
+			 const struct json_obj_descr *descr, size_t descr_len,
+			 void *val)
 {
 	struct json_obj_key_value kv;
 	int64_t decoded_fields = 0;
+	size_t next_field = 0;
 	size_t i;
 	int ret;
 
@@ -633,34 +726,35 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
-
-			/* Field has been decoded already, skip */
-			if (decoded_fields & ((int64_t)1 << i)) {
-				continue;
-			}
-
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
+		/* Encoders almost always emit keys in the order the
+		 * descriptor lists them, so try the field after the last
+		 * one matched first. Any other key is looked up in a hash
+		 * table of the fields, only built for objects needing it.
+		 * Nested objects may have reused the table since.
+		 */
+		i = next_field;
+		if (i >= descr_len || (decoded_fields & ((int64_t)1 << i)) ||
+		    !field_matches(&descr[i], &kv)) {
+			if (index->descr != descr || index->descr_len != descr_len) {
+				obj_index_init(index, descr, descr_len);
 			}
 
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
+			i = obj_index_lookup(index, descr, decoded_fields, &kv);
+			if (i == SIZE_MAX) {
+				/* Unknown or repeated key */
 				continue;
 			}
+		}
 
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
-			if (ret < 0) {
-				return ret;
-			}
-
-			decoded_fields |= (int64_t)1<<i;
-			break;
+		/* Store the decoded value */
+		ret = decode_value(obj, index, &descr[i], &kv.value,
+				   (char *)val + descr[i].offset, val);
+		if (ret < 0) {
+			return ret;
 		}
+
+		decoded_fields |= (int64_t)1 << i;
+		next_field = i + 1;
 	}
 
 	return -EINVAL;
@@ -670,6 +764,7 @@ int64_t json_obj_parse(char *payload, size_t len,
 		       const struct json_obj_descr *descr, size_t descr_len,
 		       void *val)
 {
+	struct obj_index index;
 	struct json_obj obj;
 	int64_t ret;
 
@@ -680,12 +775,15 @@ int64_t json_obj_parse(char *payload, size_t len,
 		return ret;
 	}
 
-	return obj_parse(&obj, descr, descr_len, val);
+	index.descr = NULL;
+
+	return obj_parse(&obj, &index, descr, descr_len, val);
 }
 
 int json_arr_parse(char *payload, size_t len,
 		   const struct json_obj_descr *descr, void *val)
 {
+	struct obj_index index;
 	struct json_obj arr;
 	int ret;
 
@@ -696,7 +794,9 @@ int json_arr_parse(char *payload, size_t len,
 
 	void *ptr = (char *)val + descr->offset;
 
-	return arr_parse(&arr, descr->array.element_descr,
+	index.descr = NULL;
+
+	return arr_parse(&arr, &index, descr->array.element_descr,
 			 descr->array.n_elements, ptr, val);
 }
 
@@ -709,6 +809,7 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 			  size_t descr_len, void *val)
 {
+	struct obj_index index;
 	struct json_token tok;
 
 	if (!lexer_next(&json->lex, &tok)) {
@@ -727,7 +828,135 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 		return -EINVAL;
 	}
 
-	return obj_parse(json, descr, descr_len, val);
+	index.descr = NULL;
+
+	return obj_parse(json, &index, descr, descr_len, val);
+}
+
+static bool is_structural(char chr)
+{
+	switch (chr) {
+	case '{':
+	case '}':
+	case '[':
+	case ']':
+	case ',':
+	case ':':
+		return true;
+	default:
+		return false;
+	}
+}
+
+int json_obj_buffered_init(struct json_obj_buffered *state, char *buf, size_t buf_size,
+			   const struct json_obj_descr *descr, size_t descr_len,
+			   void *val)
+{
+	if (buf == NULL || buf_size == 0U) {
+		return -EINVAL;
+	}
+
+	__ASSERT_NO_MSG(descr_len < (sizeof(int64_t) * CHAR_BIT - 1));
+
+	*state = (struct json_obj_buffered) {
+		.buf = buf,
+		.buf_size = buf_size,
+		.descr = descr,
+		.descr_len = descr_len,
+		.val = val,
+	};
+
+	return 0;
+}
+
+int64_t json_obj_buffered_feed(struct json_obj_buffered *state, const char *data,
+			       size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		char chr = data[i];
+
+		if (state->done) {
+			/* Only whitespace may follow the object */
+			if (isspace((unsigned char)chr) == 0) {
+				return -EINVAL;
+			}
+			continue;
+		}
+
+		if (!state->in_string && isspace((unsigned char)chr) != 0) {
+			state->space = (state->len > 0U);
+			continue;
+		}
+
+		if (state->depth == 0U && chr != '{') {
+			return -EINVAL;
+		}
+
+		/* Whitespace next to a structural character is insignificant
+		 * and not buffered, but between two other tokens, as in
+		 * "1 2", it parts them: keep one space there so that the
+		 * parser rejects them as it would without fragments.
+		 */
+		if (state->space) {
+			state->space = false;
+
+			if (!is_structural(state->buf[state->len - 1]) &&
+			    !is_structural(chr)) {
+				if (state->len == state->buf_size) {
+					return -ENOMEM;
+				}
+
+				state->buf[state->len++] = ' ';
+			}
+		}
+
+		if (state->len == state->buf_size) {
+			return -ENOMEM;
+		}
+
+		state->buf[state->len++] = chr;
+
+		if (state->in_string) {
+			if (state->escaped) {
+				state->escaped = false;
+			} else if (chr == '\\') {
+				state->escaped = true;
+			} else if (chr == '"') {
+				state->in_string = false;
+			}
+			continue;
+		}
+
+		switch (chr) {
+		case '"':
+			state->in_string = true;
+			break;
+		case '{':
+		case '[':
+			if (state->depth == UINT16_MAX) {
+				return -EINVAL;
+			}
+			state->depth++;
+			break;
+		case '}':
+		case ']':
+			if (--state->depth == 0U) {
+				/* The whole object is buffered: the
+				 * regular parser validates the structure.
+				 */
+				state->done = true;
+				state->result = json_obj_parse(state->buf, state->len,
+							       state->descr,
+							       state->descr_len,
+							       state->val);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	return state->done ? state->result : -EAGAIN;
 }
 
 static char escape_as(char chr)
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/mpmc_ring.h>
+
+/* Bounded MPMC queue after Dmitry Vyukov's design.  Each slot has a
+ * sequence number: a slot at index i is free for the producer at
+ * position pos when seq == pos, holds the message for the consumer at
+ * position pos when seq == pos + 1, and is handed back to the producer
+ * of the next lap by setting seq = pos + size.
+ *
+ * The sequence number is stored minus the slot index, which makes the
+ * all-zero state the valid initial one (seq[i] == i), so statically
+ * defined rings need no runtime initialization.
+ *
+ * Positions are free running and only compared through their signed
+ * difference, so wrapping the counters is harmless.
+ */
+
+static inline atomic_t *slot_seq(struct mpmc_ring *ring, unsigned long pos)
+{
+	return &ring->buf[(pos & ring->mask) * ring->slot_words];
+}
+
+static inline void *slot_data(atomic_t *seq)
+{
+	return seq + 1;
+}
+
+/* Sequence number of the slot for @a pos, relative to @a expected */
+static inline long seq_diff(struct mpmc_ring *ring, atomic_t *seq,
+			    unsigned long pos, unsigned long expected)
+{
+	unsigned long stored = (unsigned long)atomic_get(seq);
+
+	return (long)(stored + (pos & ring->mask) - expected);
+}
+
+static inline void seq_set(struct mpmc_ring *ring, atomic_t *seq,
+			   unsigned long pos, unsigned long val)
+{
+	(void)atomic_set(seq, (atomic_val_t)(val - (pos & ring->mask)));
+}
+
+int mpmc_ring_init(struct mpmc_ring *ring, atomic_t *buf, size_t msg_size,
+		   uint32_t num_msgs)
+{
+	if (msg_size == 0U || !IS_POWER_OF_TWO(num_msgs)) {
+		return -EINVAL;
+	}
+
+	*ring = (struct mpmc_ring)Z_MPMC_RING_INITIALIZER(buf, msg_size, num_msgs);
+	memset(buf, 0, MPMC_RING_BUF_WORDS(msg_size, num_msgs) * sizeof(atomic_t));
+
+	return 0;
+}
+
+int mpmc_ring_put(struct mpmc_ring *ring, const void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&ring->head);
+	atomic_t *seq;
+
+	while (true) {
+		long diff;
+
+		seq = slot_seq(ring, pos);
+		diff = seq_diff(ring, seq, pos, pos);
+
+		if (diff == 0) {
+			/* Slot free for this lap, try to claim it */
+			if (atomic_cas(&ring->head, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* Slot still holds last lap's message */
+			return -ENOSPC;
+		}
+
+		/* Lost the race to another producer */
+		pos = (unsigned long)atomic_get(&ring->head);
+	}
+
+	memcpy(slot_data(seq), data, ring->msg_size);
+	seq_set(ring, seq, pos, pos + 1);
+
+	return 0;
+}
+
+int mpmc_ring_get(struct mpmc_ring *ring, void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&ring->tail);
+	atomic_t *seq;
+
+	while (true) {
+		long diff;
+
+		seq = slot_seq(ring, pos);
+		diff = seq_diff(ring, seq, pos, pos + 1);
+
+		if (diff == 0) {
+			if (atomic_cas(&ring->tail, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* Nothing published in this slot yet */
+			return -EAGAIN;
+		}
+
+		pos = (unsigned long)atomic_get(&ring->tail);
+	}
+
+	memcpy(data, slot_data(seq), ring->msg_size);
+	seq_set(ring, seq, pos, pos + ring->mask + 1);
+
+	return 0;
+}
+
+#ifdef CONFIG_MULTITHREADING
+
+int mpmc_msgq_init(struct mpmc_msgq *msgq, atomic_t *buf, size_t msg_size,
+		   uint32_t num_msgs)
+{
+	int ret = mpmc_ring_init(&msgq->ring, buf, msg_size, num_msgs);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	atomic_clear(&msgq->get_waiters);
+	atomic_clear(&msgq->put_waiters);
+	(void)k_sem_init(&msgq->data_sem, 0, K_SEM_MAX_LIMIT);
+	(void)k_sem_init(&msgq->space_sem, 0, K_SEM_MAX_LIMIT);
+
+	return 0;
+}
+
+/* Only touch the scheduler if someone announced they are sleeping */
+static inline void wake_one(atomic_t *waiters, struct k_sem *sem)
+{
+	if (atomic_get(waiters) > 0) {
+		k_sem_give(sem);
+	}
+}
+
+/*
+ * Common slow path of put and get.  The waiter count is raised before
+ * the final attempt: the other side publishes its change to the ring
+ * before reading the count, so either that attempt sees the change or
+ * the other side sees the waiter and gives the semaphore.  Gives that
+ * end up unneeded only cause a spurious wakeup and another attempt.
+ */
+static int wait_for(struct mpmc_msgq *msgq, atomic_t *waiters, struct k_sem *sem,
+		    int (*attempt)(struct mpmc_ring *ring, void *data),
+		    void *data, k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+
+	while (true) {
+		k_timeout_t wait = timeout;
+		int ret;
+
+		(void)atomic_inc(waiters);
+
+		if (attempt(&msgq->ring, data) == 0) {
+			(void)atomic_dec(waiters);
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			wait = remaining > 0 ? K_TICKS(remaining) : K_NO_WAIT;
+		}
+
+		ret = k_sem_take(sem, wait);
+		(void)atomic_dec(waiters);
+
+		if (ret != 0) {
+			return -EAGAIN;
+		}
+
+		if (attempt(&msgq->ring, data) == 0) {
+			return 0;
+		}
+	}
+}
+
+static int ring_put(struct mpmc_ring *ring, void *data)
+{
+	return mpmc_ring_put(ring, data);
+}
+
+int mpmc_msgq_put(struct mpmc_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	__ASSERT(!k_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int ret = mpmc_ring_put(&msgq->ring, data);
+
+	if (ret != 0) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = wait_for(msgq, &msgq->put_waiters, &msgq->space_sem,
+			       ring_put, (void *)data, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	wake_one(&msgq->get_waiters, &msgq->data_sem);
+
+	return 0;
+}
+
+int mpmc_msgq_get(struct mpmc_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	__ASSERT(!k_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int ret = mpmc_ring_get(&msgq->ring, data);
+
+	if (ret != 0) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = wait_for(msgq, &msgq->get_waiters, &msgq->data_sem,
+			       mpmc_ring_get, data, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	wake_one(&msgq->put_waiters, &msgq->space_sem);
+
+	return 0;
+}
+
+#endif /* CONFIG_MULTITHREADING */
@@ -8,6 +8,9 @@
 #include <zephyr/wait_q.h>
 #include <zephyr/posix/sys/eventfd.h>
 #include <zephyr/net/socket.h>
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+#include <zephyr/net/socket_epoll.h>
+#endif
 #include <ksched.h>
 
 struct eventfd {
@@ -17,6 +20,9 @@ struct eventfd {
 	_wait_q_t wait_q;
 	eventfd_t cnt;
 	int flags;
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	sys_slist_t epoll_watchers;
+#endif
 };
 
 K_MUTEX_DEFINE(eventfd_mtx);
@@ -119,6 +125,10 @@ static ssize_t eventfd_read_op(void *obj, void *buf, size_t sz)
 		return -1;
 	}
 
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	zsock_epoll_notify(&efd->epoll_watchers);
+#endif
+
 	*(eventfd_t *)buf = count;
 
 	return sizeof(eventfd_t);
@@ -176,6 +186,10 @@ static ssize_t eventfd_write_op(void *obj, const void *buf, size_t sz)
 		return -1;
 	}
 
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	zsock_epoll_notify(&efd->epoll_watchers);
+#endif
+
 	return sizeof(eventfd_t);
 }
 
@@ -183,6 +197,10 @@ static int eventfd_close_op(void *obj)
 {
 	struct eventfd *efd = (struct eventfd *)obj;
 
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	zsock_epoll_detach(&efd->epoll_watchers);
+#endif
+
 	efd->flags = 0;
 
 	return 0;
@@ -233,6 +251,20 @@ static int eventfd_ioctl_op(void *obj, unsigned int request, va_list args)
 		return eventfd_poll_update(obj, pfd, pev);
 	}
 
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	case ZFD_IOCTL_EPOLL_WATCH: {
+		struct zsock_epoll_watch *watch;
+
+		watch = va_arg(args, struct zsock_epoll_watch *);
+		watch->watchers = &efd->epoll_watchers;
+		watch->polled = 0;
+		/* Not a kernel object, nothing to check for user threads */
+		watch->otype = K_OBJ_ANY;
+
+		return 0;
+	}
+#endif
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
@@ -282,6 +314,9 @@ int eventfd(unsigned int initval, int flags)
 	k_poll_signal_init(&efd->write_sig);
 	k_poll_signal_init(&efd->read_sig);
 	z_waitq_init(&efd->wait_q);
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	sys_slist_init(&efd->epoll_watchers);
+#endif
 
 	if (initval != 0) {
 		k_poll_signal_raise(&efd->read_sig, 0);
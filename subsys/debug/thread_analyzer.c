@@ -61,6 +61,15 @@ static void thread_print_cb(struct thread_analyzer_info *info)
 		info->usage.average_cycles);
 #endif
 #endif
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	THREAD_ANALYZER_PRINT(
+		THREAD_ANALYZER_FMT(
+			"      : Wakeups: %u; Longest latency: %u us; Average latency: %u us"),
+		info->wakeup.count, k_cyc_to_us_floor32(info->wakeup.longest),
+		(info->wakeup.count != 0U) ?
+		k_cyc_to_us_floor32(info->wakeup.total / info->wakeup.count) : 0U);
+#endif
 #else
 	THREAD_ANALYZER_PRINT(
 		THREAD_ANALYZER_FMT(
@@ -122,6 +131,10 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 		info.utilization = (info.usage.execution_cycles * 100U) /
 			rt_stats_all.execution_cycles;
 	}
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY
+	(void)k_thread_wakeup_stats_get(thread, &info.wakeup, false);
+#endif
 #endif
 	cb(&info);
 }
@@ -13,6 +13,8 @@
 #include <errno.h>
 #include <zephyr/device.h>
 
+#include "disk_cache.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -87,6 +89,12 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#if defined(CONFIG_DISK_CACHE)
+		if (disk->cache != NULL) {
+			return disk_cache_read(disk, data_buf, start_sector,
+					       num_sector);
+		}
+#endif
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
 	}
 
@@ -101,6 +109,12 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#if defined(CONFIG_DISK_CACHE)
+		if (disk->cache != NULL) {
+			return disk_cache_write(disk, data_buf, start_sector,
+						num_sector);
+		}
+#endif
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
 	}
 
@@ -114,6 +128,14 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+#if defined(CONFIG_DISK_CACHE)
+		if ((cmd == DISK_IOCTL_CTRL_SYNC) && (disk->cache != NULL)) {
+			rc = disk_cache_flush(disk);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+#endif
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -161,6 +183,11 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+#if defined(CONFIG_DISK_CACHE)
+	if ((disk->cache != NULL) && (disk_cache_flush(disk) != 0)) {
+		LOG_ERR("disk cache not flushed!!");
+	}
+#endif
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistered", disk->name);
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/disk_access.h>
+#include <errno.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+static uint8_t *entry_data(struct disk_cache *cache,
+			   struct disk_cache_entry *entry)
+{
+	return &cache->data[(entry - cache->entries) * cache->sector_size];
+}
+
+/* Entries not holding a sector are kept at the end of the list */
+static struct disk_cache_entry *cache_find(struct disk_cache *cache,
+					   uint32_t sector)
+{
+	struct disk_cache_entry *entry;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cache->lru, entry, node) {
+		if (!entry->valid) {
+			break;
+		}
+
+		if (entry->sector == sector) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_touch(struct disk_cache *cache,
+			struct disk_cache_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+	sys_dlist_prepend(&cache->lru, &entry->node);
+}
+
+static void cache_invalidate(struct disk_cache *cache,
+			     struct disk_cache_entry *entry)
+{
+	entry->valid = false;
+	entry->dirty = false;
+	sys_dlist_remove(&entry->node);
+	sys_dlist_append(&cache->lru, &entry->node);
+}
+
+static int entry_write_back(struct disk_info *disk, struct disk_cache *cache,
+			    struct disk_cache_entry *entry)
+{
+	int rc;
+
+	if (!entry->dirty) {
+		return 0;
+	}
+
+	rc = disk->ops->write(disk, entry_data(cache, entry), entry->sector, 1);
+	if (rc != 0) {
+		LOG_ERR("Cannot write back sector %u (%d)", entry->sector, rc);
+		return rc;
+	}
+
+	entry->dirty = false;
+	cache->stats.write_backs++;
+
+	return 0;
+}
+
+/* Least recently used entry, written back and emptied for sector */
+static int cache_evict(struct disk_info *disk, struct disk_cache *cache,
+		       uint32_t sector, struct disk_cache_entry **evicted)
+{
+	struct disk_cache_entry *entry;
+	int rc;
+
+	entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru),
+			     struct disk_cache_entry, node);
+
+	rc = entry_write_back(disk, cache, entry);
+	if (rc != 0) {
+		return rc;
+	}
+
+	entry->sector = sector;
+	entry->valid = false;
+	*evicted = entry;
+
+	return 0;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache *cache = disk->cache;
+	struct disk_cache_entry *entry;
+	int rc = 0;
+
+	k_mutex_lock(&cache->lock, K_FOREVER);
+
+	if (num_sector != 1U) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		if (rc != 0) {
+			goto out;
+		}
+
+		/* Sectors written to the cache only are newer */
+		SYS_DLIST_FOR_EACH_CONTAINER(&cache->lru, entry, node) {
+			if (entry->dirty && entry->sector >= start_sector &&
+			    entry->sector - start_sector < num_sector) {
+				memcpy(&data_buf[(entry->sector - start_sector) *
+						 cache->sector_size],
+				       entry_data(cache, entry),
+				       cache->sector_size);
+			}
+		}
+
+		goto out;
+	}
+
+	entry = cache_find(cache, start_sector);
+	if (entry != NULL) {
+		cache->stats.hits++;
+	} else {
+		rc = cache_evict(disk, cache, start_sector, &entry);
+		if (rc != 0) {
+			goto out;
+		}
+
+		rc = disk->ops->read(disk, entry_data(cache, entry),
+				     start_sector, 1);
+		if (rc != 0) {
+			cache_invalidate(cache, entry);
+			goto out;
+		}
+
+		entry->valid = true;
+		cache->stats.misses++;
+	}
+
+	memcpy(data_buf, entry_data(cache, entry), cache->sector_size);
+	cache_touch(cache, entry);
+
+out:
+	k_mutex_unlock(&cache->lock);
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache *cache = disk->cache;
+	struct disk_cache_entry *entry;
+	int rc = 0;
+
+	k_mutex_lock(&cache->lock, K_FOREVER);
+
+	if (num_sector != 1U) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (rc != 0) {
+			goto out;
+		}
+
+		/* The disk now holds the newest data of these sectors */
+		SYS_DLIST_FOR_EACH_CONTAINER(&cache->lru, entry, node) {
+			if (entry->valid && entry->sector >= start_sector &&
+			    entry->sector - start_sector < num_sector) {
+				memcpy(entry_data(cache, entry),
+				       &data_buf[(entry->sector - start_sector) *
+						 cache->sector_size],
+				       cache->sector_size);
+				entry->dirty = false;
+			}
+		}
+
+		goto out;
+	}
+
+	entry = cache_find(cache, start_sector);
+	if (entry == NULL) {
+		rc = cache_evict(disk, cache, start_sector, &entry);
+		if (rc != 0) {
+			goto out;
+		}
+	}
+
+	memcpy(entry_data(cache, entry), data_buf, cache->sector_size);
+	entry->valid = true;
+
+	if (cache->flags & DISK_CACHE_WRITE_BACK) {
+		entry->dirty = true;
+	} else {
+		rc = disk->ops->write(disk, data_buf, start_sector, 1);
+		if (rc != 0) {
+			cache_invalidate(cache, entry);
+			goto out;
+		}
+	}
+
+	cache_touch(cache, entry);
+
+out:
+	k_mutex_unlock(&cache->lock);
+	return rc;
+}
+
+int disk_cache_flush(struct disk_info *disk)
+{
+	struct disk_cache *cache = disk->cache;
+	struct disk_cache_entry *entry;
+	int rc = 0;
+
+	k_mutex_lock(&cache->lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cache->lru, entry, node) {
+		rc = entry_write_back(disk, cache, entry);
+		if (rc != 0) {
+			break;
+		}
+	}
+
+	k_mutex_unlock(&cache->lock);
+	return rc;
+}
+
+int disk_access_cache_attach(const char *pdrv, struct disk_cache *cache,
+			     uint32_t flags)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+	uint32_t sector_size;
+	int rc;
+
+	if ((disk == NULL) || (disk->ops == NULL) ||
+	    (disk->ops->read == NULL) || (disk->ops->ioctl == NULL)) {
+		return -EINVAL;
+	}
+
+	if (cache != NULL) {
+		rc = disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE,
+				      &sector_size);
+		if ((rc != 0) || (sector_size != cache->sector_size)) {
+			LOG_ERR("Disk %s sectors do not fit cache", pdrv);
+			return -EINVAL;
+		}
+
+		if ((flags & DISK_CACHE_WRITE_BACK) &&
+		    (disk->ops->write == NULL)) {
+			return -EINVAL;
+		}
+	}
+
+	if (disk->cache != NULL) {
+		rc = disk_cache_flush(disk);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	if (cache != NULL) {
+		k_mutex_init(&cache->lock);
+		sys_dlist_init(&cache->lru);
+		memset(&cache->stats, 0, sizeof(cache->stats));
+		cache->flags = flags;
+
+		for (uint32_t i = 0; i < cache->count; i++) {
+			cache->entries[i].valid = false;
+			cache->entries[i].dirty = false;
+			sys_dlist_append(&cache->lru, &cache->entries[i].node);
+		}
+	}
+
+	disk->cache = cache;
+
+	return 0;
+}
+
+int disk_access_cache_flush(const char *pdrv)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+
+	if ((disk == NULL) || (disk->cache == NULL)) {
+		return -EINVAL;
+	}
+
+	return disk_cache_flush(disk);
+}
+
+int disk_access_cache_stats(const char *pdrv, struct disk_cache_stats *stats)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+
+	if ((disk == NULL) || (disk->cache == NULL)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&disk->cache->lock, K_FOREVER);
+	*stats = disk->cache->stats;
+	k_mutex_unlock(&disk->cache->lock);
+
+	return 0;
+}
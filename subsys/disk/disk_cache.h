@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <zephyr/drivers/disk.h>
+
+struct disk_info *disk_access_get_di(const char *name);
+
+/* Same as the disk_access_* functions, for a disk with a cache attached */
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write the dirty sectors of the cache of the disk to the disk */
+int disk_cache_flush(struct disk_info *disk);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
@@ -579,23 +579,28 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
+ *
+ * nvs_gc_begin finds the ate's of the sector to gc: gc_addr is set to the most
+ * recent ate and stop_addr to the oldest one. Returns 1 if there are ate's to
+ * move, 0 if the sector is not closed.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_begin(struct nvs_fs *fs, uint32_t *gc_addr,
+			uint32_t *stop_addr)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
+	uint32_t sec_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
 	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	*gc_addr = sec_addr + fs->sector_size - ate_size;
+	*stop_addr = *gc_addr - ate_size;
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_flash_ate_rd(fs, *gc_addr, &close_ate);
 	if (rc < 0) {
 		/* flash error */
 		return rc;
@@ -603,84 +608,100 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
 	if (!rc) {
-		goto gc_done;
+		return 0;
 	}
 
-	stop_addr = gc_addr - ate_size;
-
 	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
+		*gc_addr &= ADDR_SECT_MASK;
+		*gc_addr += close_ate.offset;
 	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
+		rc = nvs_recover_last_ate(fs, gc_addr);
 		if (rc) {
 			return rc;
 		}
 	}
 
-	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
-		if (rc) {
-			return rc;
-		}
+	return 1;
+}
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
-			continue;
-		}
+/* move the ate at gc_addr and its data to the write sector if it is the most
+ * recent ate of its id, and update gc_addr to the previous ate. Returns 1 if
+ * there are more ate's to move, 0 if the one at stop_addr was moved.
+ */
+static int nvs_gc_move(struct nvs_fs *fs, uint32_t *gc_addr, uint32_t stop_addr)
+{
+	int rc;
+	struct nvs_ate gc_ate, wlk_ate;
+	uint32_t gc_prev_addr, wlk_addr, wlk_prev_addr, data_addr;
+
+	gc_prev_addr = *gc_addr;
+	rc = nvs_prev_ate(fs, gc_addr, &gc_ate);
+	if (rc) {
+		return rc;
+	}
+
+	if (!nvs_ate_valid(fs, &gc_ate)) {
+		return gc_prev_addr != stop_addr;
+	}
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
 
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
 #endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
-
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
 		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+		if ((wlk_ate.id == gc_ate.id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		/* copy needed */
+		LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
 
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+		data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+		data_addr += gc_ate.offset;
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
+		gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+		nvs_ate_crc8_update(&gc_ate);
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
+		rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
+		if (rc) {
+			return rc;
 		}
-	} while (gc_prev_addr != stop_addr);
 
-gc_done:
+		rc = nvs_flash_ate_wrt(fs, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return gc_prev_addr != stop_addr;
+}
+
+static int nvs_gc_done(struct nvs_fs *fs)
+{
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	/* Make it possible to detect that gc has finished by writing a
 	 * gc done ate to the sector. In the field we might have nvs systems
@@ -689,20 +710,166 @@ gc_done:
 	 */
 
 	if (fs->ate_wra >= (fs->data_wra + ate_size)) {
-		rc = nvs_add_gc_done_ate(fs);
-		if (rc) {
-			return rc;
-		}
+		return nvs_add_gc_done_ate(fs);
+	}
+
+	return 0;
+}
+
+/* Erase the gc'ed sector, the one after the write sector */
+static int nvs_gc_erase(struct nvs_fs *fs)
+{
+	uint32_t sec_addr;
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+
+	return nvs_flash_erase_sector(fs, sec_addr);
+}
+
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t gc_addr, stop_addr;
+
+	rc = nvs_gc_begin(fs, &gc_addr, &stop_addr);
+	while (rc > 0) {
+		rc = nvs_gc_move(fs, &gc_addr, stop_addr);
+	}
+	if (rc) {
+		return rc;
+	}
+
+	rc = nvs_gc_done(fs);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_gc_erase(fs);
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* Finish moving the ate's of an incremental gc. The write sector cannot be
+ * written before, as entries written between the moved ones would be lost
+ * when an interrupted gc is restarted by nvs_startup().
+ */
+static int nvs_gc_incr_finish_moves(struct nvs_fs *fs)
+{
+	int rc = 1;
+
+	if (fs->gc_state != NVS_GC_MOVE) {
+		return 0;
+	}
+
+	while (rc > 0) {
+		rc = nvs_gc_move(fs, &fs->gc_addr, fs->gc_stop_addr);
+	}
+	if (rc) {
+		return rc;
+	}
+
+	rc = nvs_gc_done(fs);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc_state = NVS_GC_ERASE;
+
+	return 0;
+}
+
+/* Start an incremental gc when the free space of the write sector is below
+ * the watermark and entries were written since the previous gc.
+ */
+static int nvs_gc_incr_start(struct nvs_fs *fs)
+{
+	int rc;
+
+	if (!fs->gc_dirty ||
+	    (fs->ate_wra - fs->data_wra) * 100U >=
+	    (uint32_t)fs->sector_size * CONFIG_NVS_GC_WATERMARK) {
+		return 0;
 	}
 
-	/* Erase the gc'ed sector */
-	rc = nvs_flash_erase_sector(fs, sec_addr);
+	LOG_DBG("Starting incremental gc, %u bytes free",
+		fs->ate_wra - fs->data_wra);
+
+	rc = nvs_sector_close(fs);
 	if (rc) {
 		return rc;
 	}
+
+	fs->gc_dirty = false;
+
+	rc = nvs_gc_begin(fs, &fs->gc_addr, &fs->gc_stop_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (rc) {
+		fs->gc_state = NVS_GC_MOVE;
+		return 0;
+	}
+
+	rc = nvs_gc_done(fs);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc_state = NVS_GC_ERASE;
+
 	return 0;
 }
 
+int nvs_gc_step(struct nvs_fs *fs)
+{
+	int rc = 1;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	switch (fs->gc_state) {
+	case NVS_GC_IDLE:
+		rc = nvs_gc_incr_start(fs);
+		break;
+	case NVS_GC_MOVE:
+		for (int i = 0; (i < CONFIG_NVS_GC_STEP_ATES) && (rc > 0); i++) {
+			rc = nvs_gc_move(fs, &fs->gc_addr, fs->gc_stop_addr);
+		}
+		if (rc > 0) {
+			rc = 0;
+			break;
+		}
+		if (rc) {
+			break;
+		}
+
+		rc = nvs_gc_done(fs);
+		if (!rc) {
+			fs->gc_state = NVS_GC_ERASE;
+		}
+		break;
+	case NVS_GC_ERASE:
+		rc = nvs_gc_erase(fs);
+		if (!rc) {
+			fs->gc_state = NVS_GC_IDLE;
+		}
+		break;
+	}
+
+	if (!rc) {
+		rc = (fs->gc_state != NVS_GC_IDLE);
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+#endif /* CONFIG_NVS_GC_INCREMENTAL */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -718,6 +885,11 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc_state = NVS_GC_IDLE;
+	fs->gc_dirty = false;
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -1100,6 +1272,13 @@ no_cached_entry:
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	rc = nvs_gc_incr_finish_moves(fs);
+	if (rc) {
+		goto end;
+	}
+#endif
+
 	gc_count = 0;
 	while (1) {
 		if (gc_count == fs->sector_count) {
@@ -1116,9 +1295,22 @@ no_cached_entry:
 			if (rc) {
 				goto end;
 			}
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+			fs->gc_dirty = true;
+#endif
 			break;
 		}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		/* out of space before the incremental gc erased its sector */
+		if (fs->gc_state == NVS_GC_ERASE) {
+			rc = nvs_gc_erase(fs);
+			if (rc) {
+				goto end;
+			}
+			fs->gc_state = NVS_GC_IDLE;
+		}
+#endif
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
@@ -1216,6 +1408,84 @@ ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
 	return rc;
 }
 
+int nvs_foreach(struct nvs_fs *fs, nvs_foreach_cb_t cb, void *arg)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	struct nvs_entry entry;
+	uint32_t wlk_addr;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	wlk_addr = fs->ate_wra;
+
+	while (1) {
+		entry.ate_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+
+		/* skip the gc done ate's */
+		if (nvs_ate_valid(fs, &wlk_ate) &&
+		    ((wlk_ate.id != 0xFFFF) || wlk_ate.len)) {
+			entry.id = wlk_ate.id;
+			entry.len = wlk_ate.len;
+
+			rc = cb(fs, &entry, arg);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		if (wlk_addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+ssize_t nvs_entry_read(struct nvs_fs *fs, const struct nvs_entry *entry,
+		       void *data, size_t len)
+{
+	int rc;
+	struct nvs_ate ate;
+	uint32_t rd_addr;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	rc = nvs_flash_ate_rd(fs, entry->ate_addr, &ate);
+	if (rc) {
+		return rc;
+	}
+
+	/* the sector was gc'ed since the entry was found */
+	if (!nvs_ate_valid(fs, &ate) || (ate.id != entry->id) ||
+	    (ate.len != entry->len)) {
+		return nvs_read(fs, entry->id, data, len);
+	}
+
+	if (ate.len == 0U) {
+		return -ENOENT;
+	}
+
+	rd_addr = entry->ate_addr & ADDR_SECT_MASK;
+	rd_addr += ate.offset;
+	rc = nvs_flash_rd(fs, rd_addr, data, MIN(len, ate.len));
+	if (rc) {
+		return rc;
+	}
+
+	return ate.len;
+}
+
 ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 {
 
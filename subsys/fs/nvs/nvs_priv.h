@@ -30,6 +30,13 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/*
+ * Incremental gc states
+ */
+#define NVS_GC_IDLE 0	/* the sector after the write sector is erased */
+#define NVS_GC_MOVE 1	/* ate's are moved to the write sector */
+#define NVS_GC_ERASE 2	/* the sector after the write sector can be erased */
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
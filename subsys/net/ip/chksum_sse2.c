@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief Internet checksum summation with SSE2
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#if !defined(__SSE2__)
+#error "CONFIG_NET_IP_CHKSUM_SSE2 needs a compiler generating SSE2 code"
+#endif
+
+#include <emmintrin.h>
+
+#include "net_private.h"
+
+/* Each 32-bit word is widened to a 64-bit lane before it is added, so the
+ * lanes cannot overflow and no carries need to be tracked.
+ */
+static inline __m128i chksum_add(__m128i sum, __m128i v, int high)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	return _mm_add_epi64(sum, high ? _mm_unpackhi_epi32(v, zero) :
+				     _mm_unpacklo_epi32(v, zero));
+}
+
+uint64_t net_chksum_words_sse2(const uint32_t *data, size_t len)
+{
+	__m128i sum_a = _mm_setzero_si128();
+	__m128i sum_b = _mm_setzero_si128();
+	__m128i sum_c = _mm_setzero_si128();
+	__m128i sum_d = _mm_setzero_si128();
+	uint64_t lanes[2];
+	uint64_t sum;
+
+	/* Four accumulators, so that the additions can run in parallel */
+	while (len >= sizeof(__m128i) * 2) {
+		__m128i v = _mm_loadu_si128((const __m128i *)data);
+		__m128i w = _mm_loadu_si128((const __m128i *)data + 1);
+
+		sum_a = chksum_add(sum_a, v, 0);
+		sum_b = chksum_add(sum_b, v, 1);
+		sum_c = chksum_add(sum_c, w, 0);
+		sum_d = chksum_add(sum_d, w, 1);
+		data += sizeof(__m128i) * 2 / sizeof(uint32_t);
+		len -= sizeof(__m128i) * 2;
+	}
+
+	if (len >= sizeof(__m128i)) {
+		__m128i v = _mm_loadu_si128((const __m128i *)data);
+
+		sum_a = chksum_add(sum_a, v, 0);
+		sum_b = chksum_add(sum_b, v, 1);
+		data += sizeof(__m128i) / sizeof(uint32_t);
+		len -= sizeof(__m128i);
+	}
+
+	sum_a = _mm_add_epi64(_mm_add_epi64(sum_a, sum_b),
+			      _mm_add_epi64(sum_c, sum_d));
+	_mm_storeu_si128((__m128i *)lanes, sum_a);
+	sum = lanes[0] + lanes[1];
+
+	while (len >= sizeof(uint32_t)) {
+		sum += *data++;
+		len -= sizeof(uint32_t);
+	}
+
+	return sum;
+}
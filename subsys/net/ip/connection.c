@@ -18,6 +18,9 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/sys_heap.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
@@ -116,6 +119,223 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+/* Connections to check for a packet or a new registration.  Without the
+ * hash index, or when it can't be used, this is all of conn_used.
+ */
+struct conn_candidates {
+	bool indexed;
+#if defined(CONFIG_NET_CONN_HASH)
+	struct net_conn *chains[3];
+#endif
+};
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* UDP and TCP connections bound to a local port are filed in a hash
+ * table, by protocol, family and local port, and connected ones by the
+ * hash of their whole 4-tuple instead.  The table maps each key to a
+ * chain of connections linked through demux_next.  All other
+ * connections, and any that could not be filed, are on the wildcard
+ * chain.  Every chain is kept newest first, so merging the chains that a
+ * packet can match gives its candidates in the order of conn_used and
+ * the precedence between them is unchanged.
+ */
+#define CONN_KEY_TUPLE BIT64(63)
+
+/* Worst case for the separate chaining table: an entry per connection,
+ * and both the old and the new bucket array while it grows.
+ */
+#define CONN_HASH_HEAP_SIZE \
+	(CONFIG_NET_MAX_CONN * (48 + 6 * sizeof(sys_dlist_t)) + 256)
+
+static uint8_t conn_hash_heap_mem[CONN_HASH_HEAP_SIZE] __aligned(8);
+static struct sys_heap conn_hash_heap;
+
+static void *conn_hash_alloc(void *ptr, size_t new_size)
+{
+	return sys_heap_realloc(&conn_hash_heap, ptr, new_size);
+}
+
+SYS_HASHMAP_SC_DEFINE_STATIC_ADVANCED(conn_hash, sys_hash32, conn_hash_alloc,
+				      SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONN,
+							 SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+static struct net_conn *conn_wildcard;
+static uint32_t conn_seq;
+
+/* Ports are in network byte order.  @a remote_addr is the raw remote
+ * address, or NULL if none is specified.  Returns false for connections
+ * that belong on the wildcard chain.
+ */
+static bool conn_demux_key(uint16_t proto, uint8_t family,
+			   const uint8_t *remote_addr, uint16_t remote_port,
+			   uint16_t local_port, uint64_t *key)
+{
+	uint8_t tuple[sizeof(struct in6_addr) + sizeof(uint16_t) + 2];
+	size_t len;
+
+	if ((family != AF_INET && family != AF_INET6) ||
+	    (proto != IPPROTO_UDP && proto != IPPROTO_TCP) ||
+	    local_port == 0U) {
+		return false;
+	}
+
+	if (remote_addr == NULL || remote_port == 0U) {
+		*key = ((uint64_t)proto << 32) | ((uint64_t)family << 16) |
+		       local_port;
+		return true;
+	}
+
+	len = family == AF_INET6 ? sizeof(struct in6_addr) :
+				   sizeof(struct in_addr);
+	memcpy(tuple, remote_addr, len);
+	memcpy(&tuple[len], &remote_port, sizeof(remote_port));
+	len += sizeof(remote_port);
+	tuple[len++] = proto;
+	tuple[len++] = family;
+
+	*key = CONN_KEY_TUPLE | ((uint64_t)local_port << 32) |
+	       sys_hash32(tuple, len);
+
+	return true;
+}
+
+/* Raw address of @a addr if it is a specified IPv4 or IPv6 address */
+static const uint8_t *conn_addr_spec(const struct sockaddr *addr)
+{
+	if (addr == NULL) {
+		return NULL;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6 &&
+	    !net_ipv6_is_addr_unspecified(&net_sin6(addr)->sin6_addr)) {
+		return (const uint8_t *)&net_sin6(addr)->sin6_addr;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && addr->sa_family == AF_INET &&
+	    net_sin(addr)->sin_addr.s_addr != 0U) {
+		return (const uint8_t *)&net_sin(addr)->sin_addr;
+	}
+
+	return NULL;
+}
+
+static bool conn_key(struct net_conn *conn, uint64_t *key)
+{
+	return conn_demux_key(conn->proto, conn->family,
+			      (conn->flags & NET_CONN_REMOTE_ADDR_SPEC) ?
+			      conn_addr_spec(&conn->remote_addr) : NULL,
+			      net_sin(&conn->remote_addr)->sin_port,
+			      net_sin(&conn->local_addr)->sin_port, key);
+}
+
+static struct net_conn *conn_chain_get(uint64_t key)
+{
+	uint64_t head;
+
+	if (!sys_hashmap_get(&conn_hash, key, &head)) {
+		return NULL;
+	}
+
+	return (struct net_conn *)(uintptr_t)head;
+}
+
+/* Called with conn_lock held */
+static void conn_demux_add(struct net_conn *conn)
+{
+	uint64_t key;
+
+	conn->seq = ++conn_seq;
+
+	if (conn_key(conn, &key)) {
+		conn->demux_next = conn_chain_get(key);
+		if (sys_hashmap_insert(&conn_hash, key, (uintptr_t)conn,
+				       NULL) >= 0) {
+			return;
+		}
+
+		NET_DBG("[%p] cannot hash connection, using wildcard chain",
+			conn);
+	}
+
+	conn->demux_next = conn_wildcard;
+	conn_wildcard = conn;
+}
+
+/* Called with conn_lock held */
+static void conn_demux_remove(struct net_conn *conn)
+{
+	struct net_conn *head = NULL;
+	struct net_conn **prev;
+	uint64_t key;
+	bool hashed;
+
+	hashed = conn_key(conn, &key);
+	if (hashed) {
+		head = conn_chain_get(key);
+	}
+
+	for (prev = &head; *prev != NULL; prev = &(*prev)->demux_next) {
+		if (*prev == conn) {
+			*prev = conn->demux_next;
+
+			if (head == NULL) {
+				(void)sys_hashmap_remove(&conn_hash, key, NULL);
+			} else {
+				(void)sys_hashmap_insert(&conn_hash, key,
+							 (uintptr_t)head, NULL);
+			}
+
+			return;
+		}
+	}
+
+	for (prev = &conn_wildcard; *prev != NULL;
+	     prev = &(*prev)->demux_next) {
+		if (*prev == conn) {
+			*prev = conn->demux_next;
+			return;
+		}
+	}
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
+static struct net_conn *conn_next_candidate(struct conn_candidates *cand,
+					    struct net_conn *conn)
+{
+#if defined(CONFIG_NET_CONN_HASH)
+	if (cand->indexed) {
+		struct net_conn **newest = NULL;
+
+		for (int i = 0; i < ARRAY_SIZE(cand->chains); i++) {
+			if (cand->chains[i] != NULL &&
+			    (newest == NULL ||
+			     (int32_t)(cand->chains[i]->seq - (*newest)->seq) > 0)) {
+				newest = &cand->chains[i];
+			}
+		}
+
+		if (newest == NULL) {
+			return NULL;
+		}
+
+		conn = *newest;
+		*newest = conn->demux_next;
+
+		return conn;
+	}
+#endif
+
+	if (conn == NULL) {
+		return SYS_SLIST_PEEK_HEAD_CONTAINER(&conn_used, conn, node);
+	}
+
+	return SYS_SLIST_PEEK_NEXT_CONTAINER(conn, node);
+}
+
+#define CONN_FOR_EACH_CANDIDATE(_cand, _conn)				\
+	for (_conn = conn_next_candidate(_cand, NULL); _conn != NULL;	\
+	     _conn = conn_next_candidate(_cand, _conn))
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +361,9 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+#if defined(CONFIG_NET_CONN_HASH)
+	conn_demux_add(conn);
+#endif
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -160,12 +383,24 @@ static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
 					  uint16_t remote_port,
 					  uint16_t local_port)
 {
+	struct conn_candidates cand = { 0 };
 	struct net_conn *conn;
-	struct net_conn *tmp;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+#if defined(CONFIG_NET_CONN_HASH)
+	uint64_t key;
+
+	/* An identical handler has the same key */
+	if (conn_demux_key(proto, family, conn_addr_spec(remote_addr),
+			   htons(remote_port), htons(local_port), &key)) {
+		cand.indexed = true;
+		cand.chains[0] = conn_chain_get(key);
+		cand.chains[1] = conn_wildcard;
+	}
+#endif
+
+	CONN_FOR_EACH_CANDIDATE(&cand, conn) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -397,6 +632,9 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+#if defined(CONFIG_NET_CONN_HASH)
+	conn_demux_remove(conn);
+#endif
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -616,6 +854,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
+	struct conn_candidates cand = { 0 };
 	struct net_conn *conn;
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
@@ -634,7 +873,41 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+#if defined(CONFIG_NET_CONN_HASH)
+	if (IS_ENABLED(CONFIG_NET_IP) &&
+	    (pkt_family == AF_INET || pkt_family == AF_INET6)) {
+		const uint8_t *src_addr = NULL;
+		uint64_t key;
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) && pkt_family == AF_INET) {
+			src_addr = ip_hdr->ipv4->src;
+		} else if (IS_ENABLED(CONFIG_NET_IPV6)) {
+			src_addr = ip_hdr->ipv6->src;
+		}
+
+		/* Only connections filed under the packet's 4-tuple or
+		 * destination port, or not filed at all, can match it.
+		 */
+		cand.indexed = true;
+
+		k_mutex_lock(&conn_lock, K_FOREVER);
+
+		if (conn_demux_key(proto, pkt_family, src_addr, src_port,
+				   dst_port, &key)) {
+			cand.chains[0] = conn_chain_get(key);
+		}
+
+		if (conn_demux_key(proto, pkt_family, NULL, 0, dst_port, &key)) {
+			cand.chains[1] = conn_chain_get(key);
+		}
+
+		cand.chains[2] = conn_wildcard;
+
+		k_mutex_unlock(&conn_lock);
+	}
+#endif
+
+	CONN_FOR_EACH_CANDIDATE(&cand, conn) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -857,6 +1130,11 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_heap_init(&conn_hash_heap, conn_hash_heap_mem,
+		      sizeof(conn_hash_heap_mem));
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -79,6 +79,14 @@ struct net_conn {
 
 	/** Flags for the connection */
 	uint8_t flags;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Next connection in the same lookup chain */
+	struct net_conn *demux_next;
+
+	/** Registration order, newer connections are checked first */
+	uint32_t seq;
+#endif
 };
 
 /**
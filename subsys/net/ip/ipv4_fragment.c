@@ -141,6 +141,8 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	struct net_ipv4_hdr *ipv4_hdr;
 	struct net_pkt *pkt;
 	struct net_buf *last;
+	uint8_t old_offset[2];
+	uint16_t old_len;
 	int i;
 
 	k_work_cancel_delayable(&reass->timer);
@@ -194,12 +196,18 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 		goto error;
 	}
 
+	old_len = ipv4_hdr->len;
+	memcpy(old_offset, ipv4_hdr->offset, sizeof(old_offset));
+
 	/* Fix the total length, offset and checksum of the IPv4 packet */
 	ipv4_hdr->len = htons(net_pkt_get_len(pkt));
 	ipv4_hdr->offset[0] = 0;
 	ipv4_hdr->offset[1] = 0;
-	ipv4_hdr->chksum = 0;
-	ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
+	ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum, old_len,
+					       ipv4_hdr->len);
+	ipv4_hdr->chksum = net_chksum_update(ipv4_hdr->chksum, old_offset,
+					     ipv4_hdr->offset,
+					     sizeof(old_offset));
 
 	net_pkt_set_data(pkt, &ipv4_access);
 
@@ -426,6 +434,9 @@ static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fi
 	struct net_pkt_cursor cur;
 	struct net_pkt_cursor cur_pkt;
 	uint16_t offset_pkt;
+	uint8_t old_id[2];
+	uint8_t old_offset[2];
+	uint16_t old_len;
 
 	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), fit_len +
 					     net_pkt_ip_hdr_len(pkt),
@@ -468,6 +479,10 @@ static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fi
 		return -ENOBUFS;
 	}
 
+	memcpy(old_id, ipv4_hdr->id, sizeof(old_id));
+	memcpy(old_offset, ipv4_hdr->offset, sizeof(old_offset));
+	old_len = ipv4_hdr->len;
+
 	memcpy(ipv4_hdr->id, &rand_id, sizeof(rand_id));
 	offset_pkt = frag_offset / 8;
 
@@ -478,9 +493,21 @@ static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fi
 	sys_put_be16(offset_pkt, ipv4_hdr->offset);
 	ipv4_hdr->len = htons((fit_len + net_pkt_ip_hdr_len(pkt)));
 
-	ipv4_hdr->chksum = 0;
+	/* The header was copied from the original packet, which has a
+	 * valid checksum already, so only account for what changed.
+	 */
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(frag_pkt))) {
-		ipv4_hdr->chksum = net_calc_chksum_ipv4(frag_pkt);
+		ipv4_hdr->chksum = net_chksum_update(ipv4_hdr->chksum, old_id,
+						     ipv4_hdr->id,
+						     sizeof(old_id));
+		ipv4_hdr->chksum = net_chksum_update(ipv4_hdr->chksum,
+						     old_offset,
+						     ipv4_hdr->offset,
+						     sizeof(old_offset));
+		ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum,
+						       old_len, ipv4_hdr->len);
+	} else {
+		ipv4_hdr->chksum = 0;
 	}
 
 	net_pkt_set_data(frag_pkt, &ipv4_access);
@@ -586,9 +613,10 @@ enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
 	}
 
 	/* If we have already fragmented the packet, the ID field will contain a non-zero value
-	 * and we can skip other checks.
+	 * and we can skip other checks. A large TCP packet is cut into segments
+	 * that fit the MTU instead.
 	 */
-	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0) {
+	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0 && net_pkt_gso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -784,9 +784,11 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. A large TCP
+	 * packet is cut into segments that fit the MTU instead.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U &&
+	    net_pkt_gso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -2313,6 +2315,15 @@ static inline bool handle_ra_route_info(struct net_pkt *pkt, uint8_t len)
 		return false;
 	}
 
+	/* RFC 4191, ch. 2.3, the prefix cannot be longer than the bits
+	 * carried by the option.
+	 */
+	if (prefix_len > 128 || prefix_len > prefix_field_len * 8) {
+		NET_DBG("Invalid %s prefix length (%d)", "route info opt",
+			prefix_len);
+		return true;
+	}
+
 	if (route_lifetime == 0) {
 		route = net_route_lookup(net_pkt_orig_iface(pkt), &prefix_buf);
 		if (route != NULL) {
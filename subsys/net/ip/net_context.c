@@ -1305,6 +1305,22 @@ static int get_context_dscp_ecn(struct net_context *context,
 #endif
 }
 
+static int get_context_recv_pktinfo(struct net_context *context,
+				    void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
+	*((int *)value) = context->options.recv_pktinfo;
+
+	if (len) {
+		*len = sizeof(int);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -2363,6 +2379,22 @@ static int set_context_dscp_ecn(struct net_context *context,
 #endif
 }
 
+static int set_context_recv_pktinfo(struct net_context *context,
+				    const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
+	if (len != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	context->options.recv_pktinfo = *((int *)value) != 0;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -2402,6 +2434,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_DSCP_ECN:
 		ret = set_context_dscp_ecn(context, value, len);
 		break;
+	case NET_OPT_RECV_PKTINFO:
+		ret = set_context_recv_pktinfo(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2448,6 +2483,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_DSCP_ECN:
 		ret = get_context_dscp_ecn(context, value, len);
 		break;
+	case NET_OPT_RECV_PKTINFO:
+		ret = get_context_recv_pktinfo(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
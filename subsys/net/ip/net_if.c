@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -207,6 +208,25 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+/* Large TCP packets are cut into segments before the L2 sends them,
+ * unless the Ethernet driver does it in hardware.
+ */
+static bool need_tcp_segmentation(struct net_if *iface, struct net_pkt *pkt)
+{
+	if (net_pkt_gso_size(pkt) == 0U) {
+		return false;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TCP_SEG)) {
+		return false;
+	}
+#endif
+
+	return true;
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -261,7 +281,11 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (need_tcp_segmentation(iface, pkt)) {
+			status = net_tcp_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
 			uint32_t end_tick = k_cycle_get_32();
@@ -1828,7 +1828,7 @@ static inline void clone_pkt_cb(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 }
 #endif
 
-static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
+void net_pkt_copy_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
 	net_pkt_set_family(clone_pkt, net_pkt_family(pkt));
 	net_pkt_set_context(clone_pkt, net_pkt_context(pkt));
@@ -1844,6 +1844,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 	if (pkt->buffer && clone_pkt->buffer) {
 		memcpy(net_pkt_lladdr_src(clone_pkt), net_pkt_lladdr_src(pkt),
@@ -1918,7 +1919,7 @@ static struct net_pkt *net_pkt_clone_internal(struct net_pkt *pkt,
 	}
 	net_pkt_set_overwrite(clone_pkt, true);
 
-	clone_pkt_attributes(pkt, clone_pkt);
+	net_pkt_copy_attributes(pkt, clone_pkt);
 
 	net_pkt_cursor_init(clone_pkt);
 
@@ -1961,7 +1962,7 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 
 	net_pkt_frag_ref(buf);
 
-	clone_pkt_attributes(pkt, clone_pkt);
+	net_pkt_copy_attributes(pkt, clone_pkt);
 
 	net_pkt_cursor_restore(clone_pkt, &pkt->cursor);
 
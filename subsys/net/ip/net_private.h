@@ -153,6 +153,44 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+#if defined(CONFIG_NET_IP_CHKSUM_SSE2)
+/* Sum of the 32-bit words in the first len & ~3 bytes at the 4 byte
+ * aligned data, for calc_chksum()
+ */
+uint64_t net_chksum_words_sse2(const uint32_t *data, size_t len);
+#endif
+
+/**
+ * @brief Update an Internet checksum after some of the data it covers
+ *        has been rewritten, without summing all of the data again
+ *        (RFC 1624).
+ *
+ * @param chksum Checksum field as found in the packet
+ * @param old_data Data before it was changed
+ * @param new_data Data after it was changed
+ * @param len Length of the data, an even number of bytes starting at an
+ *        even offset from the beginning of the checksummed data
+ *
+ * @return New value of the checksum field
+ */
+extern uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+				  const void *new_data, size_t len);
+
+/**
+ * @brief Update an Internet checksum after a 16-bit field changed.
+ *
+ * @param chksum Checksum field as found in the packet
+ * @param old_val Field before it was changed, in network byte order
+ * @param new_val Field after it was changed, in network byte order
+ *
+ * @return New value of the checksum field
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	return net_chksum_update(chksum, &old_val, &new_val, sizeof(uint16_t));
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -264,6 +264,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_QBV,                  "IEEE 802.1Qbv (scheduled traffic)"),
 	EC(ETHERNET_QBU,                  "IEEE 802.1Qbu (frame preemption)"),
 	EC(ETHERNET_TXTIME,               "TXTIME"),
+	EC(ETHERNET_HW_TX_TCP_SEG,        "TCP segmentation offload"),
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
@@ -1187,6 +1188,25 @@ static void print_tc_rx_stats(const struct shell *sh, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+static void print_rx_queue_stats(const struct shell *sh, struct net_if *iface)
+{
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	int i;
+
+	PR("RX flow queue statistics:\n");
+	PR("Queue TC\tRecv pkts\tbytes\n");
+
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		PR("[%d]   %d\t%d\t\t%d\n", i, i / NET_RX_FLOW_QUEUES,
+		   GET_STAT(iface, rx_queue[i].pkts),
+		   GET_STAT(iface, rx_queue[i].bytes));
+	}
+#else
+	ARG_UNUSED(sh);
+	ARG_UNUSED(iface);
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+}
+
 static void print_net_pm_stats(const struct shell *sh, struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -1302,6 +1322,11 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	PR("TCP conn drop  %d\tconnrst\t%d\n",
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	PR("TCP fast recov %d\trto\t%d\n",
+	   GET_STAT(iface, tcp.fast_recovery),
+	   GET_STAT(iface, tcp.rto));
+#endif
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
 #endif
 
@@ -1311,6 +1336,7 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 
 	print_tc_tx_stats(sh, iface);
 	print_tc_rx_stats(sh, iface);
+	print_rx_queue_stats(sh, iface);
 
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
@@ -1504,6 +1530,21 @@ static void tcp_cb(struct tcp *conn, void *user_data)
 	(*count)++;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+static void tcp_cc_cb(struct tcp *conn, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+
+	if (conn->state != TCP_ESTABLISHED && conn->state != TCP_CLOSE_WAIT) {
+		return;
+	}
+
+	PR("%p %-10s %8u %8u %s\n", conn, conn->cc->name, conn->cwnd,
+	   conn->ssthresh, conn->in_recovery ? "recovery" : "");
+}
+#endif
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 static void tcp_sent_list_cb(struct tcp *conn, void *user_data)
 {
@@ -2062,6 +2103,12 @@ static int cmd_net_conn(const struct shell *sh, size_t argc, char *argv[])
 	if (count == 0) {
 		PR("No TCP connections\n");
 	} else {
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		PR("\nTCP        Congestion     Cwnd Ssthresh\n");
+
+		net_tcp_foreach(tcp_cc_cb, &user_data);
+#endif
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 		/* Print information about pending packets */
 		struct tcp_detail_info details;
@@ -258,6 +258,16 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.tcp.rexmit++);
 }
+
+static inline void net_stats_update_tcp_fast_recovery(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.fast_recovery++);
+}
+
+static inline void net_stats_update_tcp_rto(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.rto++);
+}
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
 #define net_stats_update_tcp_resent(iface, bytes)
@@ -273,6 +283,8 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_fast_recovery(iface)
+#define net_stats_update_tcp_rto(iface)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
@@ -595,6 +607,18 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 #endif /* CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING) && defined(CONFIG_NET_STATISTICS) \
+	&& defined(CONFIG_NET_NATIVE)
+static inline void net_stats_update_rx_queue(struct net_if *iface,
+					     uint8_t queue, size_t bytes)
+{
+	UPDATE_STAT(iface, stats.rx_queue[queue].pkts++);
+	UPDATE_STAT(iface, stats.rx_queue[queue].bytes += bytes);
+}
+#else
+#define net_stats_update_rx_queue(iface, queue, bytes)
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)	\
 	&& defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_NATIVE)
 static inline void net_stats_add_suspend_start_time(struct net_if *iface,
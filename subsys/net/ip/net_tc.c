@@ -8,28 +8,33 @@
 LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
 #include <string.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/dummy.h>
 
 #include "net_private.h"
 #include "net_stats.h"
+#include "ipv4.h"
 #include "net_tc_mapping.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
- * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * where y indicates the traffic class id. The value of y can be from 0 to 7,
+ * or up to 63 for the RX queues if flows are steered to several queues.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[yy]")
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +42,7 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_RX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -60,12 +65,152 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+#define FLOW_HASH_MUL 0x9e3779b1U
+
+static uint32_t flow_hash_add(uint32_t hash, uint32_t value)
+{
+	hash = (hash ^ value) * FLOW_HASH_MUL;
+
+	return hash ^ (hash >> 16);
+}
+
+static uint32_t flow_hash_addr(uint32_t hash, const uint8_t *addr, size_t len)
+{
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = flow_hash_add(hash, UNALIGNED_GET((uint32_t *)&addr[i]));
+	}
+
+	return hash;
+}
+
+/* Offset of the IP header in a received packet, or <0 if the packet is not
+ * IP or comes from a link layer whose header is not parsed here.
+ */
+static int rx_flow_ip_offset(struct net_if *iface, const uint8_t *hdr,
+			     size_t len)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		size_t off = sizeof(struct net_eth_hdr);
+		uint16_t type;
+
+		if (len < off) {
+			return -EINVAL;
+		}
+
+		type = sys_get_be16(&hdr[off - sizeof(uint16_t)]);
+		if (type == NET_ETH_PTYPE_VLAN) {
+			off = sizeof(struct net_eth_vlan_hdr);
+			if (len < off) {
+				return -EINVAL;
+			}
+
+			type = sys_get_be16(&hdr[off - sizeof(uint16_t)]);
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return -EINVAL;
+		}
+
+		return off;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return 0;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+	ARG_UNUSED(hdr);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+
+/* Hash the addresses, protocol and ports of a received packet, which still
+ * has its link layer header. Fragments and packets with IPv6 extension
+ * headers are hashed without the ports so that all the packets of a
+ * datagram land in the same queue. Returns 0 if the packet is not IP.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	uint8_t hdr[sizeof(struct net_eth_vlan_hdr) + NET_IPV4H_LEN +
+		    NET_IPV4_HDR_OPTNS_MAX_LEN + sizeof(uint32_t)];
+	const uint8_t *ports = NULL;
+	uint32_t hash = 0U;
+	size_t len;
+	size_t off;
+	uint8_t proto;
+	int ret;
+
+	len = net_buf_linearize(hdr, sizeof(hdr), pkt->buffer, 0, sizeof(hdr));
+
+	ret = rx_flow_ip_offset(net_pkt_iface(pkt), hdr, len);
+	if (ret < 0) {
+		return 0U;
+	}
+
+	off = ret;
+
+	if (len >= off + NET_IPV4H_LEN && (hdr[off] & 0xf0) == 0x40) {
+		size_t hdr_len = (hdr[off] & 0x0f) * 4U;
+
+		proto = hdr[off + offsetof(struct net_ipv4_hdr, proto)];
+		hash = flow_hash_addr(hash,
+				      &hdr[off + offsetof(struct net_ipv4_hdr, src)],
+				      2 * sizeof(struct in_addr));
+
+		/* Only unfragmented datagrams carry their ports */
+		if ((sys_get_be16(&hdr[off + offsetof(struct net_ipv4_hdr,
+						      offset)]) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) == 0U &&
+		    len >= off + hdr_len + sizeof(uint32_t)) {
+			ports = &hdr[off + hdr_len];
+		}
+	} else if (len >= off + NET_IPV6H_LEN && (hdr[off] & 0xf0) == 0x60) {
+		proto = hdr[off + offsetof(struct net_ipv6_hdr, nexthdr)];
+		hash = flow_hash_addr(hash,
+				      &hdr[off + offsetof(struct net_ipv6_hdr, src)],
+				      2 * sizeof(struct in6_addr));
+
+		if (len >= off + NET_IPV6H_LEN + sizeof(uint32_t)) {
+			ports = &hdr[off + NET_IPV6H_LEN];
+		}
+	} else {
+		return 0U;
+	}
+
+	if (ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP)) {
+		hash = flow_hash_add(hash, UNALIGNED_GET((uint32_t *)ports));
+	}
+
+	return flow_hash_add(hash, proto);
+}
+
+static uint8_t rx_flow_queue(uint8_t tc, struct net_pkt *pkt)
+{
+	uint8_t queue;
+
+	queue = tc * NET_RX_FLOW_QUEUES + rx_flow_hash(pkt) % NET_RX_FLOW_QUEUES;
+
+	net_stats_update_rx_queue(net_pkt_iface(pkt), queue,
+				  net_pkt_get_len(pkt));
+
+	return queue;
+}
+#else
+#define rx_flow_queue(tc, pkt) (tc)
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[rx_flow_queue(tc, pkt)].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -343,12 +488,13 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		/* The flow queues of a traffic class share its priority */
+		thread_priority = rx_tc2thread(i / NET_RX_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "icmpv6.h"
 #include "nbr.h"
 #include "route.h"
+#include "route_trie.h"
 
 #if !defined(NET_ROUTE_EXTRA_DATA_SIZE)
 #define NET_ROUTE_EXTRA_DATA_SIZE 0
@@ -36,7 +37,13 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
+
+/* The routes are looked up by prefix in a trie, each prefix needs at most
+ * two nodes.
+ */
+static struct net_route_trie route_trie;
+static struct net_route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -272,39 +279,30 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
+}
+
+static bool route_iface_match(sys_snode_t *entry, void *user_data)
+{
+	struct net_route_entry *route =
+		CONTAINER_OF(entry, struct net_route_entry, trie_node);
+
+	return user_data == NULL || route->iface == user_data;
 }
 
 struct net_route_entry *net_route_lookup(struct net_if *iface,
 					 struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
-	uint8_t longest_match = 0U;
-	int i;
+	struct net_route_entry *found = NULL;
+	sys_snode_t *entry;
 
 	k_mutex_lock(&lock, K_FOREVER);
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
-
-		if (!nbr->ref) {
-			continue;
-		}
-
-		if (iface && nbr->iface != iface) {
-			continue;
-		}
-
-		route = net_route_data(nbr);
-
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix(dst->s6_addr,
-				       route->addr.s6_addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
-		}
+	entry = net_route_trie_lookup(&route_trie, dst, route_iface_match,
+				      iface);
+	if (entry) {
+		found = CONTAINER_OF(entry, struct net_route_entry, trie_node);
 	}
 
 	if (found) {
@@ -317,6 +315,21 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 	return found;
 }
 
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	sys_snode_t *entry;
+
+	entry = net_route_trie_find(&route_trie, addr, prefix_len,
+				    route_iface_match, iface);
+	if (!entry) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct net_route_entry, trie_node);
+}
+
 static inline bool route_preference_is_lower(uint8_t old, uint8_t new)
 {
 	if (new == NET_ROUTE_PREFERENCE_RESERVED || (new & 0xfc) != 0) {
@@ -354,6 +367,11 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 		return NULL;
 	}
 
+	if (prefix_len > 128) {
+		NET_DBG("Invalid prefix length %u", prefix_len);
+		return NULL;
+	}
+
 	k_mutex_lock(&lock, K_FOREVER);
 
 	nbr_nexthop = net_ipv6_nbr_lookup(iface, nexthop);
@@ -370,7 +388,10 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	/* Only a route to the same prefix is replaced, a more specific
+	 * route can be added next to a shorter one covering it.
+	 */
+	route = route_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -402,9 +423,12 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		if (!last) {
+			NET_ERR("Neighbor route alloc failed!");
+			goto exit;
+		}
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -451,9 +475,18 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+	if (net_route_trie_add(&route_trie, addr, prefix_len,
+			       &route->trie_node) < 0) {
+		NET_ERR("No route lookup node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -595,7 +628,12 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+	(void)net_route_trie_del(&route_trie, &route->addr, route->prefix_len,
+				 &route->trie_node);
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -802,47 +840,69 @@ int net_route_foreach(net_route_cb_t cb, void *user_data)
 static
 struct net_route_entry_mcast route_mcast_entries[CONFIG_NET_MAX_MCAST_ROUTES];
 
-int net_route_mcast_forward_packet(struct net_pkt *pkt,
-				   const struct net_ipv6_hdr *hdr)
+/* The multicast routes are looked up by group prefix in a trie */
+static struct net_route_trie mcast_trie;
+static struct net_route_trie_node
+	mcast_trie_nodes[2 * CONFIG_NET_MAX_MCAST_ROUTES];
+
+struct mcast_forward_data {
+	struct net_pkt *pkt;
+	int ret;
+	int err;
+};
+
+static bool mcast_forward_cb(sys_snode_t *entry, void *user_data)
 {
-	int i, ret = 0, err = 0;
+	struct net_route_entry_mcast *route =
+		CONTAINER_OF(entry, struct net_route_entry_mcast, trie_node);
+	struct mcast_forward_data *data = user_data;
+	struct net_pkt *pkt = data->pkt;
+	struct net_pkt *pkt_cpy;
+
+	if (!net_if_flag_is_set(route->iface, NET_IF_FORWARD_MULTICASTS) ||
+	    (pkt->iface == route->iface)) {
+		return false;
+	}
 
-	for (i = 0; i < CONFIG_NET_MAX_MCAST_ROUTES; ++i) {
-		struct net_route_entry_mcast *route = &route_mcast_entries[i];
-		struct net_pkt *pkt_cpy = NULL;
+	pkt_cpy = net_pkt_shallow_clone(pkt, K_NO_WAIT);
 
-		if (!route->is_used) {
-			continue;
-		}
+	if (pkt_cpy == NULL) {
+		data->err--;
+		return false;
+	}
 
-		if (!net_if_flag_is_set(route->iface,
-					NET_IF_FORWARD_MULTICASTS) ||
-		    !net_ipv6_is_prefix(hdr->dst,
-					route->group.s6_addr,
-					route->prefix_len)         ||
-		    (pkt->iface == route->iface)) {
-			continue;
-		}
+	net_pkt_set_forwarding(pkt_cpy, true);
+	net_pkt_set_iface(pkt_cpy, route->iface);
 
-		pkt_cpy = net_pkt_shallow_clone(pkt, K_NO_WAIT);
+	if (net_send_data(pkt_cpy) >= 0) {
+		++data->ret;
+	} else {
+		net_pkt_unref(pkt_cpy);
+		--data->err;
+	}
 
-		if (pkt_cpy == NULL) {
-			err--;
-			continue;
-		}
+	return true;
+}
+
+int net_route_mcast_forward_packet(struct net_pkt *pkt,
+				   const struct net_ipv6_hdr *hdr)
+{
+	struct mcast_forward_data data = {
+		.pkt = pkt,
+	};
+	struct in6_addr dst;
 
-		net_pkt_set_forwarding(pkt_cpy, true);
-		net_pkt_set_iface(pkt_cpy, route->iface);
+	net_ipv6_addr_copy_raw((uint8_t *)&dst, hdr->dst);
 
-		if (net_send_data(pkt_cpy) >= 0) {
-			++ret;
-		} else {
-			net_pkt_unref(pkt_cpy);
-			--err;
-		}
-	}
+	k_mutex_lock(&lock, K_FOREVER);
+
+	/* Only the routes whose group prefix matches the destination */
+	(void)net_route_trie_foreach_match(&mcast_trie, &dst,
+					   mcast_forward_cb, &data);
 
-	return (err == 0) ? ret : err;
+	k_mutex_unlock(&lock);
+
+	return (data.err == 0) ? data.ret : data.err;
 }
 
 int net_route_mcast_foreach(net_route_mcast_cb_t cb,
@@ -876,6 +936,11 @@ struct net_route_entry_mcast *net_route_mcast_add(struct net_if *iface,
 {
 	int i;
 
+	if (prefix_len > 128) {
+		NET_DBG("Invalid prefix length %u", prefix_len);
+		return NULL;
+	}
+
 	k_mutex_lock(&lock, K_FOREVER);
 
 	if ((!net_if_flag_is_set(iface, NET_IF_FORWARD_MULTICASTS)) ||
@@ -894,6 +959,12 @@ struct net_route_entry_mcast *net_route_mcast_add(struct net_if *iface,
 
 			route->prefix_len = prefix_len;
 			route->iface = iface;
+
+			if (net_route_trie_add(&mcast_trie, group, prefix_len,
+					       &route->trie_node) < 0) {
+				break;
+			}
+
 			route->is_used = true;
 
 			k_mutex_unlock(&lock);
@@ -916,31 +987,35 @@ bool net_route_mcast_del(struct net_route_entry_mcast *route)
 		   "Multicast route %p to %s was already removed", route,
 		   net_sprint_ipv6_addr(&route->group));
 
+	k_mutex_lock(&lock, K_FOREVER);
+
+	(void)net_route_trie_del(&mcast_trie, &route->group, route->prefix_len,
+				 &route->trie_node);
+
 	route->is_used = false;
 
+	k_mutex_unlock(&lock);
+
 	return true;
 }
 
 struct net_route_entry_mcast *
 net_route_mcast_lookup(struct in6_addr *group)
 {
-	int i;
-
-	for (i = 0; i < CONFIG_NET_MAX_MCAST_ROUTES; i++) {
-		struct net_route_entry_mcast *route = &route_mcast_entries[i];
+	struct net_route_entry_mcast *route = NULL;
+	sys_snode_t *entry;
 
-		if (!route->is_used) {
-			continue;
-		}
+	k_mutex_lock(&lock, K_FOREVER);
 
-		if (net_ipv6_is_prefix(group->s6_addr,
-					route->group.s6_addr,
-					route->prefix_len)) {
-			return route;
-		}
+	entry = net_route_trie_lookup(&mcast_trie, group, NULL, NULL);
+	if (entry) {
+		route = CONTAINER_OF(entry, struct net_route_entry_mcast,
+				     trie_node);
 	}
 
-	return NULL;
+	k_mutex_unlock(&lock);
+
+	return route;
 }
 #endif /* CONFIG_NET_ROUTE_MCAST */
 
@@ -1100,5 +1175,13 @@ void net_route_init(void)
 	NET_DBG("Allocated %d nexthop entries (%zu bytes)",
 		CONFIG_NET_MAX_NEXTHOPS, sizeof(net_route_nexthop_pool));
 
+	net_route_trie_init(&route_trie, route_trie_nodes,
+			    ARRAY_SIZE(route_trie_nodes));
+
+#if defined(CONFIG_NET_ROUTE_MCAST)
+	net_route_trie_init(&mcast_trie, mcast_trie_nodes,
+			    ARRAY_SIZE(mcast_trie_nodes));
+#endif
+
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
@@ -15,6 +15,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_timeout.h>
@@ -47,7 +48,10 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
+
+	/** Node in the entries of the route prefix in the lookup trie. */
+	sys_snode_t trie_node;
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
@@ -104,12 +108,13 @@ static inline struct net_route_entry *net_route_lookup(struct net_if *iface,
  *
  * @param iface Network interface that this route is tied to.
  * @param addr IPv6 address.
- * @param prefix_len Length of the IPv6 address/prefix.
+ * @param prefix_len Length of the IPv6 address/prefix, at most 128.
  * @param nexthop IPv6 address of the Next hop device.
  * @param lifetime Route lifetime in seconds.
  * @param preference Route preference.
  *
- * @return Return created route entry, NULL if could not be created.
+ * @return Return created route entry, NULL if could not be created or if
+ * @a prefix_len is invalid.
  */
 struct net_route_entry *net_route_add(struct net_if *iface,
 				      struct in6_addr *addr,
@@ -203,6 +208,9 @@ int net_route_foreach(net_route_cb_t cb, void *user_data);
  * @brief Multicast route entry.
  */
 struct net_route_entry_mcast {
+	/** Node in the entries of the group prefix in the lookup trie. */
+	sys_snode_t trie_node;
+
 	/** Network interface for the route. */
 	struct net_if *iface;
 
@@ -279,7 +287,8 @@ bool net_route_mcast_del(struct net_route_entry_mcast *route);
  *
  * @param group IPv6 multicast group address
  *
- * @return Routing entry corresponding this multicast group.
+ * @return Routing entry with the longest prefix matching this multicast
+ * group, NULL if not found.
  */
 struct net_route_entry_mcast *
 net_route_mcast_lookup(struct in6_addr *group);
@@ -0,0 +1,308 @@
+/** @file
+ * @brief Longest prefix match trie for IPv6 routes
+ *
+ * A path compressed binary (Patricia) trie: a node is only created where
+ * a prefix ends or where two prefixes part, so a lookup visits at most one
+ * node per bit of the longest matching prefix, however many prefixes are
+ * stored.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "route_trie.h"
+
+#define ADDR_BITS (8 * sizeof(struct in6_addr))
+
+static inline uint8_t addr_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7U - pos % 8U)) & 1U;
+}
+
+/* Number of leading bits a and b have in common, at most max */
+static uint8_t common_len(const struct in6_addr *a, const struct in6_addr *b,
+			  uint8_t max)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < ARRAY_SIZE(a->s6_addr32) && len < max; i++) {
+		uint32_t diff = ntohl(a->s6_addr32[i] ^ b->s6_addr32[i]);
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff);
+			break;
+		}
+
+		len += 32U;
+	}
+
+	return MIN(len, max);
+}
+
+static inline bool node_matches(const struct net_route_trie_node *node,
+				const struct in6_addr *addr)
+{
+	return common_len(addr, &node->prefix, node->len) == node->len;
+}
+
+static inline struct net_route_trie_node *
+next_node(const struct net_route_trie_node *node, const struct in6_addr *addr)
+{
+	if (node->len >= ADDR_BITS) {
+		return NULL;
+	}
+
+	return node->child[addr_bit(addr, node->len)];
+}
+
+static struct net_route_trie_node *node_alloc(struct net_route_trie *trie,
+					      const struct in6_addr *prefix,
+					      uint8_t len)
+{
+	struct net_route_trie_node *node = trie->free;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	trie->free = node->child[0];
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	sys_slist_init(&node->entries);
+	node->len = len;
+
+	memset(&node->prefix, 0, sizeof(node->prefix));
+	memcpy(&node->prefix, prefix, len / 8U);
+
+	if (len % 8U) {
+		node->prefix.s6_addr[len / 8U] = prefix->s6_addr[len / 8U] &
+						 (0xff << (8U - len % 8U));
+	}
+
+	return node;
+}
+
+static void node_free(struct net_route_trie *trie,
+		      struct net_route_trie_node *node)
+{
+	node->child[0] = trie->free;
+	trie->free = node;
+}
+
+/* Remove the node at link if it neither holds entries nor joins two
+ * subtries, its only subtrie takes its place.
+ */
+static void node_prune(struct net_route_trie *trie,
+		       struct net_route_trie_node **link)
+{
+	struct net_route_trie_node *node = *link;
+
+	if (!sys_slist_is_empty(&node->entries) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return;
+	}
+
+	*link = node->child[0] != NULL ? node->child[0] : node->child[1];
+
+	node_free(trie, node);
+}
+
+void net_route_trie_init(struct net_route_trie *trie,
+			 struct net_route_trie_node *nodes, size_t count)
+{
+	trie->root = NULL;
+	trie->free = NULL;
+
+	for (size_t i = 0; i < count; i++) {
+		node_free(trie, &nodes[i]);
+	}
+}
+
+int net_route_trie_add(struct net_route_trie *trie,
+		       const struct in6_addr *prefix, uint8_t len,
+		       sys_snode_t *entry)
+{
+	struct net_route_trie_node **link = &trie->root;
+	struct net_route_trie_node *node, *leaf, *branch;
+	uint8_t common = 0U;
+
+	if (len > ADDR_BITS) {
+		return -EINVAL;
+	}
+
+	while ((node = *link) != NULL) {
+		common = common_len(prefix, &node->prefix, MIN(len, node->len));
+		if (common < node->len) {
+			break;
+		}
+
+		if (node->len == len) {
+			sys_slist_append(&node->entries, entry);
+			return 0;
+		}
+
+		link = &node->child[addr_bit(prefix, node->len)];
+	}
+
+	leaf = node_alloc(trie, prefix, len);
+	if (leaf == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_slist_append(&leaf->entries, entry);
+
+	if (node == NULL) {
+		*link = leaf;
+		return 0;
+	}
+
+	/* The new prefix is a prefix of the one of the node */
+	if (common == len) {
+		leaf->child[addr_bit(&node->prefix, len)] = node;
+		*link = leaf;
+		return 0;
+	}
+
+	/* Both prefixes part after their common bits */
+	branch = node_alloc(trie, prefix, common);
+	if (branch == NULL) {
+		node_free(trie, leaf);
+		return -ENOMEM;
+	}
+
+	branch->child[addr_bit(prefix, common)] = leaf;
+	branch->child[addr_bit(&node->prefix, common)] = node;
+	*link = branch;
+
+	return 0;
+}
+
+/* Node holding the entries of exactly this prefix, or NULL */
+static struct net_route_trie_node *
+find_node(struct net_route_trie *trie, const struct in6_addr *prefix,
+	  uint8_t len, struct net_route_trie_node ***link_out,
+	  struct net_route_trie_node ***parent_link_out)
+{
+	struct net_route_trie_node **parent_link = NULL;
+	struct net_route_trie_node **link = &trie->root;
+	struct net_route_trie_node *node;
+
+	if (len > ADDR_BITS) {
+		return NULL;
+	}
+
+	while ((node = *link) != NULL && node->len < len) {
+		if (!node_matches(node, prefix)) {
+			return NULL;
+		}
+
+		parent_link = link;
+		link = &node->child[addr_bit(prefix, node->len)];
+	}
+
+	if (node == NULL || node->len != len || !node_matches(node, prefix)) {
+		return NULL;
+	}
+
+	if (link_out != NULL) {
+		*link_out = link;
+		*parent_link_out = parent_link;
+	}
+
+	return node;
+}
+
+bool net_route_trie_del(struct net_route_trie *trie,
+			const struct in6_addr *prefix, uint8_t len,
+			sys_snode_t *entry)
+{
+	struct net_route_trie_node **parent_link;
+	struct net_route_trie_node **link;
+	struct net_route_trie_node *node;
+
+	node = find_node(trie, prefix, len, &link, &parent_link);
+	if (node == NULL || !sys_slist_find_and_remove(&node->entries, entry)) {
+		return false;
+	}
+
+	node_prune(trie, link);
+
+	/* The parent may now only lead to one subtrie */
+	if (parent_link != NULL) {
+		node_prune(trie, parent_link);
+	}
+
+	return true;
+}
+
+sys_snode_t *net_route_trie_find(struct net_route_trie *trie,
+				 const struct in6_addr *prefix, uint8_t len,
+				 net_route_trie_cb_t cb, void *user_data)
+{
+	struct net_route_trie_node *node;
+	sys_snode_t *entry;
+
+	node = find_node(trie, prefix, len, NULL, NULL);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_NODE(&node->entries, entry) {
+		if (cb == NULL || cb(entry, user_data)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+sys_snode_t *net_route_trie_lookup(struct net_route_trie *trie,
+				   const struct in6_addr *addr,
+				   net_route_trie_cb_t cb, void *user_data)
+{
+	struct net_route_trie_node *node;
+	sys_snode_t *found = NULL;
+
+	for (node = trie->root; node != NULL && node_matches(node, addr);
+	     node = next_node(node, addr)) {
+		sys_snode_t *entry;
+
+		SYS_SLIST_FOR_EACH_NODE(&node->entries, entry) {
+			if (cb == NULL || cb(entry, user_data)) {
+				found = entry;
+				break;
+			}
+		}
+	}
+
+	return found;
+}
+
+int net_route_trie_foreach_match(struct net_route_trie *trie,
+				 const struct in6_addr *addr,
+				 net_route_trie_cb_t cb, void *user_data)
+{
+	struct net_route_trie_node *node;
+	int count = 0;
+
+	for (node = trie->root; node != NULL && node_matches(node, addr);
+	     node = next_node(node, addr)) {
+		sys_snode_t *entry;
+
+		SYS_SLIST_FOR_EACH_NODE(&node->entries, entry) {
+			(void)cb(entry, user_data);
+			count++;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,165 @@
+/** @file
+ * @brief Longest prefix match trie for IPv6 routes
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ROUTE_TRIE_H
+#define __ROUTE_TRIE_H
+
+#include <zephyr/types.h>
+#include <zephyr/sys/slist.h>
+
+#include <zephyr/net/net_ip.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Node of a path compressed binary trie of IPv6 prefixes.
+ *
+ * A node either holds the entries added for its prefix, or only joins
+ * two subtries whose prefixes first differ at bit @a len.
+ */
+struct net_route_trie_node {
+	/** Subtries continuing with a 0 and a 1 bit after the prefix */
+	struct net_route_trie_node *child[2];
+
+	/** Entries added for exactly this prefix */
+	sys_slist_t entries;
+
+	/** Prefix, the bits after @a len are zero */
+	struct in6_addr prefix;
+
+	/** Prefix length in bits */
+	uint8_t len;
+};
+
+/**
+ * @brief Trie of IPv6 prefixes, using nodes from a fixed size pool.
+ *
+ * n prefixes need at most 2 * n - 1 nodes.
+ */
+struct net_route_trie {
+	/** Root of the trie, the node with the shortest prefix */
+	struct net_route_trie_node *root;
+
+	/** Unused nodes, linked through their first child pointer */
+	struct net_route_trie_node *free;
+};
+
+/**
+ * @brief Called for an entry of a prefix matching the looked up address.
+ *
+ * @param entry Entry node given to net_route_trie_add().
+ * @param user_data User supplied data.
+ *
+ * @return True to select the entry.
+ */
+typedef bool (*net_route_trie_cb_t)(sys_snode_t *entry, void *user_data);
+
+/**
+ * @brief Initialize an empty trie.
+ *
+ * @param trie Trie to initialize.
+ * @param nodes Node pool of the trie.
+ * @param count Number of nodes in the pool.
+ */
+void net_route_trie_init(struct net_route_trie *trie,
+			 struct net_route_trie_node *nodes, size_t count);
+
+/**
+ * @brief Add an entry for a prefix.
+ *
+ * Several entries can be added for the same prefix.
+ *
+ * @param trie Trie to add the entry to.
+ * @param prefix Prefix, the bits after @a len are ignored.
+ * @param len Prefix length in bits, at most 128.
+ * @param entry Entry node, not in any list.
+ *
+ * @return 0 if ok, -EINVAL if @a len is too long, -ENOMEM if the node pool
+ * is exhausted.
+ */
+int net_route_trie_add(struct net_route_trie *trie,
+		       const struct in6_addr *prefix, uint8_t len,
+		       sys_snode_t *entry);
+
+/**
+ * @brief Remove an entry added for a prefix.
+ *
+ * @param trie Trie to remove the entry from.
+ * @param prefix Prefix the entry was added for.
+ * @param len Prefix length in bits.
+ * @param entry Entry node.
+ *
+ * @return True if the entry was found and removed.
+ */
+bool net_route_trie_del(struct net_route_trie *trie,
+			const struct in6_addr *prefix, uint8_t len,
+			sys_snode_t *entry);
+
+/**
+ * @brief Find an entry added for exactly a prefix.
+ *
+ * @param trie Trie to search.
+ * @param prefix Prefix, the bits after @a len are ignored.
+ * @param len Prefix length in bits.
+ * @param cb Callback selecting the entries which can be returned, or NULL
+ *           to accept any entry.
+ * @param user_data User data passed to @a cb.
+ *
+ * @return First entry of the prefix selected by @a cb, or NULL.
+ */
+sys_snode_t *net_route_trie_find(struct net_route_trie *trie,
+				 const struct in6_addr *prefix, uint8_t len,
+				 net_route_trie_cb_t cb, void *user_data);
+
+/**
+ * @brief Find the entry with the longest prefix matching an address.
+ *
+ * Only the nodes on the path of the address are visited, at most one per
+ * bit of the longest matching prefix.
+ *
+ * @param trie Trie to search.
+ * @param addr Address to look up.
+ * @param cb Callback selecting the entries which can be returned, or NULL
+ *           to accept any entry.
+ * @param user_data User data passed to @a cb.
+ *
+ * @return Entry of the longest matching prefix selected by @a cb, the
+ * first one added if several entries of that prefix are, or NULL.
+ */
+sys_snode_t *net_route_trie_lookup(struct net_route_trie *trie,
+				   const struct in6_addr *addr,
+				   net_route_trie_cb_t cb, void *user_data);
+
+/**
+ * @brief Call a callback for all the entries of prefixes matching an
+ * address, from the shortest prefix to the longest.
+ *
+ * The callback must not add or remove entries.
+ *
+ * @param trie Trie to search.
+ * @param addr Address to look up.
+ * @param cb Callback called for each entry, its return value is ignored.
+ * @param user_data User data passed to @a cb.
+ *
+ * @return Number of entries visited.
+ */
+int net_route_trie_foreach_match(struct net_route_trie *trie,
+				 const struct in6_addr *addr,
+				 net_route_trie_cb_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROUTE_TRIE_H */
@@ -69,6 +69,12 @@ static K_MUTEX_DEFINE(tcp_lock);
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
+#if CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT
+K_MEM_SLAB_DEFINE_STATIC(tcp_ooo_slab, sizeof(struct tcp_ooo_seg),
+			 CONFIG_NET_TCP_RECV_QUEUE_SEGMENTS,
+			 __alignof__(struct tcp_ooo_seg));
+#endif
+
 static struct k_work_q tcp_work_q;
 static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
 
@@ -79,14 +85,97 @@ static void tcp_out(struct tcp *conn, uint8_t flags);
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
 
-static uint32_t tcp_get_seq(struct net_buf *buf)
+#define TCP_OOO_SEG(_node) CONTAINER_OF(_node, struct tcp_ooo_seg, node)
+
+static bool tcp_ooo_seg_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return net_tcp_seq_cmp(TCP_OOO_SEG(a)->seq, TCP_OOO_SEG(b)->seq) < 0;
+}
+
+static struct tcp_ooo_seg *tcp_ooo_seg_alloc(void)
+{
+	struct tcp_ooo_seg *seg = NULL;
+
+#if CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT
+	if (k_mem_slab_alloc(&tcp_ooo_slab, (void **)&seg, K_NO_WAIT) < 0) {
+		seg = NULL;
+	}
+#endif
+
+	return seg;
+}
+
+static void tcp_ooo_seg_free(struct tcp *conn, struct tcp_ooo_seg *seg)
+{
+	rb_remove(&conn->recv_queue, &seg->node);
+
+	if (seg->buf) {
+		net_buf_unref(seg->buf);
+	}
+
+#if CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT
+	k_mem_slab_free(&tcp_ooo_slab, (void **)&seg);
+#endif
+}
+
+/* Queued range starting at or before seq */
+static struct tcp_ooo_seg *tcp_ooo_seg_floor(struct tcp *conn, uint32_t seq)
+{
+	struct rbnode *node = conn->recv_queue.root;
+	struct tcp_ooo_seg *found = NULL;
+
+	while (node) {
+		if (net_tcp_seq_cmp(TCP_OOO_SEG(node)->seq, seq) <= 0) {
+			found = TCP_OOO_SEG(node);
+			node = z_rb_child(node, 1U);
+		} else {
+			node = z_rb_child(node, 0U);
+		}
+	}
+
+	return found;
+}
+
+/* First queued range starting after seq */
+static struct tcp_ooo_seg *tcp_ooo_seg_next(struct tcp *conn, uint32_t seq)
 {
-	return *(uint32_t *)net_buf_user_data(buf);
+	struct rbnode *node = conn->recv_queue.root;
+	struct tcp_ooo_seg *found = NULL;
+
+	while (node) {
+		if (net_tcp_seq_cmp(TCP_OOO_SEG(node)->seq, seq) > 0) {
+			found = TCP_OOO_SEG(node);
+			node = z_rb_child(node, 0U);
+		} else {
+			node = z_rb_child(node, 1U);
+		}
+	}
+
+	return found;
 }
 
-static void tcp_set_seq(struct net_buf *buf, uint32_t seq)
+static void tcp_recv_queue_flush(struct tcp *conn)
 {
-	*(uint32_t *)net_buf_user_data(buf) = seq;
+	struct rbnode *node;
+
+	while ((node = rb_get_min(&conn->recv_queue)) != NULL) {
+		tcp_ooo_seg_free(conn, TCP_OOO_SEG(node));
+	}
+}
+
+/* Remove len bytes from the start of a buffer chain, returns the new head */
+static struct net_buf *tcp_buf_pull(struct net_buf *buf, size_t len)
+{
+	while (buf && len >= buf->len) {
+		len -= buf->len;
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	if (buf && len) {
+		net_buf_pull(buf, len);
+	}
+
+	return buf;
 }
 
 static int tcp_pkt_linearize(struct net_pkt *pkt, size_t pos, size_t len)
@@ -456,9 +545,8 @@ static int tcp_conn_unref(struct tcp *conn)
 	k_work_cancel_delayable(&conn->send_data_timer);
 	tcp_pkt_unref(conn->send_data);
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-		tcp_pkt_unref(conn->queue_recv_data);
-	}
+	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+	tcp_recv_queue_flush(conn);
 
 	(void)k_work_cancel_delayable(&conn->timewait_timer);
 	(void)k_work_cancel_delayable(&conn->fin_timer);
@@ -681,8 +769,14 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* These options are only sent with SYN, keep what was negotiated
+	 * when later segments carry other options.
+	 */
+	if (th_flags(th_get(pkt)) & SYN) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -731,6 +825,33 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_count++];
+
+				block->start = sys_get_be32(options + i);
+				block->end = sys_get_be32(options + i + 4);
+			}
+
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -791,63 +912,46 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	return 0;
 }
 
+/* Append the queued data that continues the in-order data of pkt, which
+ * starts at conn->ack and is len bytes long.
+ */
 static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 				     size_t len)
 {
+	uint32_t expected_seq = conn->ack + len;
 	size_t pending_len = 0;
+	bool dequeued = false;
+	struct rbnode *node;
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
-	    !net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off   | Gap size | Required handling
-		 * Seq|Len|Seq|Len|           |          |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | 6-3-3=0  | Append
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | 6-3-4=-1 | Append, pull from queue
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3-7=-4 | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3-8=-5 | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6-5=-5 | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6-4=-4 | Drop queued data / packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10-2=-6| Should not happen, dropping queue
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7-4=-5 | Should not happen, dropping queue
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11-2=-7| Should not happen, dropping queue
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2-3=1  | Keep queued data
-		 */
-		struct tcphdr *th = th_get(pkt);
-		uint32_t expected_seq = th_seq(th) + len;
-		uint32_t pending_seq;
-		int32_t gap_size;
-		uint32_t end_offset;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = expected_seq - pending_seq;
-		gap_size = (int32_t)(pending_seq - th_seq(th) - ((uint32_t)len));
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset) {
-				net_pkt_remove_tail(pkt, end_offset);
-				pending_len -= end_offset;
-			}
+	while ((node = rb_get_min(&conn->recv_queue)) != NULL) {
+		struct tcp_ooo_seg *seg = TCP_OOO_SEG(node);
+		uint32_t end_seq = seg->seq + seg->len;
 
-			NET_DBG("Found pending data seq %u len %zd",
-				expected_seq, pending_len);
+		if (net_tcp_seq_cmp(seg->seq, expected_seq) > 0) {
+			/* There is still a hole before the queued data */
+			break;
+		}
 
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = NULL;
+		if (net_tcp_seq_cmp(end_seq, expected_seq) > 0) {
+			seg->buf = tcp_buf_pull(seg->buf,
+						expected_seq - seg->seq);
 
-			k_work_cancel_delayable(&conn->recv_queue_timer);
-		} else {
-			/* Check if the queued data is just a section of the incoming data */
-			if (gap_size <= 0) {
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
+			NET_DBG("Found pending data seq %u len %u",
+				expected_seq, end_seq - expected_seq);
 
-				k_work_cancel_delayable(&conn->recv_queue_timer);
-			}
+			net_buf_frag_add(pkt->buffer, seg->buf);
+			seg->buf = NULL;
 
-			pending_len = 0;
+			pending_len += end_seq - expected_seq;
+			expected_seq = end_seq;
 		}
+
+		tcp_ooo_seg_free(conn, seg);
+		dequeued = true;
+	}
+
+	if (dequeued && node == NULL) {
+		k_work_cancel_delayable(&conn->recv_queue_timer);
 	}
 
 	return pending_len;
@@ -905,7 +1009,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -919,11 +1023,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -984,6 +1084,34 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_cc_ops *cc = tcp_cc_find(value, len);
+
+	if (cc == NULL) {
+		return -ENOENT;
+	}
+
+	if (cc != conn->cc) {
+		tcp_cc_select(conn, cc);
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	/* Like Linux, truncate the name to the buffer given */
+	size_t name_len = MIN(*len, strlen(conn->cc->name) + 1);
+
+	strncpy(value, conn->cc->name, name_len);
+	*len = name_len;
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
@@ -1003,6 +1131,208 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+static bool tcp_sack_permitted(struct tcp *conn)
+{
+	return conn->recv_options.sack_perm_found;
+}
+
+/* Build the SACK permitted option of a SYN, or the SACK option of an ACK
+ * sent while there is out-of-order data queued. Returns the option length.
+ */
+static size_t tcp_sack_opt_build(struct tcp *conn, uint8_t flags, uint8_t *opt)
+{
+	struct tcp_ooo_seg *first, *seg;
+	size_t len = 4;
+
+	if (flags & SYN) {
+		/* Only answer a SYN with SACK permitted if the peer offered */
+		if ((flags & ACK) && !tcp_sack_permitted(conn)) {
+			return 0;
+		}
+
+		opt[0] = NET_TCP_NOP_OPT;
+		opt[1] = NET_TCP_NOP_OPT;
+		opt[2] = NET_TCP_SACK_PERM_OPT;
+		opt[3] = NET_TCP_SACK_PERM_SIZE;
+
+		return len;
+	}
+
+	if (!(flags & ACK) || (flags & RST) || !tcp_sack_permitted(conn)) {
+		return 0;
+	}
+
+	/* The first block is the one holding the latest segment received,
+	 * RFC 2018 section 4, the others follow in sequence order.
+	 */
+	first = tcp_ooo_seg_floor(conn, conn->sack_last_seq);
+	if (first != NULL && net_tcp_seq_cmp(first->seq + first->len,
+					     conn->sack_last_seq) <= 0) {
+		first = NULL;
+	}
+
+	if (first != NULL) {
+		sys_put_be32(first->seq, opt + len);
+		sys_put_be32(first->seq + first->len, opt + len + 4);
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	RB_FOR_EACH_CONTAINER(&conn->recv_queue, seg, node) {
+		if (len == 4 + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE) {
+			break;
+		}
+
+		if (seg != first) {
+			sys_put_be32(seg->seq, opt + len);
+			sys_put_be32(seg->seq + seg->len, opt + len + 4);
+			len += NET_TCP_SACK_BLOCK_SIZE;
+		}
+	}
+
+	if (len == 4) {
+		return 0;
+	}
+
+	opt[0] = NET_TCP_NOP_OPT;
+	opt[1] = NET_TCP_NOP_OPT;
+	opt[2] = NET_TCP_SACK_OPT;
+	opt[3] = len - 2;
+
+	return len;
+}
+
+/* Add a range the peer reports to hold to the scoreboard, which is kept
+ * sorted and without overlaps. If it is full, the highest range is lost,
+ * which only means that data may be resent needlessly.
+ */
+static void tcp_sack_add(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int count = conn->sacked_count;
+	int i = 0, j;
+
+	while (i < count && net_tcp_seq_cmp(sacked[i].end, start) < 0) {
+		i++;
+	}
+
+	for (j = i; j < count && net_tcp_seq_cmp(sacked[j].start, end) <= 0; j++) {
+		if (net_tcp_seq_cmp(sacked[j].start, start) < 0) {
+			start = sacked[j].start;
+		}
+
+		if (net_tcp_seq_cmp(sacked[j].end, end) > 0) {
+			end = sacked[j].end;
+		}
+	}
+
+	if (i == j) {
+		if (count == TCP_SACK_SCOREBOARD_SIZE) {
+			if (i == count) {
+				return;
+			}
+
+			count--;
+		}
+
+		memmove(&sacked[i + 1], &sacked[i], (count - i) * sizeof(*sacked));
+		count++;
+	} else {
+		memmove(&sacked[i + 1], &sacked[j], (count - j) * sizeof(*sacked));
+		count -= j - i - 1;
+	}
+
+	sacked[i].start = start;
+	sacked[i].end = end;
+	conn->sacked_count = count;
+}
+
+/* Record the SACK blocks of the segment being processed */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+
+	for (int i = 0; i < opts->sack_count; i++) {
+		uint32_t start = opts->sack[i].start;
+		uint32_t end = opts->sack[i].end;
+
+		/* Ignore blocks for data already acknowledged or never
+		 * sent, only keep the part above the cumulative ACK.
+		 */
+		if (net_tcp_seq_cmp(end, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(start, end) >= 0 ||
+		    net_tcp_seq_cmp(end, snd_max) > 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+			start = conn->seq;
+		}
+
+		tcp_sack_add(conn, start, end);
+	}
+
+	opts->sack_count = 0;
+}
+
+/* The cumulative ACK has moved on, drop the ranges it covers */
+static void tcp_sack_acked(struct tcp *conn)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int i = 0;
+
+	while (i < conn->sacked_count &&
+	       net_tcp_seq_cmp(sacked[i].end, conn->seq) <= 0) {
+		i++;
+	}
+
+	conn->sacked_count -= i;
+	memmove(sacked, &sacked[i], conn->sacked_count * sizeof(*sacked));
+
+	/* An ACK that stops at or inside a range the peer has reported to
+	 * hold means it has discarded that data since, RFC 2018 section 8.
+	 * Forget everything it reported, it will be resent.
+	 */
+	if (conn->sacked_count > 0 &&
+	    net_tcp_seq_cmp(sacked[0].start, conn->seq) <= 0) {
+		NET_DBG("conn: %p peer reneged on seq %u", conn,
+			sacked[0].start);
+		conn->sacked_count = 0;
+	}
+}
+
+/* Move the send position past data the peer already holds, and return how
+ * much of len can be sent before the next such range.
+ */
+static int tcp_sack_skip(struct tcp *conn, int len)
+{
+	uint32_t next = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(block->end, next) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->start, next) > 0) {
+			return MIN(len, (int)(block->start - next));
+		}
+
+		conn->unacked_len += block->end - next;
+		next = block->end;
+	}
+
+	return len;
+}
+#else
+#define tcp_sack_opt_build(...) 0
+#define tcp_sack_update(...)
+#define tcp_sack_acked(...)
+#define tcp_sack_skip(_conn, _len) (_len)
+#endif /* CONFIG_NET_TCP_SACK */
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1029,14 +1359,21 @@ static bool is_destination_local(struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t sack_opt[4 + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
 	size_t alloc_len = sizeof(struct tcphdr);
+	size_t opts_len = 0;
+	size_t sack_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
 	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
+		opts_len += NET_TCP_MSS_SIZE;
 	}
 
+	sack_len = tcp_sack_opt_build(conn, flags, sack_opt);
+	opts_len += sack_len;
+	alloc_len += opts_len;
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1046,6 +1383,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 		data->buffer = NULL;
 	}
 
@@ -1055,7 +1393,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1069,6 +1407,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (sack_len) {
+		ret = net_pkt_write(pkt, sack_opt, sack_len);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1144,8 +1490,21 @@ static bool tcp_window_full(struct tcp *conn)
 	return window_full;
 }
 
+/* How much data may be in flight: the receiver's window, further limited
+ * by the congestion window.
+ */
+static int tcp_send_window(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	return MIN(conn->send_win, conn->cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static int tcp_unsent_len(struct tcp *conn)
 {
+	int send_win = tcp_send_window(conn);
 	int unsent_len;
 
 	if (conn->unacked_len > conn->send_data_total) {
@@ -1156,10 +1515,10 @@ static int tcp_unsent_len(struct tcp *conn)
 	}
 
 	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
+	if (conn->unacked_len >= send_win) {
 		unsent_len = 0;
 	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+		unsent_len = MIN(unsent_len, send_win - conn->unacked_len);
 	}
  out:
 	NET_DBG("unsent_len=%d", unsent_len);
@@ -1167,35 +1526,108 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* How many segments of new data can go down the stack as one large
+ * packet. Packets to our own addresses are looped back before reaching
+ * the interface, where large packets are cut, so they are never large.
+ */
+static int tcp_gso_segs(struct tcp *conn)
 {
+#ifdef CONFIG_NET_TCP_GSO
+	if (IS_ENABLED(CONFIG_NET_IPV4) && conn->dst.sa.sa_family == AF_INET &&
+	    (net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+	     net_ipv4_is_my_addr(&conn->dst.sin.sin_addr))) {
+		return 1;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->dst.sa.sa_family == AF_INET6 &&
+	    (net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+	     net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr))) {
+		return 1;
+	}
+
+	/* The whole packet must fit in the IP length field */
+	return MIN(CONFIG_NET_TCP_GSO_MAX_SEGS,
+		   (UINT16_MAX - NET_TCP_GSO_HDR_MAX) / conn_mss(conn));
+#else
+	ARG_UNUSED(conn);
+
+	return 1;
+#endif
+}
+
+/* Send up to segs segments of data, as one large packet if there is more
+ * than one.
+ */
+static int tcp_send_data(struct tcp *conn, int segs)
+{
+	int mss = conn_mss(conn);
+	struct net_pkt *pkt = NULL;
 	int ret = 0;
 	int len;
-	struct net_pkt *pkt;
 
+	/* When resending, data the peer reported with SACK is skipped */
+	len = tcp_sack_skip(conn, mss * segs);
 	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+		   MAX(tcp_send_window(conn) - conn->unacked_len, 0),
+		   len);
 	if (len == 0) {
 		NET_DBG("conn: %p no data to send", conn);
 		ret = -ENODATA;
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+	/* With Nagle's algorithm a partial segment after full ones is held
+	 * back, as tcp_send_queued_data() does when sending one at a time.
+	 */
+	if (len > mss && !conn->tcp_nodelay) {
+		len -= len % mss;
+	}
+
+	/* Each segment gets its own buffers, so that the large packet can be
+	 * cut by moving them instead of copying the data.
+	 */
+	for (int off = 0; off < len; off += mss) {
+		int seg_len = MIN(len - off, mss);
+		struct net_pkt *seg;
+
+		seg = tcp_pkt_alloc(conn, seg_len);
+		if (!seg) {
+			NET_ERR("conn: %p packet allocation failed, len=%d",
+				conn, seg_len);
+			ret = -ENOBUFS;
+			break;
+		}
+
+		ret = tcp_pkt_peek(seg, conn->send_data,
+				   conn->unacked_len + off, seg_len);
+		if (ret < 0) {
+			tcp_pkt_unref(seg);
+			ret = -ENOBUFS;
+			break;
+		}
+
+		if (off == 0) {
+			pkt = seg;
+			continue;
+		}
+
+		net_pkt_append_buffer(pkt, seg->buffer);
+		seg->buffer = NULL;
+		tcp_pkt_unref(seg);
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
 	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
+		if (pkt) {
+			tcp_pkt_unref(pkt);
+		}
+
 		goto out;
 	}
 
+	if (len > mss) {
+		net_pkt_set_gso_size(pkt, mss);
+	}
+
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
@@ -1205,7 +1637,10 @@ static int tcp_send_data(struct tcp *conn)
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			for (int off = 0; off < len; off += mss) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
@@ -1221,6 +1656,30 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+static bool tcp_in_fast_recovery(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	return conn->in_recovery;
+#else
+	return false;
+#endif
+}
+
+/* Retransmit the first unacknowledged segment only */
+static void tcp_fast_retransmit(struct tcp *conn)
+{
+	int temp_unacked_len = conn->unacked_len;
+
+	conn->unacked_len = 0;
+
+	(void)tcp_send_data(conn, 1);
+
+	/* Restore the current transmission */
+	conn->unacked_len = temp_unacked_len;
+}
+#endif
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1246,7 +1705,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
-		ret = tcp_send_data(conn);
+		ret = tcp_send_data(conn, tcp_gso_segs(conn));
 		if (ret < 0) {
 			break;
 		}
@@ -1276,12 +1735,9 @@ static void tcp_cleanup_recv_queue(struct k_work *work)
 
 	k_mutex_lock(&conn->lock, K_FOREVER);
 
-	NET_DBG("Cleanup recv queue conn %p len %zd seq %u", conn,
-		net_pkt_get_len(conn->queue_recv_data),
-		tcp_get_seq(conn->queue_recv_data->buffer));
+	NET_DBG("Cleanup recv queue conn %p", conn);
 
-	net_buf_unref(conn->queue_recv_data->buffer);
-	conn->queue_recv_data->buffer = NULL;
+	tcp_recv_queue_flush(conn);
 
 	k_mutex_unlock(&conn->lock);
 }
@@ -1304,10 +1760,18 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	if (conn->unacked_len > 0) {
+		tcp_cc_timeout(conn, conn->send_data_retries == 0);
+	}
+
+	/* Go back to the first unacknowledged byte. With SACK, the segment
+	 * sent ends where the data the peer holds begins, and once it is
+	 * acknowledged the ranges held are skipped when sending again.
+	 */
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
-	ret = tcp_send_data(conn);
+	ret = tcp_send_data(conn, 1);
 	conn->send_data_retries++;
 	if (ret == 0) {
 		if (conn->in_close && conn->send_data_total == 0) {
@@ -1453,21 +1917,14 @@ static struct tcp *tcp_conn_alloc(void)
 
 	memset(conn, 0, sizeof(*conn));
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-		conn->queue_recv_data = tcp_rx_pkt_alloc(conn, 0);
-		if (conn->queue_recv_data == NULL) {
-			NET_ERR("Cannot allocate %s queue for conn %p", "recv",
-				conn);
-			goto fail;
-		}
-	}
-
 	conn->send_data = tcp_pkt_alloc(conn, 0);
 	if (conn->send_data == NULL) {
 		NET_ERR("Cannot allocate %s queue for conn %p", "send", conn);
 		goto fail;
 	}
 
+	conn->recv_queue.lessthan_fn = tcp_ooo_seg_lessthan;
+
 	k_mutex_init(&conn->lock);
 	k_fifo_init(&conn->recv_data);
 	k_sem_init(&conn->connect_sem, 0, K_SEM_MAX_LIMIT);
@@ -1483,6 +1940,7 @@ static struct tcp *tcp_conn_alloc(void)
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	conn->dup_ack_cnt = 0;
 #endif
+	tcp_cc_select(conn, NULL);
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -1508,11 +1966,6 @@ out:
 	return conn;
 
 fail:
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT && conn->queue_recv_data) {
-		tcp_pkt_unref(conn->queue_recv_data);
-		conn->queue_recv_data = NULL;
-	}
-
 	k_mem_slab_free(&tcp_conns_slab, (void **)&conn);
 	return NULL;
 }
@@ -1588,6 +2041,15 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
+	/* The handler of a connected context is registered for its whole
+	 * 4-tuple, so the context the packet was demultiplexed to usually
+	 * is the connection's own: only search if it is not.
+	 */
+	conn = ((struct net_context *)user_data)->tcp;
+	if (conn != NULL && tcp_conn_cmp(conn, pkt)) {
+		goto in;
+	}
+
 	conn = tcp_conn_search(pkt);
 	if (conn) {
 		goto in;
@@ -1606,6 +2068,9 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 
 		net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
 
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+		tcp_cc_select(conn, conn_old->cc);
+#endif
 		conn->accepted_conn = conn_old;
 	}
  in:
@@ -1821,165 +2286,73 @@ static bool tcp_validate_seq(struct tcp *conn, struct tcphdr *hdr)
 		(net_tcp_seq_cmp(th_seq(hdr), conn->ack + conn->recv_win) < 0);
 }
 
-static bool check_seq_list(struct net_buf *buf)
-{
-	struct net_buf *last = NULL;
-	struct net_buf *tmp = buf;
-	uint32_t seq;
-	uint32_t next_seq = 0;
-	bool result = true;
-
-	while (tmp) {
-		seq = tcp_get_seq(tmp);
-
-		NET_DBG("buf %p seq %u len %d", tmp, seq, tmp->len);
-
-		if (last != NULL) {
-			if (next_seq != seq) {
-				result = false;
-			}
-		}
-
-		next_seq = seq + tmp->len;
-		last = tmp;
-		tmp = tmp->frags;
-	}
-	return result;
-}
-
+/* Queue out-of-order data, merging it with the ranges it touches or
+ * overlaps. Takes the data buffers of pkt if the data is kept.
+ */
 static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 				size_t len, uint32_t seq)
 {
-	uint32_t seq_start = seq;
-	bool inserted = false;
-	struct net_buf *tmp;
+	uint32_t end_seq = seq + len;
+	struct tcp_ooo_seg *seg, *next;
 
 	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
 
-	tmp = pkt->buffer;
-
-	tcp_set_seq(tmp, seq);
-	seq += tmp->len;
-	tmp = tmp->frags;
-
-	while (tmp) {
-		tcp_set_seq(tmp, seq);
-		seq += tmp->len;
-		tmp = tmp->frags;
-	}
-
-	if (IS_ENABLED(CONFIG_NET_TCP_LOG_LEVEL_DBG)) {
-		NET_DBG("Queuing data: conn %p", conn);
-	}
-
-	if (!net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 *
-		 * Only work with subtractions between sequence numbers in uint32_t format
-		 * to proper handle cases that are around the wrapping point.
-		 */
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_last_seq = seq;
+#endif
 
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off1  | Start off| End off2    | Required handling
-		 * Seq|Len|Seq|Len|           |          |             |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | NA       | NA          | Prepend
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | NA       | NA          | Prepend, pull from buffer
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6=0    | 6+4-6=4     | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6=0    | 6+4-6=4     | Drop queued data / packet
-		 *  7 | 2 | 6 | 4 | 7+2-6 = 3 | 6-7=MI   | 6+4-7=3     | Drop packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10=MI-3| 6+4-10=0    | Append
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7 =MI  | 6+4-7 =3    | Append, pull from packet
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11=MI-6| 6+4-11=MI-1 | Drop incoming packet
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2=4    | 6+4-2=8     | Drop incoming packet
-		 */
+	seg = tcp_ooo_seg_floor(conn, seq);
+	if (seg && net_tcp_seq_cmp(seg->seq + seg->len, seq) >= 0) {
+		uint32_t seg_end = seg->seq + seg->len;
 
-		uint32_t pending_seq;
-		uint32_t start_offset;
-		uint32_t end_offset;
-		size_t pending_len;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = seq - pending_seq;
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset < len) {
-				if (end_offset) {
-					net_pkt_remove_tail(pkt, end_offset);
-				}
+		if (net_tcp_seq_cmp(seg_end, end_seq) >= 0) {
+			NET_DBG("Data already queued");
+			return;
+		}
 
-				/* Put new data before the pending data */
-				net_buf_frag_add(pkt->buffer,
-						 conn->queue_recv_data->buffer);
-				NET_DBG("Adding at before queue, end_offset %i, pending_len %zu",
-					end_offset, pending_len);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			}
-		} else {
-			struct net_buf *last;
+		/* Extend the range the data starts in */
+		net_buf_frag_add(seg->buf, tcp_buf_pull(pkt->buffer,
+							seg_end - seq));
+		seg->len = end_seq - seg->seq;
+	} else {
+		seg = tcp_ooo_seg_alloc();
+		if (seg == NULL) {
+			NET_DBG("Cannot add new data to queue");
+			return;
+		}
 
-			last = net_buf_frag_last(conn->queue_recv_data->buffer);
-			pending_seq = tcp_get_seq(last);
+		seg->buf = pkt->buffer;
+		seg->seq = seq;
+		seg->len = len;
+		rb_insert(&conn->recv_queue, &seg->node);
+	}
 
-			start_offset = pending_seq - seq_start;
-			/* Compute the offset w.r.t. the start point of the new packet */
-			end_offset = (pending_seq + last->len) - seq_start;
+	/* We need to keep the received data but free the pkt */
+	pkt->buffer = NULL;
 
-			/* Check if queue start with within the within the new packet */
-			if ((start_offset < len) && (end_offset <= len)) {
-				/* The queued data is irrelevant since the new packet overlaps the
-				 * new packet, take the new packet as contents
-				 */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			} else {
-				if (end_offset < len) {
-					if (end_offset) {
-						net_pkt_remove_tail(conn->queue_recv_data,
-								    end_offset);
-					}
+	/* Absorb the following ranges the data reaches */
+	while ((next = tcp_ooo_seg_next(conn, seg->seq)) != NULL &&
+	       net_tcp_seq_cmp(next->seq, end_seq) <= 0) {
+		uint32_t next_end = next->seq + next->len;
 
-					/* Put new data after pending data */
-					NET_DBG("Adding at end of queue, start %i, end %i, len %zu",
-						start_offset, end_offset, len);
-					net_buf_frag_add(conn->queue_recv_data->buffer,
-							 pkt->buffer);
-					inserted = true;
-				}
-			}
+		if (net_tcp_seq_cmp(next_end, end_seq) > 0) {
+			net_buf_frag_add(seg->buf,
+					 tcp_buf_pull(next->buf,
+						      end_seq - next->seq));
+			next->buf = NULL;
+			seg->len = next_end - seg->seq;
+			end_seq = next_end;
 		}
 
-		if (inserted) {
-			NET_DBG("All pending data: conn %p", conn);
-			if (check_seq_list(conn->queue_recv_data->buffer) == false) {
-				NET_ERR("Incorrect order in out of order sequence for conn %p",
-					conn);
-				/* error in sequence list, drop it */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-			}
-		} else {
-			NET_DBG("Cannot add new data to queue");
-		}
-	} else {
-		net_pkt_append_buffer(conn->queue_recv_data, pkt->buffer);
-		inserted = true;
+		tcp_ooo_seg_free(conn, next);
 	}
 
-	if (inserted) {
-		/* We need to keep the received data but free the pkt */
-		pkt->buffer = NULL;
+	NET_DBG("Queued range seq %u len %u", seg->seq, seg->len);
 
-		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
-			k_work_reschedule_for_queue(
-				&tcp_work_q, &conn->recv_queue_timer,
-				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
-		}
+	if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
+		k_work_reschedule_for_queue(
+			&tcp_work_q, &conn->recv_queue_timer,
+			K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
 	}
 }
 
@@ -2124,6 +2497,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+#ifdef CONFIG_NET_TCP_SACK
+	conn->recv_options.sack_count = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2208,6 +2585,7 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+			tcp_cc_start(conn);
 			next = TCP_ESTABLISHED;
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
@@ -2261,6 +2639,7 @@ next_state:
 				verdict = NET_OK;
 			}
 
+			tcp_cc_start(conn);
 			next = TCP_ESTABLISHED;
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
@@ -2314,6 +2693,10 @@ next_state:
 			break;
 		}
 
+		if (th) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -2325,6 +2708,15 @@ next_state:
 					 */
 					conn->dup_ack_cnt = MIN(conn->dup_ack_cnt + 1,
 						DUPLICATE_ACK_RETRANSMIT_TRHESHOLD + 1);
+
+					if (tcp_in_fast_recovery(conn)) {
+						/* Another segment left the
+						 * network, which may allow
+						 * sending a new one.
+						 */
+						tcp_cc_dup_ack(conn);
+						(void)tcp_send_queued_data(conn);
+					}
 				}
 			} else {
 				conn->dup_ack_cnt = 0;
@@ -2332,16 +2724,10 @@ next_state:
 
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+			    !tcp_in_fast_recovery(conn) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
-
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+				tcp_cc_fast_recovery(conn);
+				tcp_fast_retransmit(conn);
 			}
 		}
 #endif
@@ -2382,6 +2768,17 @@ next_state:
 
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
+			tcp_sack_acked(conn);
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+			if (tcp_cc_ack(conn, len_acked) &&
+			    conn->data_mode == TCP_DATA_MODE_SEND) {
+				/* Partial ACK in fast recovery, the segment
+				 * after the acknowledged data is lost as well.
+				 */
+				tcp_fast_retransmit(conn);
+			}
+#endif
 
 			conn_send_data_dump(conn);
 
@@ -2436,6 +2833,20 @@ next_state:
 					/* ACK, no data */
 					verdict = NET_OK;
 				}
+			} else if (net_tcp_seq_greater(conn->ack, th_seq(th)) &&
+				   net_tcp_seq_greater(th_seq(th) + len, conn->ack)) {
+				/* Partly resent data, like a retransmission
+				 * that reaches past the out-of-order data
+				 * queued after a hole. Only the new data at
+				 * the end of the packet is passed on.
+				 */
+				len -= conn->ack - th_seq(th);
+
+				verdict = tcp_data_received(conn, pkt, &len);
+				if (verdict == NET_OK) {
+					/* net_pkt owned by the recv fifo now */
+					pkt = NULL;
+				}
 			} else if (net_tcp_seq_greater(conn->ack, th_seq(th))) {
 				/* This should handle the acknowledgements of keep alive
 				 * packets and retransmitted data.
@@ -3133,7 +3544,10 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	if (net_pkt_gso_size(pkt)) {
+		/* Completed for each segment once the packet is cut */
+		tcp_hdr->chksum = net_tcp_gso_pseudo_chksum(pkt);
+	} else if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -3499,6 +3913,13 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = set_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+		ret = set_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -3524,6 +3945,13 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = get_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+		ret = get_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief TCP congestion control
+ *
+ * Slow start, congestion avoidance and fast recovery as described in
+ * RFC 5681 and RFC 6582, with the NewReno and CUBIC (RFC 8312) window
+ * growth functions.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "net_stats.h"
+#include "tcp_internal.h"
+
+/* RFC 6928 initial window */
+#define TCP_CC_INIT_WND(_mss) MIN(10U * (_mss), MAX(2U * (_mss), 14600U))
+
+/* Before the first loss, slow start until the largest window the peer
+ * could ever announce.
+ */
+#define TCP_CC_INIT_SSTHRESH UINT16_MAX
+
+static void tcp_cc_grow(struct tcp *conn, uint32_t inc)
+{
+	/* The peer's window never gets larger than send_win_max, so
+	 * don't let cwnd grow past it while the sender is window limited.
+	 */
+	conn->cwnd = MIN(conn->cwnd + inc, MAX(conn->send_win_max, conn->cwnd));
+}
+
+static void newreno_init(struct tcp *conn)
+{
+	conn->bytes_acked = 0;
+}
+
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	/* One segment per window of acknowledged data, RFC 5681 3.1 */
+	conn->bytes_acked += acked;
+	if (conn->bytes_acked >= conn->cwnd) {
+		conn->bytes_acked -= conn->cwnd;
+		tcp_cc_grow(conn, conn_mss(conn));
+	}
+}
+
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	/* RFC 5681, equation (4) */
+	return MAX((uint32_t)conn->unacked_len / 2, 2U * conn_mss(conn));
+}
+
+static const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.cong_avoid = newreno_cong_avoid,
+	.ssthresh = newreno_ssthresh,
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* Multiplicative decrease factor, 0.7 in units of 1/1024 */
+#define CUBIC_BETA 717
+/* Window increase by 3 * (1 - beta) / (1 + beta) segments per window
+ * in the TCP friendly region, in units of 1/1024.
+ */
+#define CUBIC_ALPHA 542
+/* Ignore the time past this many ms from w_max, so that the cube of the
+ * distance can't overflow.
+ */
+#define CUBIC_MAX_DELTA_MS 100000
+
+/* Largest x so that x^3 <= a, for a < 2^63 */
+static uint32_t cubic_root(uint64_t a)
+{
+	uint32_t x = 0U;
+
+	for (int bit = 20; bit >= 0; bit--) {
+		uint64_t y = x | BIT(bit);
+
+		if (y * y * y <= a) {
+			x = y;
+		}
+	}
+
+	return x;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	memset(&conn->cubic, 0, sizeof(conn->cubic));
+	conn->bytes_acked = 0;
+}
+
+/* W_cubic(t) = C * (t - K)^3 + W_max, RFC 8312 4.1, with C = 0.4 and
+ * the windows in bytes instead of segments.
+ */
+static uint32_t cubic_window(struct tcp *conn, uint32_t t)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+	int64_t delta = (int64_t)t - cubic->k;
+	int64_t w;
+
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+	w = delta * delta * delta / 1000000;
+	w = cubic->w_max + w * 4 * conn_mss(conn) / 10000;
+
+	return CLAMP(w, 0, UINT32_MAX);
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t target;
+	uint32_t inc;
+
+	if (cubic->epoch_start == 0U) {
+		/* First ACK since the last reduction: K is the time it
+		 * takes the cubic function to get back to w_max.
+		 */
+		cubic->epoch_start = now ? now : 1U;
+		if (conn->cwnd < cubic->w_max) {
+			cubic->k = cubic_root((uint64_t)(cubic->w_max - conn->cwnd) *
+					      2500000000ULL / mss);
+		} else {
+			cubic->k = 0U;
+			cubic->w_max = conn->cwnd;
+		}
+
+		cubic->w_est = conn->cwnd;
+	}
+
+	target = cubic_window(conn, now - cubic->epoch_start);
+
+	/* Never grow slower than NewReno would, RFC 8312 4.2 */
+	cubic->w_est += (uint64_t)acked * mss * CUBIC_ALPHA / 1024 / conn->cwnd;
+	target = MAX(target, cubic->w_est);
+
+	if (target <= conn->cwnd) {
+		return;
+	}
+
+	/* Reach the target in about one window of ACKs, but grow at most
+	 * half as fast as slow start, RFC 8312 4.3 and 4.4.
+	 */
+	inc = (uint64_t)(target - conn->cwnd) * acked / conn->cwnd;
+	tcp_cc_grow(conn, MIN(inc, acked / 2));
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+
+	cubic->epoch_start = 0U;
+
+	/* Fast convergence, RFC 8312 4.6: if the window could not even get
+	 * back to where the previous loss happened, release bandwidth for
+	 * new flows by remembering a lower w_max.
+	 */
+	if (conn->cwnd < cubic->w_last_max) {
+		cubic->w_max = conn->cwnd * (1024 + CUBIC_BETA) / 2048;
+	} else {
+		cubic->w_max = conn->cwnd;
+	}
+
+	cubic->w_last_max = conn->cwnd;
+
+	return MAX(conn->cwnd * CUBIC_BETA / 1024, 2U * conn_mss(conn));
+}
+
+static const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.cong_avoid = cubic_cong_avoid,
+	.ssthresh = cubic_ssthresh,
+};
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
+
+static const struct tcp_cc_ops *const tcp_cc_algos[] = {
+	&tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+	&tcp_cc_cubic,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+#define TCP_CC_DEFAULT (&tcp_cc_cubic)
+#else
+#define TCP_CC_DEFAULT (&tcp_cc_newreno)
+#endif
+
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len)
+{
+	len = strnlen(name, len);
+
+	for (int i = 0; i < ARRAY_SIZE(tcp_cc_algos); i++) {
+		if (strlen(tcp_cc_algos[i]->name) == len &&
+		    strncmp(tcp_cc_algos[i]->name, name, len) == 0) {
+			return tcp_cc_algos[i];
+		}
+	}
+
+	return NULL;
+}
+
+void tcp_cc_select(struct tcp *conn, const struct tcp_cc_ops *cc)
+{
+	conn->cc = cc ? cc : TCP_CC_DEFAULT;
+	conn->cc->init(conn);
+}
+
+void tcp_cc_start(struct tcp *conn)
+{
+	conn->cwnd = TCP_CC_INIT_WND(conn_mss(conn));
+	conn->ssthresh = TCP_CC_INIT_SSTHRESH;
+	conn->in_recovery = false;
+	conn->cc->init(conn);
+}
+
+/* Called after the acknowledged data has been removed from the send
+ * queue. Returns true on a partial acknowledgment during fast recovery,
+ * when the caller is to retransmit the first unacknowledged segment.
+ */
+bool tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, conn->recover) >= 0) {
+			/* Full acknowledgment, RFC 6582 3.2 step 3 */
+			conn->cwnd = MIN(conn->ssthresh,
+					 MAX((uint32_t)conn->unacked_len, mss) + mss);
+			conn->in_recovery = false;
+
+			return false;
+		}
+
+		/* Partial acknowledgment, RFC 6582 3.2 step 4: deflate by
+		 * the amount acknowledged, then add back one segment for the
+		 * retransmission.
+		 */
+		conn->cwnd -= MIN(conn->cwnd, acked);
+		if (acked >= mss) {
+			conn->cwnd += mss;
+		}
+
+		conn->cwnd = MAX(conn->cwnd, mss);
+
+		return true;
+	}
+
+	if (conn->cwnd < conn->ssthresh) {
+		/* Slow start with appropriate byte counting, RFC 3465 */
+		tcp_cc_grow(conn, MIN(acked, 2U * mss));
+	} else {
+		conn->cc->cong_avoid(conn, acked);
+	}
+
+	return false;
+}
+
+/* Three duplicate ACKs, the caller retransmits the first unacknowledged
+ * segment.
+ */
+void tcp_cc_fast_recovery(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->ssthresh = conn->cc->ssthresh(conn);
+	conn->cwnd = conn->ssthresh + 3U * mss;
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->bytes_acked = 0;
+	conn->in_recovery = true;
+
+	NET_DBG("conn: %p cwnd=%u ssthresh=%u", conn, conn->cwnd,
+		conn->ssthresh);
+
+	net_stats_update_tcp_fast_recovery(conn->iface);
+}
+
+/* Each further duplicate ACK during fast recovery means another segment
+ * has left the network.
+ */
+void tcp_cc_dup_ack(struct tcp *conn)
+{
+	if (conn->in_recovery) {
+		conn->cwnd += conn_mss(conn);
+	}
+}
+
+/* Only the first timeout of a series lowers ssthresh, RFC 5681 3.1 */
+void tcp_cc_timeout(struct tcp *conn, bool first)
+{
+	if (first) {
+		conn->ssthresh = conn->cc->ssthresh(conn);
+	}
+
+	conn->cwnd = conn_mss(conn);
+	conn->bytes_acked = 0;
+	conn->in_recovery = false;
+
+	NET_DBG("conn: %p cwnd=%u ssthresh=%u", conn, conn->cwnd,
+		conn->ssthresh);
+
+	net_stats_update_tcp_rto(conn->iface);
+}
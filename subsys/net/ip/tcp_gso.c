@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief TCP generic segmentation offload
+ *
+ * TCP passes several segments of new data down the stack as one large
+ * packet. Unless the driver segments it in hardware, the packet is cut
+ * here right before the L2 sends it: every segment gets a copy of the
+ * IP and TCP headers with the lengths, sequence number and flags fixed
+ * up, and the payload buffers are moved over instead of copied whenever
+ * the segment boundaries match the buffer boundaries, as they do for
+ * the packets built by TCP.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_if.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#define GSO_ALLOC_TIMEOUT K_MSEC(CONFIG_NET_TCP_PKT_ALLOC_TIMEOUT)
+
+static uint16_t gso_fold(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+uint16_t net_tcp_gso_pseudo_chksum(struct net_pkt *pkt)
+{
+	uint16_t sum = 0U;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		sum = calc_chksum(IPPROTO_TCP, NET_IPV4_HDR(pkt)->src,
+				  2 * sizeof(struct in_addr));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		sum = calc_chksum(IPPROTO_TCP, NET_IPV6_HDR(pkt)->src,
+				  2 * sizeof(struct in6_addr));
+	}
+
+	return htons(sum);
+}
+
+/* Sum the data of a buffer chain from offset on. A word split over two
+ * buffers is completed with the first byte of the next one, as
+ * pkt_calc_chksum() does.
+ */
+static uint16_t gso_chksum_data(uint16_t sum, struct net_buf *buf,
+				size_t offset)
+{
+	bool odd = false;
+
+	for (; buf; buf = buf->frags) {
+		const uint8_t *data = buf->data;
+		size_t len = buf->len;
+
+		if (offset >= len) {
+			offset -= len;
+			continue;
+		}
+
+		data += offset;
+		len -= offset;
+		offset = 0;
+
+		if (odd) {
+			sum = gso_fold((uint32_t)sum + *data);
+			data++;
+			len--;
+		}
+
+		sum = calc_chksum(sum, data, len);
+		odd = (len & 1U) != 0U;
+	}
+
+	return sum;
+}
+
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t hdr[NET_TCP_GSO_HDR_MAX];
+	bool calc = net_if_need_calc_tx_checksum(iface);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t mss = net_pkt_gso_size(pkt);
+	bool shared = pkt->buffer->ref > 1;
+	struct net_ipv4_hdr *ipv4_hdr = NULL;
+	struct net_tcp_hdr *th;
+	struct net_buf *prev = NULL;
+	struct net_buf *cur = pkt->buffer;
+	struct net_pkt *seg = NULL;
+	uint16_t ip_chksum = 0U;
+	uint16_t ip_total = 0U;
+	uint16_t pseudo;
+	uint16_t hdr_sum;
+	size_t hdr_len;
+	size_t data_len;
+	size_t off;
+	uint32_t seq;
+	uint8_t flags;
+	int sent = 0;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+
+	if (ip_len + sizeof(*th) > sizeof(hdr) ||
+	    net_pkt_read(pkt, hdr, ip_len + sizeof(*th))) {
+		return -EINVAL;
+	}
+
+	th = (struct net_tcp_hdr *)(hdr + ip_len);
+	hdr_len = ip_len + (th->offset >> 4) * 4U;
+
+	if (hdr_len > sizeof(hdr) || hdr_len < ip_len + sizeof(*th) ||
+	    net_pkt_read(pkt, hdr + ip_len + sizeof(*th),
+			 hdr_len - ip_len - sizeof(*th))) {
+		return -EINVAL;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ipv4_hdr = (struct net_ipv4_hdr *)hdr;
+		ip_chksum = ipv4_hdr->chksum;
+		ip_total = ipv4_hdr->len;
+	}
+
+	/* The checksum field holds the pseudo header sum without the
+	 * length. The TCP header is summed once with a zero sequence number
+	 * and no flags, which are added back for each segment.
+	 */
+	pseudo = ntohs(th->chksum);
+	seq = sys_get_be32(th->seq);
+	flags = th->flags;
+
+	th->chksum = 0U;
+	th->flags = 0U;
+	memset(th->seq, 0, sizeof(th->seq));
+	hdr_sum = calc_chksum(0U, (uint8_t *)th, hdr_len - ip_len);
+
+	/* Find where the payload starts */
+	off = hdr_len;
+	while (cur && off >= cur->len) {
+		off -= cur->len;
+		prev = cur;
+		cur = cur->frags;
+	}
+
+	for (size_t done = 0; done < data_len; done += mss) {
+		size_t len = MIN(mss, data_len - done);
+		uint32_t seg_seq = seq + done;
+		struct net_buf *end = NULL;
+
+		/* Move the buffers if they hold exactly this segment */
+		if (!shared && prev && off == 0U) {
+			size_t acc = 0;
+
+			for (end = cur; end && acc + end->len < len;
+			     end = end->frags) {
+				acc += end->len;
+			}
+
+			if (end && acc + end->len != len) {
+				end = NULL;
+			}
+		}
+
+		seg = net_pkt_alloc_with_buffer(iface,
+						end ? hdr_len : hdr_len + len,
+						AF_UNSPEC, 0, GSO_ALLOC_TIMEOUT);
+		if (!seg) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		net_pkt_copy_attributes(pkt, seg);
+		net_pkt_set_gso_size(seg, 0U);
+
+		if (ipv4_hdr) {
+			ipv4_hdr->len = htons(hdr_len + len);
+
+			if (calc) {
+				ipv4_hdr->chksum = net_chksum_update16(
+					ip_chksum, ip_total, ipv4_hdr->len);
+			}
+		} else {
+			struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)hdr;
+
+			ipv6_hdr->len = htons(hdr_len + len - NET_IPV6H_LEN);
+		}
+
+		sys_put_be32(seg_seq, th->seq);
+		th->flags = (done + len == data_len) ? flags :
+			    flags & ~(PSH | FIN);
+
+		ret = net_pkt_write(seg, hdr, hdr_len);
+		if (ret < 0) {
+			goto out;
+		}
+
+		if (end) {
+			prev->frags = end->frags;
+			end->frags = NULL;
+			net_pkt_append_buffer(seg, cur);
+			cur = prev->frags;
+		} else {
+			size_t left = len;
+
+			while (left > 0U && cur) {
+				size_t n = MIN(cur->len - off, left);
+
+				ret = net_pkt_write(seg, cur->data + off, n);
+				if (ret < 0) {
+					goto out;
+				}
+
+				left -= n;
+				off += n;
+
+				if (off == cur->len) {
+					prev = cur;
+					cur = cur->frags;
+					off = 0;
+				}
+			}
+
+			if (left > 0U) {
+				ret = -EINVAL;
+				goto out;
+			}
+		}
+
+		if (calc) {
+			uint16_t sum;
+
+			sum = gso_fold((uint32_t)pseudo + hdr_len - ip_len + len +
+				       hdr_sum + (seg_seq >> 16) +
+				       (seg_seq & 0xffff) + th->flags);
+			sum = gso_chksum_data(sum, seg->buffer, hdr_len);
+			sum = (sum == 0U) ? 0xffff : htons(sum);
+			sum = ~sum;
+
+			net_pkt_cursor_init(seg);
+			net_pkt_set_overwrite(seg, true);
+			net_pkt_skip(seg, ip_len + offsetof(struct net_tcp_hdr,
+							    chksum));
+			ret = net_pkt_write(seg, &sum, sizeof(sum));
+			if (ret < 0) {
+				goto out;
+			}
+		}
+
+		net_pkt_cursor_init(seg);
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			goto out;
+		}
+
+		seg = NULL;
+		sent += ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+
+out:
+	if (seg) {
+		net_pkt_unref(seg);
+	}
+
+	NET_DBG("Cannot send segment of %p (%d)", pkt, ret);
+
+	return ret;
+}
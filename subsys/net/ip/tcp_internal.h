@@ -32,6 +32,7 @@ extern "C" {
 
 enum tcp_conn_option {
 	TCP_OPT_NODELAY	= 1,
+	TCP_OPT_CONGESTION = 2,
 };
 
 /**
@@ -258,6 +259,47 @@ static inline int net_tcp_finalize(struct net_pkt *pkt)
 }
 #endif
 
+/* Longest IP and TCP header a large TCP packet can have */
+#define NET_TCP_GSO_HDR_MAX 128
+
+/**
+ * @brief Checksum field of a large TCP packet, the sum of the pseudo header
+ *        without the length, which is added for each segment.
+ *
+ * @param pkt Network packet, with the IP header in place
+ *
+ * @return Value of the TCP checksum field
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+uint16_t net_tcp_gso_pseudo_chksum(struct net_pkt *pkt);
+#else
+static inline uint16_t net_tcp_gso_pseudo_chksum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+	return 0;
+}
+#endif
+
+/**
+ * @brief Cut a large TCP packet into segments of net_pkt_gso_size() bytes
+ *        of payload and send them with the L2 of the interface.
+ *
+ * @param iface Network interface
+ * @param pkt Network packet, released if all the segments could be sent
+ *
+ * @return Number of bytes sent on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
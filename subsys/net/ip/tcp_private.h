@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/sys/rb.h>
+
 #include "tp.h"
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
@@ -209,25 +211,91 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Without timestamps, four SACK blocks fit in the 40 bytes of options */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+#ifdef CONFIG_NET_TCP_SACK
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+#endif
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#ifdef CONFIG_NET_TCP_SACK
+	/* Blocks of the segment being processed */
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+};
+
+/* A range of out-of-order data in the receive queue. The ranges neither
+ * overlap nor touch, adjacent ones are merged.
+ */
+struct tcp_ooo_seg {
+	struct rbnode node;
+	struct net_buf *buf;
+	uint32_t seq;
+	uint32_t len;
+};
+
+#ifdef CONFIG_NET_TCP_SACK
+/* Ranges above the cumulative ACK the peer reported to hold */
+#define TCP_SACK_SCOREBOARD_SIZE 8
+#endif
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+struct tcp;
+
+/* Longest congestion control algorithm name, without the terminator */
+#define TCP_CC_NAME_MAX 15
+
+/* A congestion control algorithm. The generic part in tcp_cc.c takes care
+ * of slow start, of fast recovery and of the loss window after a timeout,
+ * the algorithm decides how the window grows in congestion avoidance and
+ * by how much it shrinks on loss. All callbacks are called with the
+ * connection locked. Windows are in bytes.
+ */
+struct tcp_cc_ops {
+	const char *name;
+	/* Reset the algorithm state of the connection */
+	void (*init)(struct tcp *conn);
+	/* @acked new bytes were acknowledged with cwnd >= ssthresh */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+	/* Return the slow start threshold to use after a loss */
+	uint32_t (*ssthresh)(struct tcp *conn);
 };
 
+struct tcp_cubic {
+	uint32_t epoch_start;	/* ms, 0 until the first ACK after a loss */
+	uint32_t k;		/* ms from epoch_start to w_max */
+	uint32_t w_max;		/* window before the last reduction */
+	uint32_t w_last_max;	/* w_max before that, for fast convergence */
+	uint32_t w_est;		/* window NewReno would have by now */
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
 	struct net_pkt *send_data;
-	struct net_pkt *queue_recv_data;
+	struct rbtree recv_queue; /* out-of-order data, struct tcp_ooo_seg */
 	struct net_if *iface;
 	void *recv_user_data;
 	sys_slist_t send_queue;
@@ -277,12 +345,30 @@ struct tcp { /* TCP connection */
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	const struct tcp_cc_ops *cc;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t recover; /* highest sequence sent when fast recovery began */
+	uint32_t bytes_acked; /* acknowledged since cwnd last grew */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+	struct tcp_cubic cubic;
+#endif
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sacked[TCP_SACK_SCOREBOARD_SIZE];
+	uint8_t sacked_count;
+	uint32_t sack_last_seq; /* latest out-of-order segment received */
 #endif
 	uint8_t zwp_retries;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
 	bool tcp_nodelay : 1;
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	bool in_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -302,3 +388,19 @@ struct tcp { /* TCP connection */
 	_flags(_fl, _op, _mask, strlen("" #_args) ? _args : true)
 
 typedef void (*net_tcp_cb_t)(struct tcp *conn, void *user_data);
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len);
+void tcp_cc_select(struct tcp *conn, const struct tcp_cc_ops *cc);
+void tcp_cc_start(struct tcp *conn);
+bool tcp_cc_ack(struct tcp *conn, uint32_t acked);
+void tcp_cc_fast_recovery(struct tcp *conn);
+void tcp_cc_dup_ack(struct tcp *conn);
+void tcp_cc_timeout(struct tcp *conn, bool first);
+#else
+#define tcp_cc_select(...)
+#define tcp_cc_start(...)
+#define tcp_cc_fast_recovery(...)
+#define tcp_cc_dup_ack(...)
+#define tcp_cc_timeout(...)
+#endif
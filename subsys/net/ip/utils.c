@@ -26,6 +26,8 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/socketcan.h>
 
+#include "net_private.h"
+
 char *net_sprint_addr(sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -505,6 +507,81 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+#if defined(CONFIG_NET_IP_CHKSUM_SSE2)
+#define chksum_words net_chksum_words_sse2
+#else
+/* Sum of the 32-bit words in the first len & ~3 bytes at p. Adding up
+ * 32 or 64-bit words gives the same result modulo 0xffff as adding up
+ * 16-bit words, as long as every carry out of the accumulator is added
+ * back in.
+ */
+static uint64_t chksum_words(const uint32_t *p, size_t len)
+{
+	uint64_t sum = 0U;
+
+#if defined(CONFIG_64BIT)
+	const uint64_t *q;
+	uint64_t sum_a = 0U, sum_b = 0U;
+	uint32_t carry = 0U;
+
+	if ((((uintptr_t)p & 0x04) != 0) && (len >= sizeof(uint32_t))) {
+		sum = *p++;
+		len -= sizeof(uint32_t);
+	}
+
+	q = (const uint64_t *)p;
+
+	/* Two accumulators, so that the additions can run in parallel */
+	while (len >= sizeof(uint64_t) * 4) {
+		uint64_t a = q[0] + q[2];
+		uint64_t b = q[1] + q[3];
+
+		carry += (a < q[0]) + (b < q[1]);
+		sum_a += a;
+		sum_b += b;
+		carry += (sum_a < a) + (sum_b < b);
+		q += 4;
+		len -= sizeof(uint64_t) * 4;
+	}
+
+	while (len >= sizeof(uint64_t)) {
+		sum_a += *q;
+		carry += sum_a < *q;
+		q++;
+		len -= sizeof(uint64_t);
+	}
+
+	/* 2^64 is 1 modulo 0xffff */
+	sum += (sum_a & UINT32_MAX) + (sum_a >> 32) +
+	       (sum_b & UINT32_MAX) + (sum_b >> 32) + carry;
+	p = (const uint32_t *)q;
+#else
+	size_t i = 0;
+
+	/* Do loop unrolling for the very large data sets */
+	while (len >= sizeof(uint32_t) * 4) {
+		uint64_t sum_a = p[i];
+		uint64_t sum_b = p[i + 1];
+
+		len -= sizeof(uint32_t) * 4;
+		sum_a += p[i + 2];
+		sum_b += p[i + 3];
+		i += 4;
+		sum += sum_a + sum_b;
+	}
+
+	p += i;
+#endif
+
+	while (len >= sizeof(uint32_t)) {
+		sum += *p++;
+		len -= sizeof(uint32_t);
+	}
+
+	return sum;
+}
+#endif /* CONFIG_NET_IP_CHKSUM_SSE2 */
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -515,8 +592,6 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
 	uint64_t sum;
-	uint32_t *p;
-	size_t i = 0;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
 
@@ -540,24 +615,11 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
-	p = (uint32_t *)data;
 
-	/* Do loop unrolling for the very large data sets */
-	while (pending >= sizeof(uint32_t) * 4) {
-		uint64_t sum_a = p[i];
-		uint64_t sum_b = p[i + 1];
+	sum += chksum_words((const uint32_t *)data, pending);
+	data += pending & ~(sizeof(uint32_t) - 1);
+	pending &= sizeof(uint32_t) - 1;
 
-		pending -= sizeof(uint32_t) * 4;
-		sum_a += p[i + 2];
-		sum_b += p[i + 3];
-		i += 4;
-		sum += sum_a + sum_b;
-	}
-	while (pending >= sizeof(uint32_t)) {
-		pending -= sizeof(uint32_t);
-		sum = sum + p[i++];
-	}
-	data = (uint8_t *)(p + i);
 	if (pending >= 2) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
@@ -582,6 +644,29 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+/* Incremental update as in RFC 1624, equation 3: HC' = ~(~HC + ~m + m') */
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len)
+{
+	const uint8_t *old_ptr = old_data;
+	const uint8_t *new_ptr = new_data;
+	uint32_t sum = (uint16_t)~chksum;
+
+	for (size_t i = 0; i + 1 < len; i += sizeof(uint16_t)) {
+		uint16_t old_val = UNALIGNED_GET((uint16_t *)(old_ptr + i));
+		uint16_t new_val = UNALIGNED_GET((uint16_t *)(new_ptr + i));
+
+		sum += (uint16_t)~old_val;
+		sum += new_val;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return ~sum;
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
@@ -284,6 +284,18 @@ static ssize_t sock_dispatch_sendmsg_vmeth(void *obj, const struct msghdr *msg,
 	return zsock_sendmsg(fd, msg, flags);
 }
 
+static ssize_t sock_dispatch_recvmsg_vmeth(void *obj, struct msghdr *msg,
+					   int flags)
+{
+	int fd = sock_dispatch_default(obj);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	return zsock_recvmsg(fd, msg, flags);
+}
+
 static ssize_t sock_dispatch_recvfrom_vmeth(void *obj, void *buf,
 					    size_t max_len, int flags,
 					    struct sockaddr *addr,
@@ -421,6 +433,7 @@ static const struct socket_op_vtable sock_dispatch_fd_op_vtable = {
 	.sendto = sock_dispatch_sendto_vmeth,
 	.sendmsg = sock_dispatch_sendmsg_vmeth,
 	.recvfrom = sock_dispatch_recvfrom_vmeth,
+	.recvmsg = sock_dispatch_recvmsg_vmeth,
 	.getsockopt = sock_dispatch_getsockopt_vmeth,
 	.setsockopt = sock_dispatch_setsockopt_vmeth,
 	.getpeername = sock_dispatch_getpeername_vmeth,
@@ -52,6 +52,10 @@ __net_socket struct spair {
 	struct k_poll_signal readable;
 	/** indicates local @a recv_q isn't full */
 	struct k_poll_signal writeable;
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	/** epoll registrations of the local endpoint */
+	sys_slist_t epoll_watchers;
+#endif
 	/** buffer for @a recv_q recv_q */
 	uint8_t buf[CONFIG_NET_SOCKETPAIR_BUFFER_SIZE];
 };
@@ -59,6 +63,18 @@ __net_socket struct spair {
 /* forward declaration */
 static const struct socket_op_vtable spair_fd_op_vtable;
 
+/* Tell the epoll instances the endpoint is registered with that it may
+ * have become ready.
+ */
+static inline void spair_epoll_notify(struct spair *spair)
+{
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	zsock_epoll_notify(&spair->epoll_watchers);
+#else
+	ARG_UNUSED(spair);
+#endif
+}
+
 #undef sock_is_nonblock
 /** Determine if a @ref spair is in non-blocking mode */
 static inline bool sock_is_nonblock(const struct spair *spair)
@@ -177,6 +193,7 @@ static void spair_delete(struct spair *spair)
 				__ASSERT(res == 0,
 					"k_poll_signal_raise() failed: %d",
 					res);
+				spair_epoll_notify(remote);
 			}
 		}
 	}
@@ -186,6 +203,10 @@ static void spair_delete(struct spair *spair)
 	res = k_poll_signal_raise(&spair->writeable, SPAIR_SIG_CANCEL);
 	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
 
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	zsock_epoll_detach(&spair->epoll_watchers);
+#endif
+
 	/* ensure no private information is released to the memory pool */
 	memset(spair, 0, sizeof(*spair));
 #ifdef CONFIG_USERSPACE
@@ -239,6 +260,9 @@ static struct spair *spair_new(void)
 	k_pipe_init(&spair->recv_q, spair->buf, sizeof(spair->buf));
 	k_poll_signal_init(&spair->readable);
 	k_poll_signal_init(&spair->writeable);
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+	sys_slist_init(&spair->epoll_watchers);
+#endif
 
 	/* A new socket is always writeable after creation */
 	res = k_poll_signal_raise(&spair->writeable, SPAIR_SIG_DATA);
@@ -540,6 +564,7 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 
 	res = k_poll_signal_raise(&remote->readable, SPAIR_SIG_DATA);
 	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+	spair_epoll_notify(remote);
 
 	res = bytes_written;
 
@@ -715,6 +740,18 @@ static ssize_t spair_read(void *obj, void *buffer, size_t count)
 	if (is_connected) {
 		res = k_poll_signal_raise(&spair->writeable, SPAIR_SIG_DATA);
 		__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+		/* The remote endpoint can write again. It cannot be deleted
+		 * meanwhile as that takes the local semaphore.
+		 */
+		struct spair *remote = z_get_fd_obj(spair->remote,
+			(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
+
+		if (remote != NULL) {
+			spair_epoll_notify(remote);
+		}
+#endif
 	}
 
 	res = bytes_read;
@@ -954,6 +991,20 @@ static int spair_ioctl(void *obj, unsigned int request, va_list args)
 			goto out;
 		}
 
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+		case ZFD_IOCTL_EPOLL_WATCH: {
+			struct zsock_epoll_watch *watch;
+
+			watch = va_arg(args, struct zsock_epoll_watch *);
+			watch->watchers = &spair->epoll_watchers;
+			watch->polled = 0;
+			watch->otype = K_OBJ_NET_SOCKET;
+
+			res = 0;
+			goto out;
+		}
+#endif
+
 		default: {
 			errno = EOPNOTSUPP;
 			res = -1;
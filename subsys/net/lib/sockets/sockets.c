@@ -153,6 +153,7 @@ static void zsock_flush_queue(struct net_context *ctx)
 
 	/* Some threads might be waiting on recv, cancel the wait */
 	k_fifo_cancel_wait(&ctx->recv_q);
+	sock_epoll_notify(ctx);
 }
 
 #if defined(CONFIG_NET_NATIVE)
@@ -197,6 +198,8 @@ static int zsock_socket_internal(int family, int type, int proto)
 	 */
 	k_condvar_init(&ctx->cond.recv);
 
+	sock_epoll_init(ctx);
+
 	/* TCP context is effectively owned by both application
 	 * and the stack: stack may detect that peer closed/aborted
 	 * connection, but it must not dispose of the context behind
@@ -262,6 +265,7 @@ int zsock_close_ctx(struct net_context *ctx)
 	}
 
 	zsock_flush_queue(ctx);
+	sock_epoll_detach(ctx);
 
 	SET_ERRNO(net_context_put(ctx));
 
@@ -352,8 +356,10 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 				       NULL);
 		k_fifo_init(&new_ctx->recv_q);
 		k_condvar_init(&new_ctx->cond.recv);
+		sock_epoll_init(new_ctx);
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		sock_epoll_notify(parent);
 
 		/* TCP context is effectively owned by both application
 		 * and the stack: stack may detect that peer closed/aborted
@@ -419,6 +425,7 @@ unlock:
 
 	/* Let reader to wake if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+	sock_epoll_notify(ctx);
 }
 
 int zsock_shutdown_ctx(struct net_context *ctx, int how)
@@ -927,90 +934,118 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+/* Free the copies made by zsock_sendmsg_user_copy() */
+static void zsock_sendmsg_user_free(struct msghdr *msg)
 {
-	struct msghdr msg_copy;
-	size_t i;
-	int ret;
+	k_free(msg->msg_name);
+	k_free(msg->msg_control);
 
-	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	if (msg->msg_iov) {
+		for (size_t i = 0; i < msg->msg_iovlen; i++) {
+			k_free(msg->msg_iov[i].iov_base);
+		}
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+		k_free(msg->msg_iov);
+	}
+}
 
-	msg_copy.msg_iov = z_user_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
-		errno = ENOMEM;
-		goto fail;
+/* Replace the user mode buffers a msghdr points to with kernel copies */
+static int zsock_sendmsg_user_copy(struct msghdr *msg)
+{
+	const struct iovec *iov = msg->msg_iov;
+	void *name = msg->msg_name;
+	void *control = msg->msg_control;
+	size_t iovlen = msg->msg_iovlen;
+
+	msg->msg_name = NULL;
+	msg->msg_control = NULL;
+	msg->msg_iov = NULL;
+	msg->msg_iovlen = 0;
+
+	if (iovlen > 0) {
+		if (Z_SYSCALL_MEMORY_ARRAY_READ(iov, iovlen,
+						sizeof(struct iovec))) {
+			errno = EFAULT;
+			return -1;
+		}
+
+		msg->msg_iov = k_calloc(iovlen, sizeof(struct iovec));
+		if (!msg->msg_iov) {
+			errno = ENOMEM;
+			return -1;
+		}
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
-			z_user_alloc_from_copy(msg->msg_iov[i].iov_base,
-					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+	for (size_t i = 0; i < iovlen; i++) {
+		struct iovec iov_copy;
+
+		if (z_user_from_copy(&iov_copy, &iov[i], sizeof(iov_copy))) {
+			errno = EFAULT;
+			goto fail;
+		}
+
+		/* Count the entry first so that it is freed on failure */
+		msg->msg_iovlen++;
+
+		if (iov_copy.iov_len == 0) {
+			continue;
+		}
+
+		msg->msg_iov[i].iov_base =
+			z_user_alloc_from_copy(iov_copy.iov_base,
+					       iov_copy.iov_len);
+		if (!msg->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg->msg_iov[i].iov_len = iov_copy.iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = z_user_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+		msg->msg_name = z_user_alloc_from_copy(name, msg->msg_namelen);
+		if (!msg->msg_name) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
 	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = z_user_alloc_from_copy(msg->msg_control,
+		msg->msg_control = z_user_alloc_from_copy(control,
 							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+		if (!msg->msg_control) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
-
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	return 0;
 
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
-	}
+fail:
+	zsock_sendmsg_user_free(msg);
 
-	k_free(msg_copy.msg_iov);
+	return -1;
+}
 
-	return ret;
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret;
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
-	}
+	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	if (zsock_sendmsg_user_copy(&msg_copy) < 0) {
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
-		}
+	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+				   flags);
 
-		k_free(msg_copy.msg_iov);
-	}
+	zsock_sendmsg_user_free(&msg_copy);
 
-	return -1;
+	return ret;
 }
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
@@ -1118,6 +1153,114 @@ error:
 	return ret;
 }
 
+#if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
+/* Store the destination address and interface of pkt as the ancillary
+ * data of msg, as IP_PKTINFO or IPV6_PKTINFO.
+ */
+static int sock_put_pkt_pktinfo(struct net_pkt *pkt, struct msghdr *msg,
+				size_t controllen)
+{
+	int ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+	struct cmsghdr *cmsg = msg->msg_control;
+	struct net_pkt_cursor backup;
+	size_t len;
+	int ret = 0;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		len = sizeof(struct in_pktinfo);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		len = sizeof(struct in6_pktinfo);
+	} else {
+		return -ENOTSUP;
+	}
+
+	if (cmsg == NULL || controllen < CMSG_SPACE(len)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+		struct in_pktinfo info = { 0 };
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (!ipv4_hdr) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		info.ipi_ifindex = ifindex;
+		net_ipv4_addr_copy_raw((uint8_t *)&info.ipi_addr, ipv4_hdr->dst);
+		info.ipi_spec_dst = info.ipi_addr;
+
+		cmsg->cmsg_level = IPPROTO_IP;
+		cmsg->cmsg_type = IP_PKTINFO;
+		memcpy(CMSG_DATA(cmsg), &info, sizeof(info));
+	} else {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+		struct in6_pktinfo info = { 0 };
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (!ipv6_hdr) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		info.ipi6_ifindex = ifindex;
+		net_ipv6_addr_copy_raw((uint8_t *)&info.ipi6_addr, ipv6_hdr->dst);
+
+		cmsg->cmsg_level = IPPROTO_IPV6;
+		cmsg->cmsg_type = IPV6_PKTINFO;
+		memcpy(CMSG_DATA(cmsg), &info, sizeof(info));
+	}
+
+	cmsg->cmsg_len = CMSG_LEN(len);
+	msg->msg_controllen = CMSG_SPACE(len);
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret;
+}
+#endif /* CONFIG_NET_CONTEXT_RECV_PKTINFO */
+
+/* Fill in the ancillary data of a datagram received with recvmsg() */
+static void sock_put_pkt_cmsg(struct net_context *ctx, struct net_pkt *pkt,
+			      struct msghdr *msg)
+{
+	size_t controllen = msg->msg_controllen;
+
+	msg->msg_controllen = 0;
+
+	/* Packets from an offloaded IP stack have no IP header */
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		return;
+	}
+
+#if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
+	int pktinfo = 0;
+
+	(void)net_context_get_option(ctx, NET_OPT_RECV_PKTINFO, &pktinfo,
+				     NULL);
+	if (pktinfo && sock_put_pkt_pktinfo(pkt, msg, controllen) < 0) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+	}
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(controllen);
+#endif
+}
+
 void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick)
 {
 	net_pkt_set_rx_stats_tick(pkt, end_tick);
@@ -1169,7 +1312,9 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
+/* Receive a datagram into buf, or into the buffers of msg if not NULL */
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       struct msghdr *msg,
 				       void *buf,
 				       size_t max_len,
 				       int flags,
@@ -1260,11 +1405,36 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
-	read_len = MIN(recv_len, max_len);
 
-	if (net_pkt_read(pkt, buf, read_len)) {
-		errno = ENOBUFS;
-		goto fail;
+	if (msg != NULL) {
+		msg->msg_flags = 0;
+		sock_put_pkt_cmsg(ctx, pkt, msg);
+
+		read_len = 0;
+
+		for (size_t i = 0; i < msg->msg_iovlen && read_len < recv_len;
+		     i++) {
+			size_t len = MIN(msg->msg_iov[i].iov_len,
+					 recv_len - read_len);
+
+			if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+				errno = ENOBUFS;
+				goto fail;
+			}
+
+			read_len += len;
+		}
+
+		if (read_len < recv_len) {
+			msg->msg_flags |= ZSOCK_MSG_TRUNC;
+		}
+	} else {
+		read_len = MIN(recv_len, max_len);
+
+		if (net_pkt_read(pkt, buf, read_len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
 	}
 
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
@@ -1420,7 +1590,8 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		return zsock_recv_dgram(ctx, NULL, buf, max_len, flags,
+					src_addr, addrlen);
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -1468,142 +1639,694 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-/* As this is limited function, we don't follow POSIX signature, with
- * "..." instead of last arg.
+/* A stream has no message boundaries, so fill the buffers in turn until
+ * one of them can't be filled right away.
  */
-int z_impl_zsock_fcntl(int sock, int cmd, int flags)
+static ssize_t zsock_recvmsg_stream(struct net_context *ctx,
+				    struct msghdr *msg, int flags)
 {
-	const struct socket_op_vtable *vtable;
-	struct k_mutex *lock;
-	void *obj;
-	int ret;
-
-	obj = get_sock_vtable(sock, &vtable, &lock);
-	if (obj == NULL) {
-		errno = EBADF;
-		return -1;
-	}
+	ssize_t recv_len = 0;
 
-	(void)k_mutex_lock(lock, K_FOREVER);
+	msg->msg_namelen = 0;
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
 
-	ret = z_fdtable_call_ioctl((const struct fd_op_vtable *)vtable,
-				   obj, cmd, flags);
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		struct iovec *iov = &msg->msg_iov[i];
+		ssize_t len;
 
-	k_mutex_unlock(lock);
+		if (iov->iov_len == 0) {
+			continue;
+		}
 
-	return ret;
-}
+		len = zsock_recv_stream(ctx, iov->iov_base, iov->iov_len,
+					flags);
+		if (len < 0) {
+			return (recv_len > 0) ? recv_len : -1;
+		}
 
-#ifdef CONFIG_USERSPACE
-static inline int z_vrfy_zsock_fcntl(int sock, int cmd, int flags)
-{
-	return z_impl_zsock_fcntl(sock, cmd, flags);
-}
-#include <syscalls/zsock_fcntl_mrsh.c>
-#endif
+		recv_len += len;
 
-static int zsock_poll_prepare_ctx(struct net_context *ctx,
-				  struct zsock_pollfd *pfd,
-				  struct k_poll_event **pev,
-				  struct k_poll_event *pev_end)
-{
-	if (pfd->events & ZSOCK_POLLIN) {
-		if (*pev == pev_end) {
-			return -ENOMEM;
+		/* Peeking again would return the same data */
+		if (len < iov->iov_len || (flags & ZSOCK_MSG_PEEK)) {
+			break;
 		}
 
-		(*pev)->obj = &ctx->recv_q;
-		(*pev)->type = K_POLL_TYPE_FIFO_DATA_AVAILABLE;
-		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
-		(*pev)->state = K_POLL_STATE_NOT_READY;
-		(*pev)++;
+		if (!(flags & ZSOCK_MSG_WAITALL)) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
 	}
 
-	if (pfd->events & ZSOCK_POLLOUT) {
-		if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
-		    net_context_get_type(ctx) == SOCK_STREAM &&
-		    !net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			if (*pev == pev_end) {
-				return -ENOMEM;
-			}
+	return recv_len;
+}
 
-			if (net_context_get_state(ctx) == NET_CONTEXT_CONNECTING) {
-				(*pev)->obj = net_tcp_conn_sem_get(ctx);
-			} else {
-				(*pev)->obj = net_tcp_tx_sem_get(ctx);
-			}
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	size_t max_len = 0;
 
-			(*pev)->type = K_POLL_TYPE_SEM_AVAILABLE;
-			(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
-			(*pev)->state = K_POLL_STATE_NOT_READY;
-			(*pev)++;
-		} else {
-			return -EALREADY;
-		}
+	if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0)) {
+		errno = EINVAL;
+		return -1;
+	}
 
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		max_len += msg->msg_iov[i].iov_len;
 	}
 
-	/* If socket is already in EOF or error, it can be reported
-	 * immediately, so we tell poll() to short-circuit wait.
-	 */
-	if (sock_is_eof(ctx) || sock_is_error(ctx)) {
-		return -EALREADY;
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg, NULL, max_len, flags,
+					msg->msg_name,
+					msg->msg_name ? &msg->msg_namelen : NULL);
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recvmsg_stream(ctx, msg, flags);
+	} else {
+		__ASSERT(0, "Unknown socket type");
 	}
 
 	return 0;
 }
 
-static int zsock_poll_update_ctx(struct net_context *ctx,
-				 struct zsock_pollfd *pfd,
-				 struct k_poll_event **pev)
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 {
-	ARG_UNUSED(ctx);
+	VTABLE_CALL(recvmsg, sock, msg, flags);
+}
 
-	if (pfd->events & ZSOCK_POLLIN) {
-		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
-			pfd->revents |= ZSOCK_POLLIN;
+#ifdef CONFIG_USERSPACE
+/* Check the buffers a user mode msghdr points to for writing, and replace
+ * its iovec array with a kernel copy.
+ */
+static int zsock_recvmsg_user_copy(struct msghdr *msg)
+{
+	struct iovec *iov = NULL;
+
+	if (msg->msg_iovlen > 0) {
+		if (Z_SYSCALL_MEMORY_ARRAY_READ(msg->msg_iov, msg->msg_iovlen,
+						sizeof(struct iovec))) {
+			errno = EFAULT;
+			return -1;
 		}
-		(*pev)++;
-	}
-	if (pfd->events & ZSOCK_POLLOUT) {
-		if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
-		    net_context_get_type(ctx) == SOCK_STREAM &&
-		    !net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			if ((*pev)->state != K_POLL_STATE_NOT_READY &&
-			    !sock_is_eof(ctx) &&
-			    (net_context_get_state(ctx) == NET_CONTEXT_CONNECTED)) {
-				pfd->revents |= ZSOCK_POLLOUT;
+
+		iov = z_user_alloc_from_copy(msg->msg_iov,
+					     msg->msg_iovlen * sizeof(struct iovec));
+		if (!iov) {
+			errno = ENOMEM;
+			return -1;
+		}
+
+		for (size_t i = 0; i < msg->msg_iovlen; i++) {
+			if (Z_SYSCALL_MEMORY_WRITE(iov[i].iov_base,
+						   iov[i].iov_len)) {
+				k_free(iov);
+				errno = EFAULT;
+				return -1;
 			}
-			(*pev)++;
-		} else {
-			pfd->revents |= ZSOCK_POLLOUT;
 		}
 	}
 
-	if (sock_is_error(ctx)) {
-		pfd->revents |= ZSOCK_POLLERR;
+	if ((msg->msg_name &&
+	     Z_SYSCALL_MEMORY_WRITE(msg->msg_name, msg->msg_namelen)) ||
+	    (msg->msg_control &&
+	     Z_SYSCALL_MEMORY_WRITE(msg->msg_control, msg->msg_controllen))) {
+		k_free(iov);
+		errno = EFAULT;
+		return -1;
 	}
 
-	if (sock_is_eof(ctx)) {
-		pfd->revents |= ZSOCK_POLLHUP;
-	}
+	msg->msg_iov = iov;
 
 	return 0;
 }
 
-static inline int time_left(uint32_t start, uint32_t timeout)
+/* Give the results of a receive back to the user mode msghdr */
+static void zsock_recvmsg_user_result(struct msghdr *umsg,
+				      const struct msghdr *msg)
 {
-	uint32_t elapsed = k_uptime_get_32() - start;
-
-	return timeout - elapsed;
+	Z_OOPS(z_user_to_copy(&umsg->msg_namelen, &msg->msg_namelen,
+			      sizeof(msg->msg_namelen)));
+	Z_OOPS(z_user_to_copy(&umsg->msg_controllen, &msg->msg_controllen,
+			      sizeof(msg->msg_controllen)));
+	Z_OOPS(z_user_to_copy(&umsg->msg_flags, &msg->msg_flags,
+			      sizeof(msg->msg_flags)));
 }
 
-int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
 {
-	bool retry;
-	int ret = 0;
-	int i;
-	struct zsock_pollfd *pfd;
+	struct msghdr msg_copy;
+	ssize_t ret;
+
+	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+
+	if (zsock_recvmsg_user_copy(&msg_copy) < 0) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+	if (ret >= 0) {
+		zsock_recvmsg_user_result(msg, &msg_copy);
+	}
+
+	k_free(msg_copy.msg_iov);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error is only reported if it hit the first message */
+	return (i > 0 || vlen == 0) ? (int)i : -1;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr,
+					      flags & ~ZSOCK_MSG_WAITFORONE);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error is only reported if it hit the first message */
+	return (i > 0 || vlen == 0) ? (int)i : -1;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	unsigned int copied;
+	int ret = -1;
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return 0;
+	}
+
+	msgvec_copy = z_user_alloc_from_copy(msgvec,
+					     vlen * sizeof(*msgvec));
+	if (!msgvec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (copied = 0; copied < vlen; copied++) {
+		if (zsock_sendmsg_user_copy(&msgvec_copy[copied].msg_hdr) < 0) {
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (int i = 0; i < ret; i++) {
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &msgvec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+out:
+	for (unsigned int i = 0; i < copied; i++) {
+		zsock_sendmsg_user_free(&msgvec_copy[i].msg_hdr);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	unsigned int copied;
+	int ret = -1;
+
+	vlen = MIN(vlen, CONFIG_NET_SOCKETS_MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return 0;
+	}
+
+	msgvec_copy = z_user_alloc_from_copy(msgvec,
+					     vlen * sizeof(*msgvec));
+	if (!msgvec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (copied = 0; copied < vlen; copied++) {
+		if (zsock_recvmsg_user_copy(&msgvec_copy[copied].msg_hdr) < 0) {
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (int i = 0; i < ret; i++) {
+		zsock_recvmsg_user_result(&msgvec[i].msg_hdr,
+					  &msgvec_copy[i].msg_hdr);
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &msgvec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+out:
+	for (unsigned int i = 0; i < copied; i++) {
+		k_free(msgvec_copy[i].msg_hdr.msg_iov);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+/* Point the iovec entries at the data after the cursor of pkt */
+static size_t zsock_recv_zc_fill(struct net_pkt *pkt, struct iovec *iov,
+				 size_t *iovlen)
+{
+	struct net_buf *buf = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	size_t len = 0;
+	size_t n = 0;
+
+	while (buf && n < *iovlen) {
+		size_t frag_len = buf->len - (pos - buf->data);
+
+		if (frag_len > 0) {
+			iov[n].iov_base = pos;
+			iov[n].iov_len = frag_len;
+			len += frag_len;
+			n++;
+		}
+
+		buf = buf->frags;
+		if (buf) {
+			pos = buf->data;
+		}
+	}
+
+	*iovlen = n;
+
+	return len;
+}
+
+static ssize_t zsock_recv_zerocopy_ctx(struct net_context *ctx,
+				       struct zsock_recv_zc *zc, int flags)
+{
+	const bool is_stream = net_context_get_type(ctx) == SOCK_STREAM;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t data_len, len;
+	int res;
+
+	zc->ctx = NULL;
+	zc->pkt = NULL;
+	zc->len = 0;
+
+	if (zc->iov == NULL || zc->iovlen == 0 ||
+	    (flags & (ZSOCK_MSG_PEEK | ZSOCK_MSG_WAITALL))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (is_stream) {
+		if (!net_context_is_used(ctx)) {
+			errno = EBADF;
+			return -1;
+		}
+
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	do {
+		if (is_stream && sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (is_stream && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			res = zsock_wait_data(ctx, &timeout);
+			if (res < 0) {
+				errno = -res;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (!pkt) {
+			if (is_stream && sock_is_error(ctx)) {
+				errno = POINTER_TO_INT(ctx->user_data);
+				return -1;
+			} else if (is_stream && sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		data_len = net_pkt_remaining_data(pkt);
+		if (data_len == 0) {
+			/* Nothing to hand out, like the packet marking the
+			 * end of the stream.
+			 */
+			k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			if (net_pkt_eof(pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			net_pkt_unref(pkt);
+		}
+	} while (data_len == 0);
+
+	len = zsock_recv_zc_fill(pkt, zc->iov, &zc->iovlen);
+
+	/* The caller's reference, dropped by zsock_recv_zerocopy_release() */
+	net_pkt_ref(pkt);
+
+	if (!is_stream || len == data_len) {
+		k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (is_stream && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		net_pkt_unref(pkt);
+	} else {
+		/* The rest of the segment is for the next call */
+		net_pkt_set_overwrite(pkt, true);
+		(void)net_pkt_skip(pkt, len);
+	}
+
+	/* Keep the context around so that the receive window can be
+	 * updated once the buffers are given back.
+	 */
+	net_context_ref(ctx);
+
+	zc->ctx = ctx;
+	zc->pkt = pkt;
+	zc->len = len;
+
+	return (!is_stream && (flags & ZSOCK_MSG_TRUNC)) ? data_len : len;
+}
+
+ssize_t zsock_recv_zerocopy(int sock, struct zsock_recv_zc *zc, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only sockets of the native stack hand out net_pkt buffers */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_zerocopy_ctx(ctx, zc, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recv_zerocopy_release(struct zsock_recv_zc *zc)
+{
+	struct net_context *ctx = zc->ctx;
+
+	if (zc->pkt == NULL) {
+		return;
+	}
+
+	net_pkt_unref(zc->pkt);
+	zc->pkt = NULL;
+
+	if (net_context_get_type(ctx) == SOCK_STREAM &&
+	    net_context_get_state(ctx) == NET_CONTEXT_CONNECTED) {
+		net_context_update_recv_wnd(ctx, zc->len);
+	}
+
+	net_context_unref(ctx);
+	zc->ctx = NULL;
+	zc->len = 0;
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZEROCOPY */
+
+/* As this is limited function, we don't follow POSIX signature, with
+ * "..." instead of last arg.
+ */
+int z_impl_zsock_fcntl(int sock, int cmd, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = z_fdtable_call_ioctl((const struct fd_op_vtable *)vtable,
+				   obj, cmd, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_fcntl(int sock, int cmd, int flags)
+{
+	return z_impl_zsock_fcntl(sock, cmd, flags);
+}
+#include <syscalls/zsock_fcntl_mrsh.c>
+#endif
+
+static int zsock_poll_prepare_ctx(struct net_context *ctx,
+				  struct zsock_pollfd *pfd,
+				  struct k_poll_event **pev,
+				  struct k_poll_event *pev_end)
+{
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		(*pev)->obj = &ctx->recv_q;
+		(*pev)->type = K_POLL_TYPE_FIFO_DATA_AVAILABLE;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+		    net_context_get_type(ctx) == SOCK_STREAM &&
+		    !net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+			if (*pev == pev_end) {
+				return -ENOMEM;
+			}
+
+			if (net_context_get_state(ctx) == NET_CONTEXT_CONNECTING) {
+				(*pev)->obj = net_tcp_conn_sem_get(ctx);
+			} else {
+				(*pev)->obj = net_tcp_tx_sem_get(ctx);
+			}
+
+			(*pev)->type = K_POLL_TYPE_SEM_AVAILABLE;
+			(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+			(*pev)->state = K_POLL_STATE_NOT_READY;
+			(*pev)++;
+		} else {
+			return -EALREADY;
+		}
+
+	}
+
+	/* If socket is already in EOF or error, it can be reported
+	 * immediately, so we tell poll() to short-circuit wait.
+	 */
+	if (sock_is_eof(ctx) || sock_is_error(ctx)) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+static int zsock_epoll_watch_ctx(struct net_context *ctx,
+				 struct zsock_epoll_watch *watch)
+{
+	watch->watchers = &ctx->epoll_watchers;
+	watch->otype = K_OBJ_NET_SOCKET;
+
+	/* The TCP stack makes a stream socket writable without telling the
+	 * socket, so that has to be polled.
+	 */
+	if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	    net_context_get_type(ctx) == SOCK_STREAM &&
+	    !net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		watch->polled = ZSOCK_POLLOUT;
+	} else {
+		watch->polled = 0;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
+static int zsock_poll_update_ctx(struct net_context *ctx,
+				 struct zsock_pollfd *pfd,
+				 struct k_poll_event **pev)
+{
+	ARG_UNUSED(ctx);
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+		(*pev)++;
+	}
+	if (pfd->events & ZSOCK_POLLOUT) {
+		if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+		    net_context_get_type(ctx) == SOCK_STREAM &&
+		    !net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+			if ((*pev)->state != K_POLL_STATE_NOT_READY &&
+			    !sock_is_eof(ctx) &&
+			    (net_context_get_state(ctx) == NET_CONTEXT_CONNECTED)) {
+				pfd->revents |= ZSOCK_POLLOUT;
+			}
+			(*pev)++;
+		} else {
+			pfd->revents |= ZSOCK_POLLOUT;
+		}
+	}
+
+	if (sock_is_error(ctx)) {
+		pfd->revents |= ZSOCK_POLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		pfd->revents |= ZSOCK_POLLHUP;
+	}
+
+	return 0;
+}
+
+static inline int time_left(uint32_t start, uint32_t timeout)
+{
+	uint32_t elapsed = k_uptime_get_32() - start;
+
+	return timeout - elapsed;
+}
+
+int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
+{
+	bool retry;
+	int ret = 0;
+	int i;
+	struct zsock_pollfd *pfd;
 	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
 	struct k_poll_event *pev;
 	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
@@ -1925,6 +2648,16 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		case TCP_NODELAY:
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION, optval,
+						 optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 
 		break;
@@ -1945,6 +2678,22 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IP_PKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval,
+							     optlen);
+				if (ret < 0) {
+					errno  = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -1966,6 +2715,22 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IPV6_RECVPKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval,
+							     optlen);
+				if (ret < 0) {
+					errno  = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2223,6 +2988,16 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_set_option(ctx,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+						 optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 		break;
 
@@ -2242,6 +3017,22 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IP_PKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval,
+							     optlen);
+				if (ret < 0) {
+					errno  = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2269,6 +3060,22 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case IPV6_RECVPKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_RECV_PKTINFO,
+							     optval,
+							     optlen);
+				if (ret < 0) {
+					errno  = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2529,6 +3336,16 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return zsock_poll_update_ctx(obj, pfd, pev);
 	}
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	case ZFD_IOCTL_EPOLL_WATCH: {
+		struct zsock_epoll_watch *watch;
+
+		watch = va_arg(args, struct zsock_epoll_watch *);
+
+		return zsock_epoll_watch_ctx(obj, watch);
+	}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
 	case ZFD_IOCTL_SET_LOCK: {
 		struct k_mutex *lock;
 
@@ -2593,6 +3410,11 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -2636,6 +3458,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 	.getpeername = sock_getpeername_vmeth,
@@ -0,0 +1,902 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/syscall_handler.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/net/socket_epoll.h>
+#include "sockets_internal.h"
+
+#define EPOLL_EVENTS_POLLED (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT)
+#define EPOLL_EVENTS_VALID (EPOLL_EVENTS_POLLED | ZSOCK_EPOLLERR | \
+			    ZSOCK_EPOLLHUP | ZSOCK_EPOLLONESHOT)
+
+/* The most k_poll events an object prepares for ZSOCK_POLLIN|ZSOCK_POLLOUT */
+#define EPOLL_OBJ_EVENTS_MAX 2
+
+/* A descriptor registered with an epoll instance. Its object, vtable and
+ * lock are looked up once, when it is added. The entry is also linked to
+ * the registrations of the object, which queues it to the ready list of
+ * the instance whenever it may have become ready: a wait only checks the
+ * queued entries.
+ */
+struct epoll_entry {
+	int fd; /* -1 when the slot is free */
+	uint32_t events;
+	zsock_epoll_data_t data;
+	void *obj;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	struct zsock_epoll *ep;
+
+	/* Registrations of the object, NULL once it was closed, and the
+	 * ready list node. Protected by epoll_lock.
+	 */
+	sys_slist_t *watchers;
+	sys_snode_t watch_node;
+	sys_dnode_t ready_node;
+	bool queued;
+
+	/* Events the object does not notify, polled during the waits, and
+	 * where the k_poll events of the wait in progress start.
+	 */
+	uint32_t polled;
+	sys_snode_t polled_node;
+	bool polling;
+	uint16_t ev_first;
+	uint16_t ev_count;
+	bool armed;
+
+	/* ZSOCK_EPOLLONESHOT reported, skipped until modified */
+	bool disabled;
+};
+
+struct zsock_epoll {
+	/* Protects the entries, taken by zsock_epoll_ctl() and by
+	 * zsock_epoll_wait() around, but not during, k_poll().
+	 */
+	struct k_mutex lock;
+	/* Serializes threads waiting on the same instance */
+	struct k_mutex wait_lock;
+	/* Signalled when the last waiter left a closed instance */
+	struct k_condvar idle;
+	/* Raised when an entry is queued and when the instance is closed */
+	struct k_poll_signal ready_sig;
+	/* Entries which may be ready, protected by epoll_lock */
+	sys_dlist_t ready;
+	/* Entries with events polled during the waits */
+	sys_slist_t polled;
+	struct epoll_entry entries[CONFIG_NET_SOCKETS_EPOLL_FDS_MAX];
+	struct k_poll_event poll_events[1 + EPOLL_OBJ_EVENTS_MAX *
+					CONFIG_NET_SOCKETS_EPOLL_FDS_MAX];
+	int count; /* Slots in use, including free ones below the last used */
+	int waiters;
+	bool closed;
+	bool in_use;
+};
+
+static struct zsock_epoll epolls[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static K_MUTEX_DEFINE(epolls_lock);
+
+/* Protects the registrations of the objects and the ready lists, which
+ * objects update from any context.
+ */
+static struct k_spinlock epoll_lock;
+
+/* Instances whose signal is to be raised once epoll_lock is released */
+static ATOMIC_DEFINE(epoll_raise_pending, CONFIG_NET_SOCKETS_EPOLL_MAX);
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static inline k_timeout_t epoll_timeout(int timeout)
+{
+	return timeout < 0 ? K_FOREVER : K_MSEC(timeout);
+}
+
+static void epoll_timeout_recalc(uint64_t end, k_timeout_t *timeout)
+{
+	if (!K_TIMEOUT_EQ(*timeout, K_NO_WAIT) &&
+	    !K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		int64_t remaining = end - sys_clock_tick_get();
+
+		if (remaining <= 0) {
+			*timeout = K_NO_WAIT;
+		} else {
+			*timeout = Z_TIMEOUT_TICKS(remaining);
+		}
+	}
+}
+
+/* Must be called with epoll_lock held */
+static void epoll_entry_queue(struct epoll_entry *entry)
+{
+	struct zsock_epoll *ep = entry->ep;
+
+	if (entry->queued) {
+		return;
+	}
+
+	sys_dlist_append(&ep->ready, &entry->ready_node);
+	entry->queued = true;
+	atomic_set_bit(epoll_raise_pending, ep - epolls);
+}
+
+/* Raising a signal may reschedule, which must not happen with a spinlock
+ * held: the instances to wake are only marked under epoll_lock.
+ */
+static void epoll_raise(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (atomic_test_and_clear_bit(epoll_raise_pending, i)) {
+			k_poll_signal_raise(&epolls[i].ready_sig, 0);
+		}
+	}
+}
+
+void zsock_epoll_notify(sys_slist_t *watchers)
+{
+	struct epoll_entry *entry;
+	k_spinlock_key_t key;
+
+	/* Most objects are not registered. One being registered meanwhile
+	 * is queued by zsock_epoll_ctl() anyway.
+	 */
+	if (sys_slist_is_empty(watchers)) {
+		return;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(watchers, entry, watch_node) {
+		epoll_entry_queue(entry);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	epoll_raise();
+}
+
+void zsock_epoll_detach(sys_slist_t *watchers)
+{
+	struct epoll_entry *entry;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	key = k_spin_lock(&epoll_lock);
+
+	/* The waits find the queued entries closed and drop them */
+	while ((node = sys_slist_get(watchers)) != NULL) {
+		entry = CONTAINER_OF(node, struct epoll_entry, watch_node);
+		entry->watchers = NULL;
+		epoll_entry_queue(entry);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	epoll_raise();
+}
+
+static bool epoll_entry_is_valid(struct epoll_entry *entry)
+{
+	const struct fd_op_vtable *vtable;
+	k_spinlock_key_t key;
+	bool closed;
+	void *obj;
+
+	key = k_spin_lock(&epoll_lock);
+	closed = (entry->watchers == NULL);
+	k_spin_unlock(&epoll_lock, key);
+
+	if (closed) {
+		return false;
+	}
+
+	obj = z_get_fd_obj_and_vtable(entry->fd, &vtable, NULL);
+
+	return obj == entry->obj && vtable == entry->vtable;
+}
+
+/* Keeps the entries with events the object does not notify, and only
+ * those, on the polled list of the instance.
+ */
+static void epoll_entry_polled_update(struct zsock_epoll *ep,
+				      struct epoll_entry *entry)
+{
+	bool polling = entry->fd >= 0 && !entry->disabled &&
+		       (entry->events & entry->polled & EPOLL_EVENTS_POLLED) != 0;
+
+	if (polling == entry->polling) {
+		return;
+	}
+
+	if (polling) {
+		sys_slist_append(&ep->polled, &entry->polled_node);
+	} else {
+		(void)sys_slist_find_and_remove(&ep->polled, &entry->polled_node);
+	}
+
+	entry->polling = polling;
+	entry->armed = false;
+}
+
+static void epoll_entry_remove(struct zsock_epoll *ep,
+			       struct epoll_entry *entry)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (entry->watchers != NULL) {
+		(void)sys_slist_find_and_remove(entry->watchers,
+						&entry->watch_node);
+		entry->watchers = NULL;
+	}
+
+	if (entry->queued) {
+		sys_dlist_remove(&entry->ready_node);
+		entry->queued = false;
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	entry->fd = -1;
+	epoll_entry_polled_update(ep, entry);
+
+	while (ep->count > 0 && ep->entries[ep->count - 1].fd < 0) {
+		ep->count--;
+	}
+}
+
+static struct epoll_entry *epoll_entry_find(struct zsock_epoll *ep, int fd)
+{
+	for (int i = 0; i < ep->count; i++) {
+		struct epoll_entry *entry = &ep->entries[i];
+
+		if (entry->fd != fd) {
+			continue;
+		}
+
+		if (!epoll_entry_is_valid(entry)) {
+			/* Closed, and the descriptor possibly reused */
+			epoll_entry_remove(ep, entry);
+			return NULL;
+		}
+
+		return entry;
+	}
+
+	return NULL;
+}
+
+/* Queues the entry for the next wait to check it */
+static void epoll_entry_requeue(struct epoll_entry *entry)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+	epoll_entry_queue(entry);
+	k_spin_unlock(&epoll_lock, key);
+
+	epoll_raise();
+}
+
+static int epoll_entry_add(struct zsock_epoll *ep, int fd,
+			   const struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_watch watch = { 0 };
+	const struct fd_op_vtable *vtable;
+	struct epoll_entry *entry = NULL;
+	struct k_mutex *lock;
+	k_spinlock_key_t key;
+	void *obj;
+	int ret;
+
+	obj = z_get_fd_obj_and_vtable(fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	for (int i = 0; i < ep->count; i++) {
+		if (ep->entries[i].fd < 0) {
+			entry = &ep->entries[i];
+			break;
+		}
+	}
+
+	if (entry == NULL && ep->count == ARRAY_SIZE(ep->entries)) {
+		errno = ENOSPC;
+		return -1;
+	}
+
+	/* The lock keeps the object from being closed until it is linked */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	/* Only objects notifying their readiness can be registered, this
+	 * leaves out offloaded sockets and objects without poll support.
+	 */
+	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_EPOLL_WATCH, &watch);
+	if (ret < 0) {
+		k_mutex_unlock(lock);
+		errno = EPERM;
+		return -1;
+	}
+
+#ifdef CONFIG_USERSPACE
+	/* Each kind of object tells which kernel object type, if any, a
+	 * user thread must have been granted.
+	 */
+	if (z_is_in_user_syscall() && watch.otype != K_OBJ_ANY) {
+		struct z_object *zo = z_object_find(obj);
+
+		ret = z_object_validate(zo, watch.otype, _OBJ_INIT_TRUE);
+		if (ret != 0) {
+			k_mutex_unlock(lock);
+			z_dump_object_error(ret, obj, zo, watch.otype);
+			errno = EBADF;
+			return -1;
+		}
+	}
+#endif /* CONFIG_USERSPACE */
+
+	if (entry == NULL) {
+		entry = &ep->entries[ep->count++];
+	}
+
+	entry->fd = fd;
+	entry->events = event->events;
+	entry->data = event->data;
+	entry->obj = obj;
+	entry->vtable = vtable;
+	entry->lock = lock;
+	entry->ep = ep;
+	entry->polled = watch.polled;
+	entry->polling = false;
+	entry->armed = false;
+	entry->disabled = false;
+
+	/* Queued for the next wait to check whether it is ready already */
+	key = k_spin_lock(&epoll_lock);
+	sys_slist_append(watch.watchers, &entry->watch_node);
+	entry->watchers = watch.watchers;
+	entry->queued = false;
+	epoll_entry_queue(entry);
+	k_spin_unlock(&epoll_lock, key);
+
+	k_mutex_unlock(lock);
+
+	epoll_entry_polled_update(ep, entry);
+	epoll_raise();
+
+	return 0;
+}
+
+/* Gets the events the descriptor of the entry is ready for */
+static int epoll_entry_check(struct epoll_entry *entry, uint32_t *revents)
+{
+	/* Events an object did not prepare, returning -EALREADY before
+	 * them, read as not ready.
+	 */
+	struct k_poll_event pev_buf[EPOLL_OBJ_EVENTS_MAX] = { 0 };
+	struct k_poll_event *pev = pev_buf;
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events & EPOLL_EVENTS_POLLED,
+	};
+	int ret;
+
+	(void)k_mutex_lock(entry->lock, K_FOREVER);
+
+	ret = z_fdtable_call_ioctl(entry->vtable, entry->obj,
+				   ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				   pev_buf + ARRAY_SIZE(pev_buf));
+	if (ret == 0 || ret == -EALREADY) {
+		/* Only picks up the state of the events, never waits */
+		if (pev > pev_buf) {
+			(void)k_poll(pev_buf, pev - pev_buf, K_NO_WAIT);
+		}
+
+		pev = pev_buf;
+		ret = z_fdtable_call_ioctl(entry->vtable, entry->obj,
+					   ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	}
+
+	k_mutex_unlock(entry->lock);
+
+	*revents = pfd.revents;
+
+	return ret;
+}
+
+/* Reports the queued entries which are ready, in the order they were
+ * queued. Level triggered: the entries reported are queued again, after
+ * those not reached yet, so that the next wait checks them again and none
+ * of them is starved. Entries found not ready wait for their object to
+ * queue them again.
+ */
+static int epoll_collect(struct zsock_epoll *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct epoll_entry *entry;
+	sys_dlist_t reported;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	uint32_t revents;
+	int ready = 0;
+	int ret = 0;
+
+	sys_dlist_init(&reported);
+
+	while (ready < maxevents) {
+		key = k_spin_lock(&epoll_lock);
+		node = sys_dlist_get(&ep->ready);
+		if (node == NULL) {
+			k_spin_unlock(&epoll_lock, key);
+			break;
+		}
+
+		entry = CONTAINER_OF(node, struct epoll_entry, ready_node);
+		entry->queued = false;
+		k_spin_unlock(&epoll_lock, key);
+
+		if (entry->disabled) {
+			continue;
+		}
+
+		if (!epoll_entry_is_valid(entry)) {
+			/* Closed, and the descriptor possibly reused */
+			epoll_entry_remove(ep, entry);
+			continue;
+		}
+
+		ret = epoll_entry_check(entry, &revents);
+		if (ret < 0) {
+			epoll_entry_requeue(entry);
+			errno = -ret;
+			break;
+		}
+
+		if (revents == 0) {
+			continue;
+		}
+
+		events[ready].events = revents;
+		events[ready].data = entry->data;
+		ready++;
+
+		if (entry->events & ZSOCK_EPOLLONESHOT) {
+			entry->disabled = true;
+			epoll_entry_polled_update(ep, entry);
+			continue;
+		}
+
+		/* The object may have queued it again meanwhile */
+		key = k_spin_lock(&epoll_lock);
+		if (entry->queued) {
+			sys_dlist_remove(&entry->ready_node);
+		}
+		sys_dlist_append(&reported, &entry->ready_node);
+		entry->queued = true;
+		k_spin_unlock(&epoll_lock, key);
+	}
+
+	key = k_spin_lock(&epoll_lock);
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+	k_spin_unlock(&epoll_lock, key);
+
+	return ret < 0 ? -1 : ready;
+}
+
+/* Prepares the k_poll events of a wait: the signal of the instance, then
+ * the events of the entries which cannot notify all of theirs. Returns
+ * their number, queueing the entries found ready already.
+ */
+static int epoll_arm(struct zsock_epoll *ep)
+{
+	struct k_poll_event *pev = ep->poll_events;
+	struct k_poll_event *pev_end = pev + ARRAY_SIZE(ep->poll_events);
+	struct epoll_entry *entry;
+	int ret;
+
+	k_poll_event_init(pev++, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &ep->ready_sig);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ep->polled, entry, polled_node) {
+		struct zsock_pollfd pfd = {
+			.fd = entry->fd,
+			.events = entry->events & entry->polled &
+				  EPOLL_EVENTS_POLLED,
+		};
+
+		entry->ev_first = pev - ep->poll_events;
+
+		(void)k_mutex_lock(entry->lock, K_FOREVER);
+		ret = z_fdtable_call_ioctl(entry->vtable, entry->obj,
+					   ZFD_IOCTL_POLL_PREPARE,
+					   &pfd, &pev, pev_end);
+		k_mutex_unlock(entry->lock);
+
+		if (ret == -EALREADY) {
+			epoll_entry_requeue(entry);
+		} else if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		entry->ev_count = pev - ep->poll_events - entry->ev_first;
+		entry->armed = true;
+	}
+
+	return pev - ep->poll_events;
+}
+
+/* Queues the polled entries whose k_poll events fired */
+static void epoll_disarm(struct zsock_epoll *ep)
+{
+	struct epoll_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ep->polled, entry, polled_node) {
+		if (!entry->armed) {
+			continue;
+		}
+
+		entry->armed = false;
+
+		for (int i = 0; i < entry->ev_count; i++) {
+			if (ep->poll_events[entry->ev_first + i].state !=
+			    K_POLL_STATE_NOT_READY) {
+				epoll_entry_requeue(entry);
+				break;
+			}
+		}
+	}
+}
+
+int z_impl_zsock_epoll_create(int flags)
+{
+	struct zsock_epoll *ep = NULL;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epolls_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epolls_lock);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENFILE;
+		return -1;
+	}
+
+	k_mutex_init(&ep->lock);
+	k_mutex_init(&ep->wait_lock);
+	k_condvar_init(&ep->idle);
+	atomic_clear_bit(epoll_raise_pending, ep - epolls);
+	k_poll_signal_init(&ep->ready_sig);
+	sys_dlist_init(&ep->ready);
+	sys_slist_init(&ep->polled);
+	ep->count = 0;
+	ep->waiters = 0;
+	ep->closed = false;
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int flags)
+{
+	return z_impl_zsock_epoll_create(flags);
+}
+#include <syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct zsock_epoll *ep;
+	struct epoll_entry *entry;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL &&
+	    (event == NULL || (event->events & ~EPOLL_EVENTS_VALID) != 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	if (ep->closed) {
+		k_mutex_unlock(&ep->lock);
+		errno = EBADF;
+		return -1;
+	}
+
+	entry = epoll_entry_find(ep, fd);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (entry != NULL) {
+			errno = EEXIST;
+			ret = -1;
+			break;
+		}
+
+		ret = epoll_entry_add(ep, fd, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (entry == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		entry->events = event->events;
+		entry->data = event->data;
+		entry->disabled = false;
+		epoll_entry_polled_update(ep, entry);
+
+		/* Checked again by the next wait, or by the one in progress */
+		epoll_entry_requeue(entry);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (entry == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		epoll_entry_remove(ep, entry);
+		break;
+
+	default:
+		errno = EINVAL;
+		ret = -1;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event != NULL) {
+		Z_OOPS(z_user_from_copy(&event_copy, event, sizeof(event_copy)));
+		event = &event_copy;
+	}
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	k_timeout_t remaining = epoll_timeout(timeout);
+	uint64_t end = sys_clock_timeout_end_calc(remaining);
+	struct zsock_epoll *ep;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+	if (ep->closed) {
+		k_mutex_unlock(&ep->lock);
+		errno = EBADF;
+		return -1;
+	}
+	ep->waiters++;
+	k_mutex_unlock(&ep->lock);
+
+	if (k_mutex_lock(&ep->wait_lock, remaining) != 0) {
+		/* Another thread kept waiting until the timeout */
+		ret = 0;
+		goto out;
+	}
+
+	while (true) {
+		k_spinlock_key_t key;
+		int nevents = 0;
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		if (ep->closed) {
+			k_mutex_unlock(&ep->lock);
+			errno = EBADF;
+			ret = -1;
+			break;
+		}
+
+		/* Whatever gets queued from now on raises it again */
+		key = k_spin_lock(&epoll_lock);
+		k_poll_signal_reset(&ep->ready_sig);
+		k_spin_unlock(&epoll_lock, key);
+
+		ret = epoll_collect(ep, events, maxevents);
+		if (ret == 0 && !K_TIMEOUT_EQ(remaining, K_NO_WAIT)) {
+			nevents = epoll_arm(ep);
+			if (nevents < 0) {
+				epoll_disarm(ep);
+				ret = -1;
+			}
+		}
+
+		k_mutex_unlock(&ep->lock);
+
+		if (ret != 0 || nevents == 0) {
+			break;
+		}
+
+		ret = k_poll(ep->poll_events, nevents, remaining);
+		if (ret == -EAGAIN) {
+			/* Whatever was queued meanwhile is still checked */
+			remaining = K_NO_WAIT;
+		} else if (ret != 0 && ret != -EINTR) {
+			/* EINTR when cancelled (i.e. EOF), found by the check */
+			errno = -ret;
+			ret = -1;
+		}
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+		epoll_disarm(ep);
+		k_mutex_unlock(&ep->lock);
+
+		if (ret == -1) {
+			break;
+		}
+
+		epoll_timeout_recalc(end, &remaining);
+	}
+
+	k_mutex_unlock(&ep->wait_lock);
+
+out:
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+	ep->waiters--;
+	if (ep->closed && ep->waiters == 0) {
+		k_condvar_broadcast(&ep->idle);
+	}
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	if (maxevents > 0) {
+		Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+						    sizeof(*events)));
+	}
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+/* Threads waiting on the instance fail with EBADF */
+static int epoll_close_vmeth(void *obj)
+{
+	struct zsock_epoll *ep = obj;
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	ep->closed = true;
+
+	for (int i = ep->count - 1; i >= 0; i--) {
+		if (ep->entries[i].fd >= 0) {
+			epoll_entry_remove(ep, &ep->entries[i]);
+		}
+	}
+
+	/* The slot must not be reused until they have all left */
+	k_poll_signal_raise(&ep->ready_sig, 0);
+	while (ep->waiters > 0) {
+		(void)k_condvar_wait(&ep->idle, &ep->lock, K_FOREVER);
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	(void)k_mutex_lock(&epolls_lock, K_FOREVER);
+	ep->in_use = false;
+	k_mutex_unlock(&epolls_lock);
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(args);
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE:
+	case ZFD_IOCTL_POLL_UPDATE:
+		/* Nesting epoll instances is not supported */
+		return -EOPNOTSUPP;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
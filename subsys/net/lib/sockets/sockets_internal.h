@@ -70,6 +70,7 @@ struct socket_op_vtable {
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
+	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
 	int (*getpeername)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
@@ -78,4 +79,38 @@ struct socket_op_vtable {
 
 size_t msghdr_non_empty_iov_count(const struct msghdr *msg);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+#include <zephyr/net/socket_epoll.h>
+
+static inline void sock_epoll_init(struct net_context *ctx)
+{
+	sys_slist_init(&ctx->epoll_watchers);
+}
+
+static inline void sock_epoll_notify(struct net_context *ctx)
+{
+	zsock_epoll_notify(&ctx->epoll_watchers);
+}
+
+static inline void sock_epoll_detach(struct net_context *ctx)
+{
+	zsock_epoll_detach(&ctx->epoll_watchers);
+}
+#else
+static inline void sock_epoll_init(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void sock_epoll_notify(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void sock_epoll_detach(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
 #endif /* _SOCKETS_INTERNAL_H_ */
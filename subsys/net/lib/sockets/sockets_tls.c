@@ -3159,7 +3159,9 @@ static int tls_sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	switch (request) {
 	/* fcntl() commands */
 	case F_GETFL:
-	case F_SETFL: {
+	case F_SETFL:
+	/* The underlying socket notifies its epoll registrations */
+	case ZFD_IOCTL_EPOLL_WATCH: {
 		const struct fd_op_vtable *vtable;
 		struct k_mutex *lock;
 		void *obj;
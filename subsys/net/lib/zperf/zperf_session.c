@@ -100,6 +100,8 @@ void zperf_reset_session_stats(struct session *session)
 	session->error = 0U;
 	session->jitter = 0;
 	session->last_transit_time = 0;
+	session->cpu_cycles = 0U;
+	session->cpu_busy_cycles = 0U;
 }
 
 void zperf_session_init(void)
@@ -50,6 +50,10 @@ struct session {
 	int32_t jitter;
 	int32_t last_transit_time;
 
+	/* CPU cycles, all and non-idle ones, at the start */
+	uint64_t cpu_cycles;
+	uint64_t cpu_busy_cycles;
+
 	/* Stats packet*/
 	struct zperf_server_hdr stat;
 };
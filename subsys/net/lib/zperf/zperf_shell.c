@@ -1013,6 +1013,12 @@ static void tcp_session_cb(enum zperf_status status,
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+		if (result->cpu_load != 0U) {
+			shell_fprintf(sh, SHELL_NORMAL, " CPU load:\t\t%u.%u%%\n",
+				      result->cpu_load / 10U,
+				      result->cpu_load % 10U);
+		}
+
 		break;
 	}
 
@@ -1043,10 +1049,17 @@ static int cmd_tcp_download(const struct shell *sh, size_t argc,
 {
 	if (IS_ENABLED(CONFIG_NET_TCP)) {
 		struct zperf_download_params param = { 0 };
+		int start = 0;
 		int ret;
 
+		if (argc >= 2 && !strcmp(argv[1], "-z")) {
+			param.zerocopy = true;
+			start++;
+			argc--;
+		}
+
 		if (argc >= 2) {
-			param.port = strtoul(argv[1], NULL, 10);
+			param.port = strtoul(argv[start + 1], NULL, 10);
 		} else {
 			param.port = DEF_PORT;
 		}
@@ -1056,6 +1069,10 @@ static int cmd_tcp_download(const struct shell *sh, size_t argc,
 			shell_fprintf(sh, SHELL_WARNING,
 				      "TCP server already started!\n");
 			return -ENOEXEC;
+		} else if (ret == -ENOTSUP) {
+			shell_fprintf(sh, SHELL_WARNING,
+				      "Zero-copy receive not supported!\n");
+			return -ENOEXEC;
 		} else if (ret < 0) {
 			shell_fprintf(sh, SHELL_ERROR,
 				      "Failed to start TCP server!\n");
@@ -1173,7 +1190,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  ,
 		  cmd_tcp_upload2),
 	SHELL_CMD(download, &zperf_cmd_tcp_download,
-		  "[<port>]\n"
+		  "[-z] [<port>]\n"
+		  "-z: Receive with zero-copy\n"
 		  "Example: tcp download 5001\n",
 		  cmd_tcp_download),
 	SHELL_SUBCMD_SET_END
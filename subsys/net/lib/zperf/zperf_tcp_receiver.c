@@ -36,8 +36,14 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 #define SOCK_ID_MAX         (CONFIG_NET_ZPERF_MAX_SESSIONS + 2)
 
 #define TCP_RECEIVER_BUF_SIZE 1500
+#define TCP_RECEIVER_IOV_COUNT 16
 #define POLL_TIMEOUT_MS 100
 
+/* The CPU usage statistics are not available to user mode threads */
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL) && !defined(CONFIG_USERSPACE)
+#define TCP_RECEIVER_CPU_LOAD 1
+#endif
+
 static K_THREAD_STACK_DEFINE(tcp_receiver_stack_area, TCP_RECEIVER_STACK_SIZE);
 static struct k_thread tcp_receiver_thread_data;
 
@@ -46,8 +52,45 @@ static void *tcp_user_data;
 static bool tcp_server_running;
 static bool tcp_server_stop;
 static uint16_t tcp_server_port;
+static bool tcp_server_zerocopy;
 static K_SEM_DEFINE(tcp_server_run, 0, 1);
 
+static void tcp_cpu_usage_start(struct session *session)
+{
+#if defined(TCP_RECEIVER_CPU_LOAD)
+	k_thread_runtime_stats_t stats;
+
+	(void)k_thread_runtime_stats_all_get(&stats);
+
+	session->cpu_cycles = stats.execution_cycles;
+	session->cpu_busy_cycles = stats.total_cycles;
+#else
+	ARG_UNUSED(session);
+#endif
+}
+
+static uint32_t tcp_cpu_load(const struct session *session)
+{
+#if defined(TCP_RECEIVER_CPU_LOAD)
+	k_thread_runtime_stats_t stats;
+	uint64_t cycles;
+
+	(void)k_thread_runtime_stats_all_get(&stats);
+
+	cycles = stats.execution_cycles - session->cpu_cycles;
+	if (cycles == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)((stats.total_cycles - session->cpu_busy_cycles) *
+			  1000U / cycles);
+#else
+	ARG_UNUSED(session);
+
+	return 0U;
+#endif
+}
+
 static void tcp_received(const struct sockaddr *addr, size_t datalen)
 {
 	struct session *session;
@@ -67,6 +110,7 @@ static void tcp_received(const struct sockaddr *addr, size_t datalen)
 		zperf_reset_session_stats(session);
 		session->start_time = k_uptime_ticks();
 		session->state = STATE_ONGOING;
+		tcp_cpu_usage_start(session);
 
 		if (tcp_session_cb != NULL) {
 			tcp_session_cb(ZPERF_SESSION_STARTED, NULL,
@@ -86,6 +130,7 @@ static void tcp_received(const struct sockaddr *addr, size_t datalen)
 			results.total_len = session->length;
 			results.time_in_us = k_ticks_to_us_ceil32(
 						time - session->start_time);
+			results.cpu_load = tcp_cpu_load(session);
 
 			if (tcp_session_cb != NULL) {
 				tcp_session_cb(ZPERF_SESSION_FINISHED, &results,
@@ -137,6 +182,29 @@ static void tcp_session_error_report(void)
 	}
 }
 
+static ssize_t tcp_recv(int sock, void *buf, size_t len)
+{
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+	if (tcp_server_zerocopy) {
+		struct iovec iov[TCP_RECEIVER_IOV_COUNT];
+		struct zsock_recv_zc zc = {
+			.iov = iov,
+			.iovlen = ARRAY_SIZE(iov),
+		};
+		ssize_t ret;
+
+		ret = zsock_recv_zerocopy(sock, &zc, 0);
+
+		/* Only the amount of data matters, give the buffers back */
+		zsock_recv_zerocopy_release(&zc);
+
+		return ret;
+	}
+#endif
+
+	return zsock_recv(sock, buf, len, 0);
+}
+
 static void tcp_server_session(void)
 {
 	static uint8_t buf[TCP_RECEIVER_BUF_SIZE];
@@ -306,7 +374,7 @@ use_existing_ipv6:
 					       addrlen);
 				}
 			} else if ((i > SOCK_ID_IPV6_LISTEN) && (i < SOCK_ID_MAX)) {
-				ret = zsock_recv(fds[i].fd, buf, sizeof(buf), 0);
+				ret = tcp_recv(fds[i].fd, buf, sizeof(buf));
 				if (ret < 0) {
 					NET_ERR("recv failed on IPv%d socket (%d)",
 						(sock_addr[i].sa_family == AF_INET
@@ -382,9 +450,17 @@ int zperf_tcp_download(const struct zperf_download_params *param,
 		return -EALREADY;
 	}
 
+	/* The receiver thread runs in user mode with CONFIG_USERSPACE */
+	if (param->zerocopy &&
+	    (!IS_ENABLED(CONFIG_NET_SOCKETS_RECV_ZEROCOPY) ||
+	     IS_ENABLED(CONFIG_USERSPACE))) {
+		return -ENOTSUP;
+	}
+
 	tcp_session_cb = callback;
 	tcp_user_data = user_data;
 	tcp_server_port = param->port;
+	tcp_server_zerocopy = param->zerocopy;
 	tcp_server_running = true;
 	tcp_server_stop = false;
 
@@ -24,6 +24,42 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+/* Handlers are looked up in the trie once it holds all of them */
+static bool settings_trie_ready;
+
+static void settings_trie_full(void)
+{
+	settings_trie_ready = false;
+	LOG_WRN("Handler trie full, increase CONFIG_SETTINGS_HANDLER_TRIE_NODES");
+}
+
+static void settings_trie_build(void)
+{
+	settings_trie_ready = false;
+	settings_trie_init();
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		if (settings_trie_add(ch)) {
+			settings_trie_full();
+			return;
+		}
+	}
+
+#if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
+	struct settings_handler *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
+		if (settings_trie_add((struct settings_handler_static *)ch)) {
+			settings_trie_full();
+			return;
+		}
+	}
+#endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+
+	settings_trie_ready = true;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
 
 void settings_store_init(void);
 
@@ -32,6 +68,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+	settings_trie_build();
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
 	settings_store_init();
 }
 
@@ -57,10 +96,36 @@ int settings_register(struct settings_handler *handler)
 	}
 	sys_slist_append(&settings_handlers, &handler->node);
 
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+	if (settings_trie_ready &&
+	    settings_trie_add((struct settings_handler_static *)handler)) {
+		settings_trie_full();
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
+
 end:
 	k_mutex_unlock(&settings_lock);
 	return rc;
 }
+
+bool settings_deregister(struct settings_handler *handler)
+{
+	bool found;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	found = sys_slist_find_and_remove(&settings_handlers, &handler->node);
+
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+	/* Trie nodes may point into the name of the handler, rebuild it */
+	if (found) {
+		settings_trie_build();
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
+
+	k_mutex_unlock(&settings_lock);
+	return found;
+}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
 int settings_name_steq(const char *name, const char *key, const char **next)
@@ -140,6 +205,12 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 	struct settings_handler_static *bestmatch;
 	const char *tmpnext;
 
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+	if (settings_trie_ready) {
+		return settings_trie_lookup(name, next);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
+
 	bestmatch = NULL;
 	if (next) {
 		*next = NULL;
@@ -25,7 +25,19 @@ LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
 
 struct settings_nvs_read_fn_arg {
 	struct nvs_fs *fs;
-	uint16_t id;
+	const struct nvs_entry *entry;
+};
+
+/* Most recent name and value entries of a batch of name IDs, found by a
+ * single walk of the NVS allocation table. An entry with id 0 was not found.
+ * Lives on the stack of settings_nvs_load() for the time of the load only.
+ */
+struct settings_nvs_load_batch {
+	uint16_t first_id;
+	uint16_t count;
+	uint16_t missing;
+	struct nvs_entry name[CONFIG_SETTINGS_NVS_LOAD_BATCH_SIZE];
+	struct nvs_entry value[CONFIG_SETTINGS_NVS_LOAD_BATCH_SIZE];
 };
 
 static int settings_nvs_load(struct settings_store *cs,
@@ -47,7 +59,7 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 
 	rd_fn_arg = (struct settings_nvs_read_fn_arg *)back_end;
 
-	rc = nvs_read(rd_fn_arg->fs, rd_fn_arg->id, data, len);
+	rc = nvs_entry_read(rd_fn_arg->fs, rd_fn_arg->entry, data, len);
 	if (rc > (ssize_t)len) {
 		/* nvs_read signals that not all bytes were read
 		 * align read len to what was requested
@@ -118,71 +130,126 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+static int settings_nvs_load_batch_cb(struct nvs_fs *fs,
+				      const struct nvs_entry *entry, void *arg)
+{
+	struct settings_nvs_load_batch *batch = arg;
+	struct nvs_entry *found;
+	uint16_t idx;
+
+	if (entry->id > NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET) {
+		idx = entry->id - NVS_NAME_ID_OFFSET - batch->first_id;
+		found = batch->value;
+	} else if (entry->id > NVS_NAMECNT_ID) {
+		idx = entry->id - batch->first_id;
+		found = batch->name;
+	} else {
+		return 0;
+	}
+
+	/* Only the first entry found for an ID is the most recent one */
+	if (idx < batch->count && found[idx].id == 0U) {
+		found[idx] = *entry;
+		batch->missing--;
+	}
+
+	/* Older entries cannot change what was found, stop the walk once
+	 * both entries of every setting of the batch are known.
+	 */
+	return (batch->missing == 0U) ? 1 : 0;
+}
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
 	int ret = 0;
 	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+	struct settings_nvs_load_batch batch_buf;
+	struct settings_nvs_load_batch *batch = &batch_buf;
 	struct settings_nvs_read_fn_arg read_fn_arg;
 	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
-	char buf;
-	ssize_t rc1, rc2;
-	uint16_t name_id = NVS_NAMECNT_ID;
-
-	name_id = cf->last_name_id + 1;
-
-	while (1) {
-
-		name_id--;
-		if (name_id == NVS_NAMECNT_ID) {
-			break;
-		}
+	const struct nvs_entry *name_entry, *value_entry;
+	ssize_t rc1;
+	uint16_t name_id, end_id;
+
+	end_id = cf->last_name_id + 1;
+
+	/* Batches of name IDs are loaded from the highest ones, in the order
+	 * the name IDs used to be read one by one.
+	 */
+	while (end_id > NVS_NAMECNT_ID + 1) {
+		batch->count = MIN(end_id - (NVS_NAMECNT_ID + 1),
+				   CONFIG_SETTINGS_NVS_LOAD_BATCH_SIZE);
+		batch->first_id = end_id - batch->count;
+		batch->missing = 2U * batch->count;
+		memset(batch->name, 0, sizeof(batch->name));
+		memset(batch->value, 0, sizeof(batch->value));
 
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
-		 * setting's value.
+		 * setting's value. Find both for all the batch in one walk.
 		 */
-		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
-		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
-			       &buf, sizeof(buf));
-
-		if ((rc1 <= 0) && (rc2 <= 0)) {
-			continue;
+		ret = nvs_foreach(&cf->cf_nvs, settings_nvs_load_batch_cb,
+				  batch);
+		if (ret < 0) {
+			break;
 		}
+		ret = 0;
 
-		if ((rc1 <= 0) || (rc2 <= 0)) {
-			/* Settings item is not stored correctly in the NVS.
-			 * NVS entry for its name or value is either missing
-			 * or deleted. Clean dirty entries to make space for
-			 * future settings item.
-			 */
-			if (name_id == cf->last_name_id) {
-				cf->last_name_id--;
-				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-					  &cf->last_name_id, sizeof(uint16_t));
+		for (name_id = end_id - 1; name_id >= batch->first_id;
+		     name_id--) {
+			name_entry = &batch->name[name_id - batch->first_id];
+			value_entry = &batch->value[name_id - batch->first_id];
+
+			if ((name_entry->len == 0U) && (value_entry->len == 0U)) {
+				continue;
+			}
+
+			if ((name_entry->len == 0U) || (value_entry->len == 0U)) {
+				/* Settings item is not stored correctly in the
+				 * NVS. NVS entry for its name or value is either
+				 * missing or deleted. Clean dirty entries to make
+				 * space for future settings item.
+				 */
+				if (name_id == cf->last_name_id) {
+					cf->last_name_id--;
+					nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
+						  &cf->last_name_id,
+						  sizeof(uint16_t));
+				}
+				nvs_delete(&cf->cf_nvs, name_id);
+				nvs_delete(&cf->cf_nvs,
+					   name_id + NVS_NAME_ID_OFFSET);
+				continue;
 			}
-			nvs_delete(&cf->cf_nvs, name_id);
-			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
-			continue;
-		}
 
-		/* Found a name, this might not include a trailing \0 */
-		name[rc1] = '\0';
-		read_fn_arg.fs = &cf->cf_nvs;
-		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
+			/* Found a name, this might not include a trailing \0 */
+			rc1 = nvs_entry_read(&cf->cf_nvs, name_entry, &name,
+					     sizeof(name) - 1);
+			if (rc1 <= 0) {
+				continue;
+			}
+
+			name[MIN(rc1, sizeof(name) - 1)] = '\0';
+			read_fn_arg.fs = &cf->cf_nvs;
+			read_fn_arg.entry = value_entry;
 
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
-		settings_nvs_cache_add(cf, name, name_id);
+			settings_nvs_cache_add(cf, name, name_id);
 #endif
 
-		ret = settings_call_set_handler(
-			name, rc2,
-			settings_nvs_read_fn, &read_fn_arg,
-			(void *)arg);
-		if (ret) {
-			break;
+			ret = settings_call_set_handler(
+				name, value_entry->len,
+				settings_nvs_read_fn, &read_fn_arg,
+				(void *)arg);
+			if (ret) {
+				return ret;
+			}
 		}
+
+		end_id = batch->first_id;
 	}
+
 	return ret;
 }
 
@@ -120,6 +120,23 @@ void settings_line_io_init(int (*read_cb)(void *ctx, off_t off, char *buf,
 			  size_t (*get_len_cb)(void *ctx),
 			  uint8_t io_rwbs);
 
+#ifdef CONFIG_SETTINGS_HANDLER_TRIE
+/* Empty the handler trie. */
+void settings_trie_init(void);
+
+/*
+ * Add a handler to the trie.
+ *
+ * @retval 0 on success,
+ * -ENOMEM when CONFIG_SETTINGS_HANDLER_TRIE_NODES nodes are not enough
+ */
+int settings_trie_add(const struct settings_handler_static *handler);
+
+/* Same as settings_parse_and_lookup(), for the handlers in the trie. */
+struct settings_handler_static *settings_trie_lookup(const char *name,
+						     const char **next);
+#endif
+
 
 extern sys_slist_t settings_load_srcs;
 extern sys_slist_t settings_handlers;
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Radix trie of the settings handler names, so that the handler of a
+ * setting is found by walking the name once instead of comparing it with
+ * the name of each handler. A node is only created where a handler name
+ * ends or where two names part, and the children of a node start with
+ * different characters.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+
+#include "settings_priv.h"
+
+struct settings_trie_node {
+	/* Characters after the parent node, pointing into a handler name */
+	const char *label;
+	/* First child node */
+	struct settings_trie_node *child;
+	/* Next node with the same parent */
+	struct settings_trie_node *next;
+	/* Handler of the name ending at this node, if any */
+	const struct settings_handler_static *handler;
+	uint16_t len;
+};
+
+static struct settings_trie_node settings_trie_nodes[CONFIG_SETTINGS_HANDLER_TRIE_NODES];
+static size_t settings_trie_used;
+static struct settings_trie_node settings_trie_root;
+
+static struct settings_trie_node *trie_node_alloc(const char *label,
+						  size_t len)
+{
+	struct settings_trie_node *node;
+
+	if (settings_trie_used == ARRAY_SIZE(settings_trie_nodes)) {
+		return NULL;
+	}
+
+	node = &settings_trie_nodes[settings_trie_used++];
+	memset(node, 0, sizeof(*node));
+	node->label = label;
+	node->len = len;
+
+	return node;
+}
+
+/* Link to the child of node starting with c, or to the end of its
+ * children.
+ */
+static struct settings_trie_node **trie_child(struct settings_trie_node *node,
+					      char c)
+{
+	struct settings_trie_node **link = &node->child;
+
+	while (*link != NULL && (*link)->label[0] != c) {
+		link = &(*link)->next;
+	}
+
+	return link;
+}
+
+static inline bool trie_name_end(char c)
+{
+	return c == SETTINGS_NAME_SEPARATOR || c == SETTINGS_NAME_END ||
+	       c == '\0';
+}
+
+void settings_trie_init(void)
+{
+	settings_trie_used = 0;
+	memset(&settings_trie_root, 0, sizeof(settings_trie_root));
+}
+
+int settings_trie_add(const struct settings_handler_static *handler)
+{
+	struct settings_trie_node *node = &settings_trie_root;
+	const char *name = handler->name;
+
+	while (*name != '\0') {
+		struct settings_trie_node **link = trie_child(node, *name);
+		struct settings_trie_node *child = *link;
+		size_t common = 0;
+
+		if (child == NULL) {
+			child = trie_node_alloc(name, strlen(name));
+			if (child == NULL) {
+				return -ENOMEM;
+			}
+
+			*link = child;
+			node = child;
+			break;
+		}
+
+		while (common < child->len && name[common] == child->label[common]) {
+			common++;
+		}
+
+		/* The name parts from the child label, split the label */
+		if (common < child->len) {
+			struct settings_trie_node *split;
+
+			split = trie_node_alloc(child->label, common);
+			if (split == NULL) {
+				return -ENOMEM;
+			}
+
+			split->child = child;
+			split->next = child->next;
+			child->next = NULL;
+			child->label += common;
+			child->len -= common;
+			*link = split;
+			child = split;
+		}
+
+		node = child;
+		name += common;
+	}
+
+	/* As when comparing with each handler, the last one of a name wins */
+	node->handler = handler;
+
+	return 0;
+}
+
+struct settings_handler_static *settings_trie_lookup(const char *name,
+						     const char **next)
+{
+	const struct settings_handler_static *bestmatch = NULL;
+	struct settings_trie_node *node = &settings_trie_root;
+	const char *end = NULL;
+	const char *pos = name;
+
+	while (true) {
+		if (node->handler != NULL && trie_name_end(*pos)) {
+			bestmatch = node->handler;
+			end = pos;
+		}
+
+		if (trie_name_end(*pos) && *pos != SETTINGS_NAME_SEPARATOR) {
+			break;
+		}
+
+		node = *trie_child(node, *pos);
+		if (node == NULL || strncmp(node->label, pos, node->len) != 0) {
+			break;
+		}
+
+		pos += node->len;
+	}
+
+	if (next) {
+		*next = (end != NULL && *end == SETTINGS_NAME_SEPARATOR) ?
+			end + 1 : NULL;
+	}
+
+	return (struct settings_handler_static *)bestmatch;
+}
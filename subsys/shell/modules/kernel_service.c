@@ -235,6 +235,83 @@ static int cmd_kernel_stacks(const struct shell *sh,
 }
 #endif
 
+#if defined(CONFIG_SCHED_WAKEUP_LATENCY)
+static bool sched_stats_reset;
+
+#if defined(CONFIG_THREAD_MONITOR)
+static void shell_wakeup_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = (const struct shell *)user_data;
+	struct k_wakeup_stats stats;
+	const char *tname;
+	char hist[128];
+	int len = 0;
+
+	if (k_thread_wakeup_stats_get(thread, &stats, sched_stats_reset) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(sh, "%p %-" STRINGIFY(THREAD_MAX_NAM_LEN) "s wakeups %u, "
+		    "average %u us, longest %u us",
+		    thread, tname ? tname : "NA", stats.count,
+		    (stats.count != 0U) ?
+		    k_cyc_to_us_floor32(stats.total / stats.count) : 0U,
+		    k_cyc_to_us_floor32(stats.longest));
+
+	/* Only print the non-empty buckets, by their upper bound */
+	for (int i = 0; i < ARRAY_SIZE(stats.hist); i++) {
+		if (stats.hist[i] == 0U || len >= sizeof(hist)) {
+			continue;
+		}
+
+		if (i == ARRAY_SIZE(stats.hist) - 1) {
+			len += snprintk(&hist[len], sizeof(hist) - len,
+					" >=%uus:%u", 1U << (i - 1), stats.hist[i]);
+		} else {
+			len += snprintk(&hist[len], sizeof(hist) - len,
+					" <%uus:%u", 1U << i, stats.hist[i]);
+		}
+	}
+
+	if (len > 0) {
+		shell_print(sh, "\t%s", hist);
+	}
+}
+#endif
+
+static int cmd_kernel_sched(const struct shell *sh,
+			    size_t argc, char **argv)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	sched_stats_reset = (argc > 1) && (strcmp(argv[1], "reset") == 0);
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_runq_stats stats;
+
+		if (k_sched_runq_stats_get(i, &stats, sched_stats_reset) != 0) {
+			continue;
+		}
+
+		shell_print(sh, "CPU %d run queue: depth %u, peak %u, average %u "
+			    "(%u samples)", i, stats.depth, stats.peak,
+			    (stats.num_samples != 0U) ?
+			    (uint32_t)(stats.total / stats.num_samples) : 0U,
+			    stats.num_samples);
+	}
+
+#if defined(CONFIG_THREAD_MONITOR)
+	shell_print(sh, "Wakeup latency:");
+	k_thread_foreach(shell_wakeup_dump, (void *)sh);
+#endif
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 extern struct sys_heap _system_heap;
 
@@ -361,6 +438,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #endif
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 	SHELL_CMD(heap, NULL, "System heap usage statistics.", cmd_kernel_heap),
+#endif
+#if defined(CONFIG_SCHED_WAKEUP_LATENCY)
+	SHELL_CMD_ARG(sched, NULL, "Run queue depth and wakeup latency "
+		      "statistics, [reset] clears them after printing.",
+		      cmd_kernel_sched, 1, 1),
 #endif
 	SHELL_CMD(uptime, NULL, "Kernel uptime.", cmd_kernel_uptime),
 	SHELL_CMD(version, NULL, "Kernel version.", cmd_kernel_version),
@@ -7,8 +7,10 @@
 #ifndef _TRACE_BUFFER_H
 #define _TRACE_BUFFER_H
 
+#include <stdarg.h>
 #include <stdbool.h>
 #include <zephyr/types.h>
+#include <zephyr/tracing/tracing_format.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,6 +115,62 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/**
+ * @brief Put a tracing packet to the buffer of the current CPU.
+ *
+ * Only the interrupts of the current CPU are locked while the packet is
+ * put, the buffers of the other CPUs are not touched.
+ *
+ * @param tracing_data_array Array of the data making up the packet.
+ * @param count Size of the array.
+ * @param before_put_is_empty Set to true if the tracing thread may have
+ *        found no packet in the buffer before this one was put.
+ *
+ * @return true if the packet was put, false if it was dropped.
+ */
+bool tracing_cpu_buffer_put(tracing_data_t *tracing_data_array,
+			    uint32_t count, bool *before_put_is_empty);
+
+/**
+ * @brief Format a string tracing packet in the buffer of the current CPU.
+ *
+ * @param str String to format.
+ * @param args Variable parameters.
+ * @param before_put_is_empty Set to true if the tracing thread may have
+ *        found no packet in the buffer before this one was put.
+ *
+ * @return true if the packet was put, false if it was dropped.
+ */
+bool tracing_cpu_buffer_string_put(const char *str, va_list args,
+				   bool *before_put_is_empty);
+
+/**
+ * @brief Move the packets of the buffers of all the CPUs to the tracing
+ * buffer, oldest first.
+ *
+ * Must only be called by the tracing thread. Stops when the buffers of
+ * the CPUs are empty or when the oldest packet does not fit in the
+ * tracing buffer.
+ *
+ * The order is best-effort: the oldest packet is picked among those
+ * published when it is looked for, so a packet a CPU timestamps just
+ * before, but publishes just after, comes after newer packets of the
+ * other CPUs. So do packets whose CPU cycle counter lags behind.
+ */
+void tracing_cpu_buffer_merge(void);
+
+/**
+ * @brief Get the number of packets dropped because the buffer of a CPU
+ * was full.
+ *
+ * @param cpu CPU number.
+ *
+ * @return Number of packets dropped since boot.
+ */
+uint32_t tracing_cpu_buffer_drops_get(unsigned int cpu);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,7 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/cbprintf.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
 static struct ring_buf tracing_ring_buf;
 static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
@@ -67,3 +72,241 @@ uint32_t tracing_buffer_space_get(void)
 {
 	return ring_buf_space_get(&tracing_ring_buf);
 }
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_TRACING_PER_CPU_BUFFER_SIZE),
+	     "Tracing buffer size of a CPU must be a power of two");
+
+#define CPU_BUFFER_MASK (CONFIG_TRACING_PER_CPU_BUFFER_SIZE - 1)
+
+/* Header of each packet in the buffer of a CPU */
+struct tracing_cpu_record {
+	uint32_t timestamp;
+	uint32_t length;
+};
+
+/* Only written by its CPU, with the interrupts of that CPU locked, and
+ * only read by the tracing thread. head and tail are free running byte
+ * counts: the CPU publishes a packet by moving head after it, the
+ * tracing thread releases it by moving tail.
+ */
+struct tracing_cpu_buffer {
+	atomic_t head;
+	atomic_t tail;
+	uint32_t drops;
+	uint8_t data[CONFIG_TRACING_PER_CPU_BUFFER_SIZE];
+};
+
+static struct tracing_cpu_buffer tracing_cpu_buffers[CONFIG_MP_MAX_NUM_CPUS];
+
+static void cpu_buffer_write(struct tracing_cpu_buffer *buf, uint32_t pos,
+			     const void *data, uint32_t size)
+{
+	uint32_t offset = pos & CPU_BUFFER_MASK;
+	uint32_t first = MIN(size, sizeof(buf->data) - offset);
+
+	memcpy(&buf->data[offset], data, first);
+	memcpy(&buf->data[0], (const uint8_t *)data + first, size - first);
+}
+
+static void cpu_buffer_read(struct tracing_cpu_buffer *buf, uint32_t pos,
+			    void *data, uint32_t size)
+{
+	uint32_t offset = pos & CPU_BUFFER_MASK;
+	uint32_t first = MIN(size, sizeof(buf->data) - offset);
+
+	memcpy(data, &buf->data[offset], first);
+	memcpy((uint8_t *)data + first, &buf->data[0], size - first);
+}
+
+/* Space left for the next packet of the buffer, whose header goes at head */
+static uint32_t cpu_buffer_space(struct tracing_cpu_buffer *buf, uint32_t head)
+{
+	uint32_t space = sizeof(buf->data) -
+			 (head - (uint32_t)atomic_get(&buf->tail));
+
+	if (space < sizeof(struct tracing_cpu_record)) {
+		return 0;
+	}
+
+	/* A packet must also fit in the tracing buffer to be merged */
+	return MIN(space - sizeof(struct tracing_cpu_record),
+		   ring_buf_capacity_get(&tracing_ring_buf));
+}
+
+/* Writes the header of the packet at head, ending at pos, and hands it
+ * over to the tracing thread.
+ */
+static void cpu_buffer_publish(struct tracing_cpu_buffer *buf, uint32_t head,
+			       uint32_t pos, bool *before_put_is_empty)
+{
+	struct tracing_cpu_record record = {
+		.timestamp = k_cycle_get_32(),
+		.length = pos - head - sizeof(record),
+	};
+
+	cpu_buffer_write(buf, head, &record, sizeof(record));
+	atomic_set(&buf->head, (atomic_val_t)pos);
+
+	/* Checked once the packet is published: if the tracing thread has
+	 * not released everything before it, it still has to come back to
+	 * this buffer and will find the packet.
+	 */
+	*before_put_is_empty = ((uint32_t)atomic_get(&buf->tail) == head);
+}
+
+bool tracing_cpu_buffer_put(tracing_data_t *tracing_data_array,
+			    uint32_t count, bool *before_put_is_empty)
+{
+	struct tracing_cpu_buffer *buf;
+	uint32_t head, pos, space, length = 0U;
+	unsigned int key;
+	bool put_success = false;
+
+	for (uint32_t i = 0; i < count; i++) {
+		length += tracing_data_array[i].length;
+	}
+
+	/* Keeps the packet on this CPU and in one piece, even if an
+	 * interrupt traces too.
+	 */
+	key = arch_irq_lock();
+
+	buf = &tracing_cpu_buffers[_current_cpu->id];
+	head = (uint32_t)atomic_get(&buf->head);
+
+	space = cpu_buffer_space(buf, head);
+
+	if ((space == 0U) || (length > space)) {
+		buf->drops++;
+		goto out;
+	}
+
+	pos = head + sizeof(struct tracing_cpu_record);
+	for (uint32_t i = 0; i < count; i++) {
+		cpu_buffer_write(buf, pos, tracing_data_array[i].data,
+				 tracing_data_array[i].length);
+		pos += tracing_data_array[i].length;
+	}
+
+	cpu_buffer_publish(buf, head, pos, before_put_is_empty);
+	put_success = true;
+
+out:
+	arch_irq_unlock(key);
+
+	return put_success;
+}
+
+struct cpu_buffer_str_ctx {
+	struct tracing_cpu_buffer *buf;
+	uint32_t pos;
+	uint32_t end;
+};
+
+static int cpu_buffer_str_put(int c, void *ctx)
+{
+	struct cpu_buffer_str_ctx *str_ctx = ctx;
+	uint8_t byte = (uint8_t)c;
+
+	/* Past the end only counts, to tell that the string did not fit */
+	if (str_ctx->pos < str_ctx->end) {
+		cpu_buffer_write(str_ctx->buf, str_ctx->pos, &byte, 1);
+	}
+
+	str_ctx->pos++;
+
+	return 0;
+}
+
+bool tracing_cpu_buffer_string_put(const char *str, va_list args,
+				   bool *before_put_is_empty)
+{
+	struct cpu_buffer_str_ctx str_ctx;
+	uint32_t head, space;
+	unsigned int key;
+	bool put_success = false;
+
+	key = arch_irq_lock();
+
+	str_ctx.buf = &tracing_cpu_buffers[_current_cpu->id];
+	head = (uint32_t)atomic_get(&str_ctx.buf->head);
+	space = cpu_buffer_space(str_ctx.buf, head);
+	str_ctx.pos = head + sizeof(struct tracing_cpu_record);
+	str_ctx.end = str_ctx.pos + space;
+
+	(void)cbvprintf(cpu_buffer_str_put, &str_ctx, str, args);
+
+	if ((space == 0U) || (str_ctx.pos > str_ctx.end)) {
+		str_ctx.buf->drops++;
+		goto out;
+	}
+
+	cpu_buffer_publish(str_ctx.buf, head, str_ctx.pos, before_put_is_empty);
+	put_success = true;
+
+out:
+	arch_irq_unlock(key);
+
+	return put_success;
+}
+
+void tracing_cpu_buffer_merge(void)
+{
+	struct tracing_cpu_record record, oldest;
+	struct tracing_cpu_buffer *buf, *next;
+	uint32_t tail, pos, length, claimed_size;
+	uint8_t *data;
+
+	while (true) {
+		next = NULL;
+
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+			buf = &tracing_cpu_buffers[cpu];
+			tail = (uint32_t)atomic_get(&buf->tail);
+
+			if (tail == (uint32_t)atomic_get(&buf->head)) {
+				continue;
+			}
+
+			/* The packets of a CPU are in timestamp order, so
+			 * the oldest one is at the tail of one of the buffers.
+			 * It is not held back for the CPUs with nothing
+			 * published yet, which would have to tell how old
+			 * their next packet can be: the order is best-effort.
+			 */
+			cpu_buffer_read(buf, tail, &record, sizeof(record));
+			if ((next == NULL) ||
+			    ((int32_t)(record.timestamp - oldest.timestamp) < 0)) {
+				next = buf;
+				oldest = record;
+			}
+		}
+
+		if ((next == NULL) ||
+		    (ring_buf_space_get(&tracing_ring_buf) < oldest.length)) {
+			return;
+		}
+
+		tail = (uint32_t)atomic_get(&next->tail);
+		pos = tail + sizeof(oldest);
+		length = oldest.length;
+
+		while (length > 0U) {
+			claimed_size = ring_buf_put_claim(&tracing_ring_buf,
+							  &data, length);
+			cpu_buffer_read(next, pos, data, claimed_size);
+			ring_buf_put_finish(&tracing_ring_buf, claimed_size);
+			pos += claimed_size;
+			length -= claimed_size;
+		}
+
+		atomic_set(&next->tail, (atomic_val_t)pos);
+	}
+}
+
+uint32_t tracing_cpu_buffer_drops_get(unsigned int cpu)
+{
+	return tracing_cpu_buffers[cpu].drops;
+}
+#endif
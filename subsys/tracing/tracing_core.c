@@ -62,6 +62,13 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 	tracing_buffer_max_length = tracing_buffer_capacity_get();
 
 	while (true) {
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+		/* The tracing buffer is only written here, with the packets
+		 * of all the CPUs in timestamp order.
+		 */
+		tracing_cpu_buffer_merge();
+#endif
+
 		if (tracing_buffer_is_empty()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
 		} else {
@@ -10,6 +10,61 @@
 #include <tracing_buffer.h>
 #include <tracing_format_common.h>
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Drops are counted per CPU by the buffers */
+static void tracing_format_cpu_put(tracing_data_t *tracing_data_array,
+				   uint32_t count)
+{
+	bool before_put_is_empty;
+
+	if (tracing_cpu_buffer_put(tracing_data_array, count,
+				   &before_put_is_empty)) {
+		tracing_trigger_output(before_put_is_empty);
+	}
+}
+
+void tracing_format_string(const char *str, ...)
+{
+	va_list args;
+	bool put_success, before_put_is_empty;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	va_start(args, str);
+	put_success = tracing_cpu_buffer_string_put(str, args,
+						    &before_put_is_empty);
+	va_end(args);
+
+	if (put_success) {
+		tracing_trigger_output(before_put_is_empty);
+	}
+}
+
+void tracing_format_raw_data(uint8_t *data, uint32_t length)
+{
+	tracing_data_t tracing_data = {
+		.data = data,
+		.length = length,
+	};
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	tracing_format_cpu_put(&tracing_data, 1);
+}
+
+void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	tracing_format_cpu_put(tracing_data_array, count);
+}
+#else
 void tracing_format_string(const char *str, ...)
 {
 	va_list args;
@@ -74,3 +129,4 @@ void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
 		tracing_packet_drop_handle();
 	}
 }
+#endif
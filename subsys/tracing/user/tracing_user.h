@@ -251,6 +251,12 @@ void sys_trace_idle(void);
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
@@ -282,6 +288,12 @@ void sys_trace_idle(void);
 #define sys_port_trace_k_pipe_get_enter(pipe, timeout)
 #define sys_port_trace_k_pipe_get_blocking(pipe, timeout)
 #define sys_port_trace_k_pipe_get_exit(pipe, timeout, ret)
+#define sys_port_trace_k_pipe_put_vec_enter(pipe, timeout)
+#define sys_port_trace_k_pipe_put_vec_blocking(pipe, timeout)
+#define sys_port_trace_k_pipe_put_vec_exit(pipe, timeout, ret)
+#define sys_port_trace_k_pipe_get_vec_enter(pipe, timeout)
+#define sys_port_trace_k_pipe_get_vec_blocking(pipe, timeout)
+#define sys_port_trace_k_pipe_get_vec_exit(pipe, timeout, ret)
 #define sys_port_trace_k_pipe_block_put_enter(pipe, sem)
 #define sys_port_trace_k_pipe_block_put_exit(pipe, sem)
 
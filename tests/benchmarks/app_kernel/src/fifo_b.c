@@ -10,6 +10,54 @@
 
 #ifdef FIFO_BENCH
 
+static const uint32_t batch_sizes[] = { 1, 4, 16, 64 };
+static uint32_t batch_data[64];
+
+/**
+ *
+ * @brief Batched queue transfer speed test
+ *
+ * Per message cost of k_msgq_put_many() and k_msgq_get_many() as a
+ * function of the number of messages moved per call.
+ */
+static void queue_batch_test(void)
+{
+	char label[SLINE_LEN];
+	uint32_t et; /* elapsed time */
+	uint32_t batch;
+	int i;
+
+	for (int b = 0; b < ARRAY_SIZE(batch_sizes); b++) {
+		batch = batch_sizes[b];
+
+		et = BENCH_START();
+		for (i = 0; i < NR_OF_FIFO_RUNS; i += batch) {
+			k_msgq_put_many(&DEMOQX4, batch_data,
+					MIN(batch, NR_OF_FIFO_RUNS - i), K_FOREVER);
+		}
+		et = TIME_STAMP_DELTA_GET(et);
+		check_result();
+
+		snprintf(label, sizeof(label),
+			 "enqueue 4 bytes msg in FIFO, batches of %u", batch);
+		PRINT_F(output_file, FORMAT, label,
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+		et = BENCH_START();
+		for (i = 0; i < NR_OF_FIFO_RUNS; i += batch) {
+			k_msgq_get_many(&DEMOQX4, batch_data,
+					MIN(batch, NR_OF_FIFO_RUNS - i), K_FOREVER);
+		}
+		et = TIME_STAMP_DELTA_GET(et);
+		check_result();
+
+		snprintf(label, sizeof(label),
+			 "dequeue 4 bytes msg in FIFO, batches of %u", batch);
+		PRINT_F(output_file, FORMAT, label,
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	}
+}
+
 /**
  *
  * @brief Queue transfer speed test
@@ -60,6 +108,8 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
+	queue_batch_test();
+
 	k_sem_give(&STARTRCV);
 
 	et = BENCH_START();
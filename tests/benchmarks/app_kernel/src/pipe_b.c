@@ -77,11 +77,15 @@
 	     (uint32_t)(((uint64_t)putsize * 1000000U) / SAFE_DIVISOR(puttime[2])))
 #endif /* FLOAT */
 
+#define PIPE_VEC_SEG_SIZE 16
+#define PIPE_VEC_MAX_SEGS 64
+
 /*
  * Function prototypes.
  */
 int pipeput(struct k_pipe *pipe, enum pipe_options
 		 option, int size, int count, uint32_t *time);
+static void pipe_vec_test(void);
 
 /*
  * Function declarations.
@@ -177,6 +181,69 @@ void pipe_test(void)
 		PRINT_STRING(dashline, output_file);
 		k_thread_priority_set(k_current_get(), TaskPrio);
 	}
+
+	pipe_vec_test();
+}
+
+/**
+ *
+ * @brief Test the vectored pipe transfer speed
+ *
+ * Per segment cost of k_pipe_put_vec() and k_pipe_get_vec() moving
+ * MESSAGE_SIZE_PIPE bytes through the big buffer pipe in 16 byte
+ * segments, as a function of the number of segments per call.
+ */
+static void pipe_vec_test(void)
+{
+	static const size_t batch_sizes[] = { 1, 4, 16, 64 };
+	static struct k_pipe_iovec iov[PIPE_VEC_MAX_SEGS];
+	const int num_segs = MESSAGE_SIZE_PIPE / PIPE_VEC_SEG_SIZE;
+	char label[SLINE_LEN];
+	size_t xferd;
+	uint32_t et;
+
+	for (int i = 0; i < PIPE_VEC_MAX_SEGS; i++) {
+		iov[i].buf = &data_bench[i * PIPE_VEC_SEG_SIZE];
+		iov[i].len = PIPE_VEC_SEG_SIZE;
+	}
+
+	PRINT_STRING("|                      "
+		     "vectored transfers, 16 byte segments"
+		     "                   |\n", output_file);
+	PRINT_STRING(dashline, output_file);
+
+	for (int b = 0; b < ARRAY_SIZE(batch_sizes); b++) {
+		size_t batch = batch_sizes[b];
+
+		et = BENCH_START();
+		for (int i = 0; i < num_segs; i += batch) {
+			k_pipe_put_vec(&PIPE_BIGBUFF, iov, batch, &xferd,
+				       batch * PIPE_VEC_SEG_SIZE, K_NO_WAIT);
+		}
+		et = TIME_STAMP_DELTA_GET(et);
+		check_result();
+
+		snprintf(label, sizeof(label),
+			 "put into big buf pipe, %u segments per call",
+			 (unsigned int)batch);
+		PRINT_F(output_file, FORMAT, label,
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, num_segs));
+
+		et = BENCH_START();
+		for (int i = 0; i < num_segs; i += batch) {
+			k_pipe_get_vec(&PIPE_BIGBUFF, iov, batch, &xferd,
+				       batch * PIPE_VEC_SEG_SIZE, K_NO_WAIT);
+		}
+		et = TIME_STAMP_DELTA_GET(et);
+		check_result();
+
+		snprintf(label, sizeof(label),
+			 "get from big buf pipe, %u segments per call",
+			 (unsigned int)batch);
+		PRINT_F(output_file, FORMAT, label,
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, num_segs));
+	}
+	PRINT_STRING(dashline, output_file);
 }
 
 
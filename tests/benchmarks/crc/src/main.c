@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/timing/timing.h>
+
+/* Throughput of the CRC routines over buffers from 64 B to 64 KiB.
+ * Each size is hashed repeatedly until at least MIN_BYTES have been
+ * processed, and the average cost per call plus the resulting rate
+ * are reported.  The CRC-32 variants depend on the implementation
+ * selected in Kconfig; crc16_ccitt() is included as a fixed point of
+ * comparison between builds.
+ */
+
+#define MAX_LEN (64 * 1024)
+#define MIN_BYTES (256 * 1024)
+
+static const size_t lengths[] = { 64, 256, 1024, 4096, 16384, MAX_LEN };
+
+static uint8_t buf[MAX_LEN];
+
+/* Sink for the results so the calls can't be optimized away */
+static volatile uint32_t sink;
+
+enum algo {
+	ALGO_CRC32_IEEE,
+	ALGO_CRC32_C,
+	ALGO_CRC16_CCITT,
+	ALGO_COUNT,
+};
+
+static const char *const algo_names[ALGO_COUNT] = {
+	[ALGO_CRC32_IEEE] = "crc32_ieee",
+	[ALGO_CRC32_C] = "crc32_c",
+	[ALGO_CRC16_CCITT] = "crc16_ccitt",
+};
+
+static uint32_t run(enum algo algo, const uint8_t *data, size_t len)
+{
+	switch (algo) {
+	case ALGO_CRC32_IEEE:
+		return crc32_ieee(data, len);
+	case ALGO_CRC32_C:
+		return crc32_c(0, data, len, true, true);
+	default:
+		return crc16_ccitt(0xffff, data, len);
+	}
+}
+
+/* Table-driven software variant selected in Kconfig */
+static const char *sw_variant(void)
+{
+	if (IS_ENABLED(CONFIG_CRC32_SW_SLICE_BY_8)) {
+		return "slice_by_8";
+	} else if (IS_ENABLED(CONFIG_CRC32_SW_SLICE_BY_4)) {
+		return "slice_by_4";
+	}
+	return "nibble";
+}
+
+/* The hardware paths are picked with the same tests as lib/os/crc32*_sw.c,
+ * so a CRC_HW_ACCEL build whose target lacks the extension reports the
+ * software variant it really fell back to.
+ */
+static const char *impl_name(enum algo algo)
+{
+	switch (algo) {
+	case ALGO_CRC32_IEEE:
+#if defined(CONFIG_CRC_HW_ACCEL) && defined(__ARM_FEATURE_CRC32)
+		return "armv8 crc32";
+#else
+		return sw_variant();
+#endif
+	case ALGO_CRC32_C:
+#if defined(CONFIG_CRC_HW_ACCEL) && defined(__SSE4_2__)
+		return "sse4.2 crc32";
+#elif defined(CONFIG_CRC_HW_ACCEL) && defined(__ARM_FEATURE_CRC32)
+		return "armv8 crc32c";
+#else
+		return sw_variant();
+#endif
+	default:
+		return "table";
+	}
+}
+
+static void bench(enum algo algo, size_t len)
+{
+	uint32_t iters = MAX(1U, MIN_BYTES / len);
+	timing_t t0, t1;
+	uint64_t ns, kib_s;
+
+	/* Warm the caches (and the tables) first */
+	sink = run(algo, buf, len);
+
+	t0 = timing_counter_get();
+	for (uint32_t i = 0; i < iters; i++) {
+		sink = run(algo, buf, len);
+	}
+	t1 = timing_counter_get();
+
+	ns = timing_cycles_to_ns_avg(timing_cycles_get(&t0, &t1), iters);
+	kib_s = (ns == 0U) ? 0U : ((uint64_t)len * NSEC_PER_SEC) / (ns * 1024U);
+
+	printk("%-11s %6u B %9u ns %9u KiB/s\n", algo_names[algo],
+	       (uint32_t)len, (uint32_t)ns, (uint32_t)kib_s);
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 131U + 17U);
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int a = 0; a < ALGO_COUNT; a++) {
+		printk("%s implementation: %s\n", algo_names[a], impl_name(a));
+		for (int i = 0; i < ARRAY_SIZE(lengths); i++) {
+			bench(a, lengths[i]);
+		}
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
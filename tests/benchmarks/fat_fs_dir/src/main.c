@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/storage/disk_access.h>
+#include <ff.h>
+
+/* Time to list and to open the files of a FAT directory holding more and
+ * more files, with the sectors of the disk cached or not.
+ */
+
+#define DISK_NAME CONFIG_DISK_RAM_VOLUME_NAME
+#define MNTP "/" DISK_NAME ":"
+#define DIR_PATH MNTP "/dir"
+#define PATH_LEN (sizeof(DIR_PATH) + 24)
+#define MAX_FILES 1000
+#define CACHE_SECTORS 128
+#define SECTOR_SIZE 512
+
+static const int file_counts[] = { 100, MAX_FILES };
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = MNTP,
+	.fs_data = &fat_fs,
+};
+
+#if defined(CONFIG_DISK_CACHE)
+DISK_CACHE_DEFINE(ram_cache, CACHE_SECTORS, SECTOR_SIZE);
+#endif
+
+static void file_path(char *path, size_t size, int i)
+{
+	snprintf(path, size, DIR_PATH "/F%04d.TXT", i);
+}
+
+static int create_files(int first, int count)
+{
+	char path[PATH_LEN];
+	struct fs_file_t file;
+	int rc;
+
+	for (int i = first; i < count; i++) {
+		file_path(path, sizeof(path), i);
+		fs_file_t_init(&file);
+
+		rc = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+		if (rc) {
+			return rc;
+		}
+
+		rc = fs_close(&file);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+static uint64_t bench_readdir(int count)
+{
+	struct fs_dirent entry;
+	struct fs_dir_t dir;
+	timing_t start, end;
+	int found = 0;
+
+	fs_dir_t_init(&dir);
+
+	start = timing_counter_get();
+
+	if (fs_opendir(&dir, DIR_PATH)) {
+		return 0;
+	}
+
+	while (fs_readdir(&dir, &entry) == 0 && entry.name[0] != '\0') {
+		found++;
+	}
+
+	(void)fs_closedir(&dir);
+
+	end = timing_counter_get();
+
+	if (found != count) {
+		printk("Listed %d of %d files\n", found, count);
+	}
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&start, &end), count);
+}
+
+static uint64_t bench_open(int count)
+{
+	char path[PATH_LEN];
+	struct fs_file_t file;
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	/* Open the files in an order unrelated to their place in the
+	 * directory, as an application would.
+	 */
+	for (int i = 0; i < count; i++) {
+		file_path(path, sizeof(path), (i * 7919) % count);
+		fs_file_t_init(&file);
+
+		if (fs_open(&file, path, FS_O_READ) || fs_close(&file)) {
+			printk("Cannot open %s\n", path);
+			return 0;
+		}
+	}
+
+	end = timing_counter_get();
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&start, &end), count);
+}
+
+static void print_cache_stats(void)
+{
+#if defined(CONFIG_DISK_CACHE)
+	static struct disk_cache_stats last;
+	struct disk_cache_stats stats;
+
+	if (disk_access_cache_stats(DISK_NAME, &stats) == 0) {
+		printk("cache %8u hits %8u misses\n", stats.hits - last.hits,
+		       stats.misses - last.misses);
+		last = stats;
+	}
+#endif
+}
+
+int main(void)
+{
+	int created = 0;
+	int rc;
+
+	rc = disk_access_init(DISK_NAME);
+	if (rc) {
+		printk("Cannot initialize disk (%d)\n", rc);
+		return 0;
+	}
+
+#if defined(CONFIG_DISK_CACHE)
+	rc = disk_access_cache_attach(DISK_NAME, &ram_cache,
+				      DISK_CACHE_WRITE_BACK);
+	if (rc) {
+		printk("Cannot attach cache (%d)\n", rc);
+		return 0;
+	}
+#endif
+
+	rc = fs_mkfs(FS_FATFS, (uintptr_t)DISK_NAME ":", NULL, 0);
+	if (rc == 0) {
+		rc = fs_mount(&fatfs_mnt);
+	}
+
+	/* The FAT root directory has room for a few hundred files only */
+	if (rc == 0) {
+		rc = fs_mkdir(DIR_PATH);
+	}
+
+	if (rc) {
+		printk("Cannot create file system (%d)\n", rc);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(file_counts); i++) {
+		uint64_t readdir_ns, open_ns;
+
+		rc = create_files(created, file_counts[i]);
+		if (rc) {
+			printk("Cannot create %d files (%d)\n", file_counts[i],
+			       rc);
+			break;
+		}
+		created = file_counts[i];
+
+		print_cache_stats();
+
+		readdir_ns = bench_readdir(created);
+		open_ns = bench_open(created);
+
+		printk("files %4d %6u ns/readdir %6u ns/open\n", created,
+		       (uint32_t)readdir_ns, (uint32_t)open_ns);
+		print_cache_stats();
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
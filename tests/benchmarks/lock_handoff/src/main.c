@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* Two threads of the same priority fight over a mutex, then ping-pong
+ * over a pair of semaphores.  With two CPUs they run in parallel, so
+ * every contended lock or take is released within a short critical
+ * section by a thread running on the other CPU: the case adaptive
+ * spinning is meant for.  The main thread runs at a lower priority
+ * than the workers and only takes the end time once both are done.
+ */
+
+#define ITERATIONS 10000
+#define WORK_LOOPS 50
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+K_MUTEX_DEFINE(mutex);
+K_SEM_DEFINE(ping_sem, 0, 1);
+K_SEM_DEFINE(pong_sem, 0, 1);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2, STACK_SIZE);
+static struct k_thread threads[2];
+
+static volatile uint32_t shared;
+
+static void work(void)
+{
+	for (int i = 0; i < WORK_LOOPS; i++) {
+		shared++;
+	}
+}
+
+static void mutex_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_mutex_lock(&mutex, K_FOREVER);
+		work();
+		k_mutex_unlock(&mutex);
+		work();
+	}
+}
+
+static void ping_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_sem_give(&ping_sem);
+		k_sem_take(&pong_sem, K_FOREVER);
+	}
+}
+
+static void pong_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_sem_take(&ping_sem, K_FOREVER);
+		k_sem_give(&pong_sem);
+	}
+}
+
+/* Average time per handoff, @a handoffs in all */
+static uint32_t bench(k_thread_entry_t entry0, k_thread_entry_t entry1,
+		      uint32_t handoffs)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE, entry0,
+			NULL, NULL, NULL, WORKER_PRIO, 0, K_NO_WAIT);
+	k_thread_create(&threads[1], stacks[1], STACK_SIZE, entry1,
+			NULL, NULL, NULL, WORKER_PRIO, 0, K_NO_WAIT);
+
+	k_thread_join(&threads[0], K_FOREVER);
+	k_thread_join(&threads[1], K_FOREVER);
+
+	end = timing_counter_get();
+
+	return (uint32_t)timing_cycles_to_ns_avg(timing_cycles_get(&start, &end),
+						 handoffs);
+}
+
+static void report(const char *name, uint32_t ns,
+		   const struct k_contention_stats *stats)
+{
+	printk("%-5s %6u ns/handoff contended %6u spun %6u blocked %6u\n",
+	       name, ns, stats->contended, stats->spin_acquired, stats->blocked);
+}
+
+int main(void)
+{
+	struct k_contention_stats stats, pong_stats;
+	uint32_t ns;
+
+	timing_init();
+	timing_start();
+
+	/* Keep the main thread out of the way of the workers */
+	k_thread_priority_set(k_current_get(), K_LOWEST_APPLICATION_THREAD_PRIO);
+
+	printk("adaptive spin %s\n",
+	       IS_ENABLED(CONFIG_ADAPTIVE_SPIN) ? "on" : "off");
+
+	/* Each lock of the mutex counts as a handoff, whether it actually
+	 * changes hands or not.
+	 */
+	ns = bench(mutex_worker, mutex_worker, 2 * ITERATIONS);
+	k_mutex_contention_get(&mutex, &stats, true);
+	report("mutex", ns, &stats);
+
+	ns = bench(ping_worker, pong_worker, 2 * ITERATIONS);
+	k_sem_contention_get(&ping_sem, &stats, true);
+	k_sem_contention_get(&pong_sem, &pong_stats, true);
+	stats.contended += pong_stats.contended;
+	stats.spin_acquired += pong_stats.spin_acquired;
+	stats.blocked += pong_stats.blocked;
+	report("sem", ns, &stats);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
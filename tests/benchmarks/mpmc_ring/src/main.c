@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/mpmc_ring.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a throughput benchmark of k_msgq against mpmc_msgq.  For
+ * each thread count n it starts n producers and n consumers on the
+ * same queue; every producer sends MSGS_PER_THREAD messages and every
+ * consumer receives as many, so the run ends when all consumers have
+ * returned.  The main thread runs at a lower priority than the
+ * workers, so it only measures the end of the run once every worker
+ * is done.
+ */
+
+#define MAX_THREADS 4
+#define MSGS_PER_THREAD 10000
+#define QUEUE_LEN 64
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct msg {
+	uint32_t seq;
+	uint32_t data[3];
+};
+
+struct queue_ops {
+	int (*put)(const void *data);
+	int (*get)(void *data);
+};
+
+K_MSGQ_DEFINE(kmsgq, sizeof(struct msg), QUEUE_LEN, 4);
+MPMC_MSGQ_DEFINE(mpmcq, sizeof(struct msg), QUEUE_LEN);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_THREADS];
+
+static int kmsgq_put(const void *data)
+{
+	return k_msgq_put(&kmsgq, data, K_FOREVER);
+}
+
+static int kmsgq_get(void *data)
+{
+	return k_msgq_get(&kmsgq, data, K_FOREVER);
+}
+
+static int mpmcq_put(const void *data)
+{
+	return mpmc_msgq_put(&mpmcq, data, K_FOREVER);
+}
+
+static int mpmcq_get(void *data)
+{
+	return mpmc_msgq_get(&mpmcq, data, K_FOREVER);
+}
+
+static const struct queue_ops kmsgq_ops = { kmsgq_put, kmsgq_get };
+static const struct queue_ops mpmcq_ops = { mpmcq_put, mpmcq_get };
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	const struct queue_ops *ops = p1;
+	struct msg m = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (m.seq = 0; m.seq < MSGS_PER_THREAD; m.seq++) {
+		(void)ops->put(&m);
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	const struct queue_ops *ops = p1;
+	struct msg m;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < MSGS_PER_THREAD; i++) {
+		(void)ops->get(&m);
+	}
+}
+
+static uint64_t bench(const struct queue_ops *ops, int n)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < n; i++) {
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE,
+				consumer, (void *)ops, NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1],
+				STACK_SIZE, producer, (void *)ops, NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < 2 * n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	end = timing_counter_get();
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&start, &end),
+				       n * MSGS_PER_THREAD);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	/* Keep the main thread out of the way of the workers */
+	k_thread_priority_set(k_current_get(), K_LOWEST_APPLICATION_THREAD_PRIO);
+
+	for (int n = 1; n <= MAX_THREADS; n++) {
+		uint64_t kmsgq_ns = bench(&kmsgq_ops, n);
+		uint64_t mpmcq_ns = bench(&mpmcq_ops, n);
+
+		printk("threads %d k_msgq %6u ns/msg mpmc_msgq %6u ns/msg\n",
+		       n, (uint32_t)kmsgq_ns, (uint32_t)mpmcq_ns);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
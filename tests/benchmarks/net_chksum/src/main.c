@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_chksum_bench, LOG_LEVEL_NONE);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+
+/* Throughput of calc_chksum(), which sums the data covered by the IPv4
+ * header, ICMP, UDP and TCP checksums, over packet sized buffers.  Each
+ * size is summed repeatedly until at least MIN_BYTES have been
+ * processed, starting at an aligned and at an odd address, and the
+ * average cost per call plus the resulting rate are reported.  Then the
+ * cost of recomputing a checksum is compared with updating it after a
+ * 16-bit field changed.
+ */
+
+#define MAX_LEN 1500
+#define MIN_BYTES (256 * 1024)
+#define IPV4_HDR_LEN 20
+
+static const size_t lengths[] = { 64, 128, 256, 512, 1024, MAX_LEN };
+
+/* One spare byte to start at an odd address */
+static uint8_t buf[MAX_LEN + 1] __aligned(8);
+
+/* Sink for the results so the calls can't be optimized away */
+static volatile uint16_t sink;
+
+static uint16_t full_chksum(const uint8_t *data, size_t len)
+{
+	uint16_t sum = calc_chksum(0, data, len);
+
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+static void bench_sum(size_t len, size_t offset)
+{
+	uint32_t iters = MAX(1U, MIN_BYTES / len);
+	timing_t t0, t1;
+	uint64_t ns, mib_s;
+
+	sink = calc_chksum(0, buf + offset, len);
+
+	t0 = timing_counter_get();
+	for (uint32_t i = 0; i < iters; i++) {
+		sink = calc_chksum(0, buf + offset, len);
+	}
+	t1 = timing_counter_get();
+
+	ns = timing_cycles_to_ns_avg(timing_cycles_get(&t0, &t1), iters);
+	mib_s = (ns == 0U) ? 0U : ((uint64_t)len * NSEC_PER_SEC) / (ns * 1024U * 1024U);
+
+	printk("calc_chksum %4u B %-7s %6u ns %6u MiB/s\n", (uint32_t)len,
+	       offset ? "odd" : "aligned", (uint32_t)ns, (uint32_t)mib_s);
+}
+
+/* Rewrite the 16-bit field at offset 2, as the IPv4 total length, and
+ * bring the checksum up to date either way.
+ */
+static void bench_update(size_t len)
+{
+	uint32_t iters = MAX(1U, MIN_BYTES / len);
+	uint16_t chksum = full_chksum(buf, len);
+	uint16_t *field = (uint16_t *)&buf[2];
+	uint16_t orig = *field;
+	timing_t t0, t1;
+	uint64_t full_ns, update_ns;
+
+	t0 = timing_counter_get();
+	for (uint32_t i = 0; i < iters; i++) {
+		*field = (uint16_t)i;
+		sink = full_chksum(buf, len);
+	}
+	t1 = timing_counter_get();
+	full_ns = timing_cycles_to_ns_avg(timing_cycles_get(&t0, &t1), iters);
+
+	*field = orig;
+
+	t0 = timing_counter_get();
+	for (uint32_t i = 0; i < iters; i++) {
+		uint16_t old_val = *field;
+
+		*field = (uint16_t)i;
+		chksum = net_chksum_update16(chksum, old_val, *field);
+	}
+	t1 = timing_counter_get();
+	update_ns = timing_cycles_to_ns_avg(timing_cycles_get(&t0, &t1), iters);
+
+	if (chksum != full_chksum(buf, len)) {
+		printk("Incremental update mismatch for %u B\n", (uint32_t)len);
+	}
+
+	*field = orig;
+
+	printk("recompute   %4u B %6u ns\n", (uint32_t)len, (uint32_t)full_ns);
+	printk("update      %4u B %6u ns\n", (uint32_t)len, (uint32_t)update_ns);
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 131U + 17U);
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("checksum implementation: %s\n",
+	       IS_ENABLED(CONFIG_NET_IP_CHKSUM_SSE2) ? "sse2" : "generic");
+
+	for (int i = 0; i < ARRAY_SIZE(lengths); i++) {
+		bench_sum(lengths[i], 0);
+		bench_sum(lengths[i], 1);
+	}
+
+	bench_update(IPV4_HDR_LEN);
+	bench_update(MAX_LEN);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#include "connection.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* Cost of demultiplexing a received UDP packet to its connection
+ * handler as the number of registered handlers grows.  Half of the
+ * handlers are bound to a port of their own, the other half are
+ * connected to different peers on one shared local port, like the
+ * connections accepted by a server.  For each number of handlers,
+ * net_conn_input() is called repeatedly with a packet for the oldest
+ * bound handler and with one for the oldest connected handler, which
+ * are the last ones a linear walk of the handlers reaches.
+ */
+
+#define ITERATIONS 1000
+#define SHARED_PORT 5000
+#define BOUND_PORT_BASE 10000
+#define PEER_PORT_BASE 20000
+
+static const int num_conns[] = { 8, 32, 128, CONFIG_NET_MAX_CONN };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+
+static uint32_t delivered;
+
+static void iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int iface_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api iface_api = {
+	.iface_api.init = iface_init,
+	.send = iface_send,
+};
+
+NET_DEVICE_INIT(demux_bench, "demux_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* Leaves the packet to the caller, so it can be fed in again */
+static enum net_verdict handler(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	delivered++;
+
+	return NET_OK;
+}
+
+static void peer_addr(int n, struct sockaddr_in *addr)
+{
+	addr->sin_family = AF_INET;
+	addr->sin_addr.s4_addr[0] = 198;
+	addr->sin_addr.s4_addr[1] = 51;
+	addr->sin_addr.s4_addr[2] = 100;
+	addr->sin_addr.s4_addr[3] = 1 + n % 200;
+}
+
+static void register_conn(int n)
+{
+	struct net_conn_handle *handle;
+	struct sockaddr_in peer;
+	int ret;
+
+	if (n % 2 == 0) {
+		ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL, NULL, 0,
+					BOUND_PORT_BASE + n, NULL, handler,
+					NULL, &handle);
+	} else {
+		peer_addr(n, &peer);
+		ret = net_conn_register(IPPROTO_UDP, AF_INET,
+					(struct sockaddr *)&peer, NULL,
+					PEER_PORT_BASE + n, SHARED_PORT, NULL,
+					handler, NULL, &handle);
+	}
+
+	if (ret < 0) {
+		printk("Cannot register handler %d (%d)\n", n, ret);
+		k_panic();
+	}
+}
+
+static struct net_pkt *create_pkt(struct net_if *iface, int n,
+				  uint16_t dst_port)
+{
+	struct sockaddr_in peer;
+	struct net_pkt *pkt;
+
+	peer_addr(n, &peer);
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_udp_hdr),
+					AF_INET, IPPROTO_UDP, K_FOREVER);
+	if (net_ipv4_create(pkt, &peer.sin_addr, &my_addr) ||
+	    net_udp_create(pkt, htons(PEER_PORT_BASE + n), htons(dst_port))) {
+		printk("Cannot create packet\n");
+		k_panic();
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+/* Average cost of one net_conn_input() call for @a pkt */
+static uint32_t bench(struct net_pkt *pkt)
+{
+	union net_ip_header ip_hdr;
+	union net_proto_header proto_hdr;
+	timing_t start, end;
+
+	ip_hdr.ipv4 = NET_IPV4_HDR(pkt);
+	proto_hdr.udp = (struct net_udp_hdr *)((uint8_t *)ip_hdr.ipv4 +
+					       sizeof(struct net_ipv4_hdr));
+	delivered = 0U;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	end = timing_counter_get();
+
+	if (delivered != ITERATIONS) {
+		printk("Only %u of %u packets delivered\n", delivered,
+		       ITERATIONS);
+	}
+
+	return (uint32_t)timing_cycles_to_ns_avg(timing_cycles_get(&start, &end),
+						 ITERATIONS);
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct net_pkt *bound_pkt, *connected_pkt;
+	int n = 0;
+
+	net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+
+	/* Handlers 0 and 1 are registered first, so are the oldest */
+	bound_pkt = create_pkt(iface, 0, BOUND_PORT_BASE);
+	connected_pkt = create_pkt(iface, 1, SHARED_PORT);
+
+	timing_init();
+	timing_start();
+
+	printk("connection lookup: %s\n",
+	       IS_ENABLED(CONFIG_NET_CONN_HASH) ? "hash" : "list");
+
+	for (int i = 0; i < ARRAY_SIZE(num_conns); i++) {
+		uint32_t bound_ns, connected_ns;
+
+		for (; n < num_conns[i]; n++) {
+			register_conn(n);
+		}
+
+		bound_ns = bench(bound_pkt);
+		connected_ns = bench(connected_pkt);
+
+		printk("conns %3d bound %6u ns connected %6u ns\n", n,
+		       bound_ns, connected_ns);
+	}
+
+	timing_stop();
+
+	net_pkt_unref(bound_pkt);
+	net_pkt_unref(connected_pkt);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+
+/* Wakeup latency and per call cost of zsock_poll() against
+ * zsock_epoll_wait() over a growing number of socketpair descriptors.
+ * The descriptors are the two ends of each pair, a byte written into one
+ * end makes the other one readable.
+ */
+
+#define MAX_FDS 256
+#define ITERATIONS 200
+#define WAITER_STACK_SIZE 16384
+
+enum mode {
+	MODE_POLL,
+	MODE_EPOLL,
+};
+
+static const int fd_counts[] = { 8, 64, 256 };
+
+static int fds[MAX_FDS];
+static int peers[MAX_FDS];
+
+static struct zsock_pollfd pollfds[MAX_FDS];
+static int epfd;
+
+static enum mode mode;
+static int nfds;
+
+static K_SEM_DEFINE(start, 0, 1);
+static K_SEM_DEFINE(done, 0, 1);
+static timing_t woken;
+static int woken_fd;
+
+static K_THREAD_STACK_DEFINE(waiter_stack, WAITER_STACK_SIZE);
+static struct k_thread waiter_thread;
+
+/* Returns the readable descriptor, as the application would find it */
+static int wait_ready(int timeout)
+{
+	struct zsock_epoll_event event;
+	int ret;
+
+	if (mode == MODE_EPOLL) {
+		ret = zsock_epoll_wait(epfd, &event, 1, timeout);
+
+		return ret > 0 ? event.data.fd : -1;
+	}
+
+	ret = zsock_poll(pollfds, nfds, timeout);
+	if (ret <= 0) {
+		return -1;
+	}
+
+	for (int i = 0; i < nfds; i++) {
+		if (pollfds[i].revents & ZSOCK_POLLIN) {
+			return pollfds[i].fd;
+		}
+	}
+
+	return -1;
+}
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		char c;
+
+		k_sem_take(&start, K_FOREVER);
+
+		woken_fd = wait_ready(SYS_FOREVER_MS);
+		woken = timing_counter_get();
+
+		(void)zsock_recv(woken_fd, &c, 1, 0);
+
+		k_sem_give(&done);
+	}
+}
+
+static void setup(int count)
+{
+	struct zsock_epoll_event event = { .events = ZSOCK_EPOLLIN };
+
+	nfds = count;
+
+	for (int i = 0; i < nfds; i++) {
+		pollfds[i].fd = fds[i];
+		pollfds[i].events = ZSOCK_POLLIN;
+
+		event.data.fd = fds[i];
+		if (zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, fds[i], &event) < 0) {
+			printk("Cannot register fd %d (%d)\n", fds[i], errno);
+		}
+	}
+}
+
+static void teardown(void)
+{
+	for (int i = 0; i < nfds; i++) {
+		(void)zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, fds[i], NULL);
+	}
+}
+
+static uint64_t bench_wakeup(void)
+{
+	uint64_t cycles = 0;
+	int errors = 0;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		/* Spread the ready descriptor over the whole set */
+		int idx = (i * 7919) % nfds;
+		timing_t t0;
+
+		/* The waiter runs first and blocks on all the descriptors */
+		k_sem_give(&start);
+
+		t0 = timing_counter_get();
+		(void)zsock_send(peers[idx], "x", 1, 0);
+		k_sem_take(&done, K_FOREVER);
+
+		cycles += timing_cycles_get(&t0, &woken);
+		if (woken_fd != fds[idx]) {
+			errors++;
+		}
+	}
+
+	if (errors > 0) {
+		printk("%d wakeups on the wrong descriptor\n", errors);
+	}
+
+	return timing_cycles_to_ns_avg(cycles, ITERATIONS);
+}
+
+static uint64_t bench_check(void)
+{
+	int idx = nfds / 2;
+	timing_t t0, t1;
+	char c;
+
+	(void)zsock_send(peers[idx], "x", 1, 0);
+
+	t0 = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		if (wait_ready(0) != fds[idx]) {
+			printk("Ready descriptor not found\n");
+			break;
+		}
+	}
+	t1 = timing_counter_get();
+
+	(void)zsock_recv(fds[idx], &c, 1, 0);
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&t0, &t1), ITERATIONS);
+}
+
+int main(void)
+{
+	for (int i = 0; i < MAX_FDS; i += 2) {
+		int sv[2];
+
+		if (zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+			printk("Cannot create socketpair (%d)\n", errno);
+			return 0;
+		}
+
+		fds[i] = sv[0];
+		peers[i] = sv[1];
+		fds[i + 1] = sv[1];
+		peers[i + 1] = sv[0];
+	}
+
+	epfd = zsock_epoll_create(0);
+	if (epfd < 0) {
+		printk("Cannot create epoll instance (%d)\n", errno);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	k_thread_create(&waiter_thread, waiter_stack,
+			K_THREAD_STACK_SIZEOF(waiter_stack), waiter,
+			NULL, NULL, NULL,
+			K_PRIO_COOP(CONFIG_NUM_COOP_PRIORITIES - 1), 0, K_NO_WAIT);
+
+	for (int i = 0; i < ARRAY_SIZE(fd_counts); i++) {
+		setup(fd_counts[i]);
+
+		for (mode = MODE_POLL; mode <= MODE_EPOLL; mode++) {
+			uint64_t wakeup_ns = bench_wakeup();
+			uint64_t check_ns = bench_check();
+
+			printk("%-5s %3d fds wakeup %6u ns check %6u ns\n",
+			       mode == MODE_POLL ? "poll" : "epoll", nfds,
+			       (uint32_t)wakeup_ns, (uint32_t)check_ns);
+		}
+
+		teardown();
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
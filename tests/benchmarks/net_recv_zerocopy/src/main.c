@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/zperf.h>
+
+/* Rate and CPU load of a zperf TCP server receiving over the loopback
+ * interface from a zperf client on the same system, with the server
+ * copying the data out of the network buffers and with it receiving
+ * them zero-copy.
+ */
+
+#define PORT 5001
+#define DURATION_MS 5000
+#define PACKET_SIZE 1024
+
+static K_SEM_DEFINE(session_done, 0, 1);
+static struct zperf_results server_results;
+
+static void server_cb(enum zperf_status status, struct zperf_results *result,
+		      void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		server_results = *result;
+		k_sem_give(&session_done);
+	} else if (status == ZPERF_SESSION_ERROR) {
+		memset(&server_results, 0, sizeof(server_results));
+		k_sem_give(&session_done);
+	}
+}
+
+static void run(bool zerocopy)
+{
+	struct zperf_download_params download = {
+		.port = PORT,
+		.zerocopy = zerocopy,
+	};
+	struct zperf_upload_params upload = { 0 };
+	struct zperf_results results;
+	struct sockaddr_in *peer = (struct sockaddr_in *)&upload.peer_addr;
+	struct in_addr loopback = INADDR_LOOPBACK_INIT;
+	uint64_t kbps = 0;
+	int ret;
+
+	ret = zperf_tcp_download(&download, server_cb, NULL);
+	if (ret < 0) {
+		printk("Cannot start the zperf server (%d)\n", ret);
+		return;
+	}
+
+	/* Let the server thread start listening */
+	k_msleep(100);
+
+	peer->sin_family = AF_INET;
+	peer->sin_port = htons(PORT);
+	peer->sin_addr = loopback;
+	upload.duration_ms = DURATION_MS;
+	upload.packet_size = PACKET_SIZE;
+
+	ret = zperf_tcp_upload(&upload, &results);
+
+	/* The server only reports once it has seen the end of the stream */
+	if (ret == 0 && k_sem_take(&session_done, K_SECONDS(30)) == 0 &&
+	    server_results.time_in_us > 0) {
+		kbps = (uint64_t)server_results.total_len * 8U * USEC_PER_MSEC /
+		       server_results.time_in_us;
+	} else {
+		printk("Upload failed (%d)\n", ret);
+		server_results.cpu_load = 0;
+	}
+
+	printk("%-9s %6u kbps cpu load %3u.%u%%\n", zerocopy ? "zero-copy" : "copy",
+	       (uint32_t)kbps, server_results.cpu_load / 10U,
+	       server_results.cpu_load % 10U);
+
+	zperf_tcp_download_stop();
+
+	/* Let the server thread notice it has to stop */
+	k_msleep(300);
+}
+
+int main(void)
+{
+	run(false);
+	run(true);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_route_lookup_bench, LOG_LEVEL_NONE);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "route.h"
+
+/* Time of a route lookup with more and more routes in the table. Every
+ * third route is a /48 prefix, the others are /64 and /128 prefixes which
+ * may be nested in one of the /48 ones. Lookups either find the route of
+ * one of the prefixes or miss them all.
+ */
+
+#define MAX_ROUTES CONFIG_NET_MAX_ROUTES
+#define LOOKUPS 4096
+
+/* The neighbor reference count limits the routes via one next hop */
+#define NEXTHOPS 8
+
+static const int route_counts[] = { 16, 256, MAX_ROUTES };
+
+static struct in6_addr nexthops[NEXTHOPS];
+
+static struct net_if *iface;
+static struct net_route_entry *routes[MAX_ROUTES];
+static struct in6_addr targets[MAX_ROUTES];
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_lookup_bench, "net_route_lookup_bench", NULL, NULL,
+		NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static inline uint32_t hash(uint32_t i)
+{
+	return i * 2654435761U;
+}
+
+/* 2001:db8:a:b::c/len */
+static void set_addr(struct in6_addr *addr, uint16_t a, uint16_t b, uint16_t c)
+{
+	memset(addr, 0, sizeof(*addr));
+
+	UNALIGNED_PUT(htons(0x2001), &addr->s6_addr16[0]);
+	UNALIGNED_PUT(htons(0x0db8), &addr->s6_addr16[1]);
+	UNALIGNED_PUT(htons(a), &addr->s6_addr16[2]);
+	UNALIGNED_PUT(htons(b), &addr->s6_addr16[3]);
+	UNALIGNED_PUT(htons(c), &addr->s6_addr16[7]);
+}
+
+static int add_routes(int count)
+{
+	struct in6_addr prefix;
+	uint8_t len;
+
+	for (int i = 0; i < count; i++) {
+		uint32_t h = hash(i);
+
+		if (i % 3 == 0) {
+			set_addr(&prefix, i, 0, 0);
+			len = 48U;
+		} else if (i % 3 == 1) {
+			set_addr(&prefix, h % MAX_ROUTES, i, 0);
+			len = 64U;
+		} else {
+			set_addr(&prefix, h % MAX_ROUTES, i, h >> 16);
+			len = 128U;
+		}
+
+		routes[i] = net_route_add(iface, &prefix, len,
+					  &nexthops[i % NEXTHOPS],
+					  NET_IPV6_ND_INFINITE_LIFETIME,
+					  NET_ROUTE_PREFERENCE_LOW);
+		if (!routes[i]) {
+			return -ENOMEM;
+		}
+
+		targets[i] = prefix;
+
+		if (len < 128U) {
+			targets[i].s6_addr[15] = 0x01;
+		}
+	}
+
+	return 0;
+}
+
+static void del_routes(int count)
+{
+	for (int i = 0; i < count; i++) {
+		(void)net_route_del(routes[i]);
+	}
+}
+
+static uint64_t bench_lookup(int count)
+{
+	timing_t start, end;
+	int found = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		if (net_route_lookup(iface, &targets[i % count])) {
+			found++;
+		}
+	}
+
+	end = timing_counter_get();
+
+	if (found != LOOKUPS) {
+		printk("Only %d routes found\n", found);
+	}
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&start, &end), LOOKUPS);
+}
+
+static uint64_t bench_miss(void)
+{
+	struct in6_addr addr;
+	timing_t start, end;
+	int found = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		/* Never the first group of an added prefix */
+		set_addr(&addr, 0x8000 | hash(i), i, 1);
+
+		if (net_route_lookup(iface, &addr)) {
+			found++;
+		}
+	}
+
+	end = timing_counter_get();
+
+	if (found != 0) {
+		printk("%d routes found for unrouted addresses\n", found);
+	}
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&start, &end), LOOKUPS);
+}
+
+static int add_nexthops(void)
+{
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x00 };
+	struct net_linkaddr lladdr = {
+		.addr = mac,
+		.len = sizeof(mac),
+	};
+
+	for (int i = 0; i < NEXTHOPS; i++) {
+		/* fe80::x */
+		nexthops[i].s6_addr[0] = 0xfe;
+		nexthops[i].s6_addr[1] = 0x80;
+		nexthops[i].s6_addr[15] = i + 2;
+		mac[5] = i + 2;
+
+		if (!net_ipv6_nbr_add(iface, &nexthops[i], &lladdr, false,
+				      NET_IPV6_NBR_STATE_STATIC)) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (!iface) {
+		printk("No dummy interface\n");
+		return 0;
+	}
+
+	if (add_nexthops() < 0) {
+		printk("Cannot add next hop neighbors\n");
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(route_counts); i++) {
+		uint64_t hit_ns, miss_ns;
+
+		if (add_routes(route_counts[i]) < 0) {
+			printk("Cannot add %d routes\n", route_counts[i]);
+			break;
+		}
+
+		hit_ns = bench_lookup(route_counts[i]);
+		miss_ns = bench_miss();
+
+		printk("routes %4d %6u ns/lookup %6u ns/miss\n",
+		       route_counts[i], (uint32_t)hit_ns, (uint32_t)miss_ns);
+
+		del_routes(route_counts[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
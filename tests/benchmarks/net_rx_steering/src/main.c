@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_rx_steering_bench, LOG_LEVEL_NONE);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+#include "net_stats.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* Time to receive UDP packets of several concurrent flows, with the flows
+ * steered to several RX queues or all processed by the one RX thread of
+ * the traffic class. Each packet costs some busy work in the receive
+ * callback, standing for the application, so that on SMP the steered
+ * flows are processed in parallel. Packets are counted as reordered when
+ * they arrive before an earlier packet of their flow.
+ */
+
+#define TEST_PORT 4242
+#define FLOW_PORT 5000
+#define MAX_FLOWS 8
+#define PKTS 512
+#define WORK_US 20
+#define ALLOC_TIMEOUT K_MSEC(100)
+
+static const int flow_counts[] = { 1, 2, 4, MAX_FLOWS };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static struct net_context *udp_ctx;
+static K_SEM_DEFINE(all_received, 0, 1);
+
+static uint32_t next_seq[MAX_FLOWS];
+static atomic_t received;
+static atomic_t reordered;
+static timing_t last;
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_rx_steering_bench, "net_rx_steering_bench", NULL, NULL,
+		NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static void recv_cb(struct net_context *context, struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr,
+		    union net_proto_header *proto_hdr,
+		    int status, void *user_data)
+{
+	int flow = ntohs(proto_hdr->udp->src_port) - FLOW_PORT;
+	uint32_t seq;
+
+	ARG_UNUSED(context);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(status);
+	ARG_UNUSED(user_data);
+
+	k_busy_wait(WORK_US);
+
+	/* A flow is only ever processed by one thread at a time */
+	if (net_pkt_read_be32(pkt, &seq) == 0 && flow >= 0 && flow < MAX_FLOWS) {
+		if (seq < next_seq[flow]) {
+			atomic_inc(&reordered);
+		} else {
+			next_seq[flow] = seq + 1;
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	if (atomic_inc(&received) + 1 == PKTS) {
+		last = timing_counter_get();
+		k_sem_give(&all_received);
+	}
+}
+
+static int recv_udp(int flow, uint32_t seq)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, NET_UDPH_LEN + sizeof(seq),
+					   AF_INET, IPPROTO_UDP, ALLOC_TIMEOUT);
+	if (!pkt) {
+		return -ENOMEM;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &my_addr) ||
+	    net_udp_create(pkt, htons(FLOW_PORT + flow), htons(TEST_PORT)) ||
+	    net_pkt_write_be32(pkt, seq)) {
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	ret = net_ipv4_finalize(pkt, IPPROTO_UDP);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	ret = net_recv_data(iface, pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return 0;
+
+fail:
+	net_pkt_unref(pkt);
+	return ret;
+}
+
+static uint64_t bench_flows(int flows)
+{
+	timing_t start;
+
+	memset(next_seq, 0, sizeof(next_seq));
+	atomic_set(&received, 0);
+	atomic_set(&reordered, 0);
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < PKTS; i++) {
+		if (recv_udp(i % flows, i / flows) < 0) {
+			printk("Cannot receive packet %d\n", i);
+			return 0;
+		}
+	}
+
+	if (k_sem_take(&all_received, K_SECONDS(10))) {
+		printk("Only %ld packets received\n", atomic_get(&received));
+		return 0;
+	}
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&start, &last), PKTS);
+}
+
+static void print_queue_stats(void)
+{
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	for (int i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		printk("queue %d %u packets\n", i,
+		       GET_STAT(iface, rx_queue[i].pkts));
+	}
+#endif
+}
+
+int main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_PORT),
+		.sin_addr = { { { 192, 0, 2, 1 } } },
+	};
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (!iface) {
+		printk("No dummy interface\n");
+		return 0;
+	}
+
+	if (!net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Cannot add IPv4 address\n");
+		return 0;
+	}
+
+	if (net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &udp_ctx) < 0 ||
+	    net_context_bind(udp_ctx, (struct sockaddr *)&addr,
+			     sizeof(addr)) < 0 ||
+	    net_context_recv(udp_ctx, recv_cb, K_NO_WAIT, NULL) < 0) {
+		printk("Cannot set up UDP context\n");
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("%d RX queues, %d CPUs\n", NET_RX_QUEUE_COUNT,
+	       arch_num_cpus());
+
+	for (int i = 0; i < ARRAY_SIZE(flow_counts); i++) {
+		uint64_t ns = bench_flows(flow_counts[i]);
+
+		printk("flows %d %6u ns/packet %4ld reordered\n",
+		       flow_counts[i], (uint32_t)ns, atomic_get(&reordered));
+	}
+
+	print_queue_stats();
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
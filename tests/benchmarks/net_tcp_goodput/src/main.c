@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+#include <zephyr/net/loopback.h>
+#include <zephyr/net/zperf.h>
+
+/* TCP goodput over the loopback interface while it drops a growing share
+ * of the packets, measured with a zperf upload to a zperf server running
+ * on the same interface.  The loopback driver drops packets evenly, one
+ * in every 1/ratio, which hits data segments and ACKs alike.
+ */
+
+#define PORT 5001
+#define DURATION_MS 5000
+#define PACKET_SIZE 1024
+
+static const int drop_percent[] = { 0, 1, 2, 5 };
+
+static K_SEM_DEFINE(session_done, 0, 1);
+static struct zperf_results server_results;
+
+static void server_cb(enum zperf_status status, struct zperf_results *result,
+		      void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		server_results = *result;
+		k_sem_give(&session_done);
+	} else if (status == ZPERF_SESSION_ERROR) {
+		memset(&server_results, 0, sizeof(server_results));
+		k_sem_give(&session_done);
+	}
+}
+
+static void get_tcp_stats(struct net_stats_tcp *stats)
+{
+	if (net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, stats, sizeof(*stats))) {
+		memset(stats, 0, sizeof(*stats));
+	}
+}
+
+static void run(int percent)
+{
+	struct zperf_upload_params params = { 0 };
+	struct zperf_results results;
+	struct net_stats_tcp before, after;
+	struct sockaddr_in *peer = (struct sockaddr_in *)&params.peer_addr;
+	struct in_addr loopback = INADDR_LOOPBACK_INIT;
+	uint64_t kbps = 0;
+	int ret;
+
+	peer->sin_family = AF_INET;
+	peer->sin_port = htons(PORT);
+	peer->sin_addr = loopback;
+	params.duration_ms = DURATION_MS;
+	params.packet_size = PACKET_SIZE;
+
+	get_tcp_stats(&before);
+	loopback_set_packet_drop_ratio(percent / 100.0f);
+
+	ret = zperf_tcp_upload(&params, &results);
+
+	/* The server only reports once it has seen the end of the stream */
+	if (ret == 0 && k_sem_take(&session_done, K_SECONDS(30)) == 0 &&
+	    server_results.time_in_us > 0) {
+		kbps = (uint64_t)server_results.total_len * 8U * USEC_PER_MSEC /
+		       server_results.time_in_us;
+	} else {
+		printk("Upload failed (%d)\n", ret);
+	}
+
+	loopback_set_packet_drop_ratio(0.0f);
+	get_tcp_stats(&after);
+
+	printk("drop %2d%% goodput %6u kbps fast recovery %3u rto %3u\n",
+	       percent, (uint32_t)kbps, after.fast_recovery - before.fast_recovery,
+	       after.rto - before.rto);
+}
+
+int main(void)
+{
+	struct zperf_download_params params = { .port = PORT };
+	int ret;
+
+	ret = zperf_tcp_download(&params, server_cb, NULL);
+	if (ret < 0) {
+		printk("Cannot start the zperf server (%d)\n", ret);
+		return 0;
+	}
+
+	/* Let the server thread start listening */
+	k_msleep(100);
+
+	printk("congestion control: %s\n",
+	       IS_ENABLED(CONFIG_NET_TCP_CC_DEFAULT_CUBIC) ? "cubic" :
+	       IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL) ? "newreno" : "none");
+
+	for (int i = 0; i < ARRAY_SIZE(drop_percent); i++) {
+		run(drop_percent[i]);
+	}
+
+	zperf_tcp_download_stop();
+
+	printk("fin\n");
+	return 0;
+}
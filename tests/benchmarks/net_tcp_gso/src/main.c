@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_tcp_gso_bench, LOG_LEVEL_NONE);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#include "ipv4.h"
+#include "net_private.h"
+
+/* Cost of sending TCP data one segment per packet, against several
+ * segments in one large packet which is cut right before the interface.
+ * The packets are built as TCP builds them, every segment in buffers of
+ * its own, and sent to a dummy interface dropping them.  Only finalizing
+ * and sending them is measured.
+ */
+
+#define MSS 1460
+#define MAX_SEGS 8
+#define ITERATIONS 100
+#define TCP_PSH_ACK 0x18
+
+static const int seg_counts[] = { 2, 4, MAX_SEGS };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static uint8_t payload[MSS];
+static struct net_if *iface;
+static uint32_t seq;
+static uint32_t sent;
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+
+	if (net_pkt_get_len(pkt) <= NET_IPV4H_LEN + NET_TCPH_LEN + MSS) {
+		sent++;
+	}
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_tcp_gso_bench, "net_tcp_gso_bench", NULL, NULL, NULL,
+		NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static struct net_pkt *build(int segs)
+{
+	struct net_tcp_hdr th = {
+		.src_port = htons(4242),
+		.dst_port = htons(4242),
+		.offset = 5 << 4,
+		.flags = TCP_PSH_ACK,
+		.wnd = { 0xff, 0xff },
+	};
+	struct net_pkt *pkt;
+
+	sys_put_be32(seq, th.seq);
+	seq += segs * MSS;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(th), AF_INET,
+					IPPROTO_TCP, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &my_addr, &peer_addr) ||
+	    net_pkt_write(pkt, &th, sizeof(th))) {
+		goto fail;
+	}
+
+	for (int i = 0; i < segs; i++) {
+		struct net_pkt *seg;
+
+		seg = net_pkt_alloc_with_buffer(iface, MSS, AF_UNSPEC, 0,
+						K_NO_WAIT);
+		if (!seg) {
+			goto fail;
+		}
+
+		if (net_pkt_write(seg, payload, MSS)) {
+			net_pkt_unref(seg);
+			goto fail;
+		}
+
+		net_pkt_append_buffer(pkt, seg->buffer);
+		seg->buffer = NULL;
+		net_pkt_unref(seg);
+	}
+
+	if (segs > 1) {
+		net_pkt_set_gso_size(pkt, MSS);
+	}
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+static int send_pkt(struct net_pkt *pkt)
+{
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+
+	ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	if (ret == 0) {
+		ret = net_send_data(pkt);
+	}
+
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static uint64_t bench_single(int segs)
+{
+	struct net_pkt *pkts[MAX_SEGS];
+	uint64_t cycles = 0;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		timing_t t0, t1;
+
+		for (int j = 0; j < segs; j++) {
+			pkts[j] = build(1);
+			if (!pkts[j]) {
+				printk("Cannot build packet\n");
+				return 0;
+			}
+		}
+
+		t0 = timing_counter_get();
+		for (int j = 0; j < segs; j++) {
+			(void)send_pkt(pkts[j]);
+		}
+		t1 = timing_counter_get();
+
+		cycles += timing_cycles_get(&t0, &t1);
+	}
+
+	return timing_cycles_to_ns_avg(cycles, ITERATIONS * segs);
+}
+
+static uint64_t bench_large(int segs)
+{
+	uint64_t cycles = 0;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		struct net_pkt *pkt = build(segs);
+		timing_t t0, t1;
+
+		if (!pkt) {
+			printk("Cannot build packet\n");
+			return 0;
+		}
+
+		t0 = timing_counter_get();
+		(void)send_pkt(pkt);
+		t1 = timing_counter_get();
+
+		cycles += timing_cycles_get(&t0, &t1);
+	}
+
+	return timing_cycles_to_ns_avg(cycles, ITERATIONS * segs);
+}
+
+int main(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (!iface) {
+		printk("No dummy interface\n");
+		return 0;
+	}
+
+	if (!net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Cannot add IPv4 address\n");
+		return 0;
+	}
+
+	for (int i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(seg_counts); i++) {
+		int segs = seg_counts[i];
+
+		sent = 0;
+		printk("single %d segs %6u ns/segment\n", segs,
+		       (uint32_t)bench_single(segs));
+		printk("large  %d segs %6u ns/segment\n", segs,
+		       (uint32_t)bench_large(segs));
+
+		if (sent != 2 * ITERATIONS * segs) {
+			printk("%u segments reached the interface, expected %u\n",
+			       sent, 2 * ITERATIONS * segs);
+		}
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+
+/* Datagrams per second over the loopback interface, sent and received
+ * one per socket call and in batches of BATCH per call.
+ */
+
+#define PORT 4242
+#define BATCH 32
+#define ROUNDS 64
+#define MAX_LEN 512
+
+static const size_t lengths[] = { 16, 64, MAX_LEN };
+
+static uint8_t tx_buf[BATCH][MAX_LEN];
+static uint8_t rx_buf[BATCH][MAX_LEN];
+static struct iovec tx_iov[BATCH];
+static struct iovec rx_iov[BATCH];
+static struct zsock_mmsghdr tx_msgs[BATCH];
+static struct zsock_mmsghdr rx_msgs[BATCH];
+
+static int round_single(int client, int server, size_t len)
+{
+	for (int i = 0; i < BATCH; i++) {
+		if (zsock_send(client, tx_buf[i], len, 0) != len) {
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < BATCH; i++) {
+		if (zsock_recv(server, rx_buf[i], MAX_LEN, 0) != len) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int round_batch(int client, int server, size_t len)
+{
+	int received = 0;
+	int ret;
+
+	for (int i = 0; i < BATCH; i++) {
+		tx_iov[i].iov_len = len;
+		rx_iov[i].iov_len = MAX_LEN;
+	}
+
+	if (zsock_sendmmsg(client, tx_msgs, BATCH, 0) != BATCH) {
+		return -1;
+	}
+
+	/* Datagrams still on their way through the loopback interface are
+	 * picked up by the next call.
+	 */
+	while (received < BATCH) {
+		ret = zsock_recvmmsg(server, &rx_msgs[received],
+				     BATCH - received, ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			return -1;
+		}
+
+		received += ret;
+	}
+
+	return 0;
+}
+
+static void bench(const char *name, int (*round)(int, int, size_t),
+		  int client, int server, size_t len)
+{
+	timing_t t0, t1;
+	uint64_t ns, rate;
+
+	t0 = timing_counter_get();
+	for (int i = 0; i < ROUNDS; i++) {
+		if (round(client, server, len) < 0) {
+			printk("%s %u B failed (%d)\n", name, (uint32_t)len, errno);
+			return;
+		}
+	}
+	t1 = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&t0, &t1));
+	rate = (ns == 0U) ? 0U : (uint64_t)ROUNDS * BATCH * NSEC_PER_SEC / ns;
+
+	printk("%-6s %4u B %8u datagrams/s\n", name, (uint32_t)len, (uint32_t)rate);
+}
+
+int main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	int client, server;
+
+	for (int i = 0; i < BATCH; i++) {
+		memset(tx_buf[i], 'a' + i, MAX_LEN);
+		tx_iov[i].iov_base = tx_buf[i];
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+		rx_iov[i].iov_base = rx_buf[i];
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	server = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	client = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (server < 0 || client < 0 ||
+	    zsock_bind(server, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    zsock_connect(client, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("Cannot set up the sockets (%d)\n", errno);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(lengths); i++) {
+		bench("single", round_single, client, server, lengths[i]);
+		bench("batch", round_batch, client, server, lengths[i]);
+	}
+
+	timing_stop();
+
+	zsock_close(client);
+	zsock_close(server);
+
+	printk("fin\n");
+	return 0;
+}
@@ -27,6 +27,19 @@
  * It then iterates this many times, reporting timestamp latencies
  * between each numbered step and for the whole cycle, and a running
  * average for all cycles run.
+ *
+ * On SMP builds it then runs a contention phase: for N from 1 to
+ * arch_num_cpus(), 2*N equal priority threads loop on k_yield() so
+ * that up to N CPUs are switching concurrently.  It reports the
+ * average cost of a yield (switch latency), which grows as the cores
+ * serialize on the scheduler spinlock around the shared ready queue.
+ *
+ * Finally it measures how the wait queue scales: more and more
+ * "waiter" threads of the partner's priority are pended on the same
+ * wait queue and never woken, so the partner is always queued behind
+ * all of them, and the main thread unpends it with z_unpend_thread().
+ * The average unpend cost and pend (partner awake to main thread
+ * back) cost are reported for each number of waiters.
  */
 
 #define N_RUNS 1000
@@ -49,7 +62,7 @@ enum {
 
 uint32_t stamps[NUM_STAMP_STATES];
 
-static inline int _stamp(int state)
+static inline uint32_t now(void)
 {
 	uint32_t t;
 
@@ -63,6 +76,13 @@ static inline int _stamp(int state)
 	t = k_cycle_get_32();
 #endif
 
+	return t;
+}
+
+static inline int _stamp(int state)
+{
+	uint32_t t = now();
+
 	stamps[state] = t;
 	return t;
 }
@@ -86,6 +106,115 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+#ifdef CONFIG_SMP
+#define N_YIELDS 2000
+#define N_YIELDERS (2 * CONFIG_MP_MAX_NUM_CPUS)
+#define YIELDER_STACK_SIZE 1024
+
+static K_THREAD_STACK_ARRAY_DEFINE(yielder_stacks, N_YIELDERS,
+				   YIELDER_STACK_SIZE);
+static struct k_thread yielder_threads[N_YIELDERS];
+
+static uint64_t yielder_cyc[N_YIELDERS];
+
+static void yielder_fn(void *arg1, void *arg2, void *arg3)
+{
+	uint64_t *cyc = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_YIELDS; i++) {
+		uint32_t t0 = now();
+
+		k_yield();
+		*cyc += now() - t0;
+	}
+}
+
+static void smp_contention(void)
+{
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+
+	for (int ncpus = 1; ncpus <= arch_num_cpus(); ncpus++) {
+		int n = 2 * ncpus;
+		uint64_t switch_cyc = 0U;
+
+		for (int i = 0; i < n; i++) {
+			yielder_cyc[i] = 0U;
+			k_thread_create(&yielder_threads[i], yielder_stacks[i],
+					YIELDER_STACK_SIZE, yielder_fn,
+					&yielder_cyc[i], NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&yielder_threads[i], K_FOREVER);
+			switch_cyc += yielder_cyc[i];
+		}
+
+		printk("cpus %d switch %6u\n", ncpus,
+		       (uint32_t)(switch_cyc / (n * N_YIELDS)));
+	}
+}
+#endif /* CONFIG_SMP */
+
+#define N_WAITER_RUNS 100
+#define MAX_WAITERS 128
+#define WAITER_STACK_SIZE 512
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, MAX_WAITERS,
+				   WAITER_STACK_SIZE);
+static struct k_thread waiter_threads[MAX_WAITERS];
+
+static void waiter_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	unsigned int key = irq_lock();
+
+	/* Never woken, only there to make the wait queue long */
+	z_pend_curr_irqlock(key, &waitq, K_FOREVER);
+}
+
+static void waiter_scaling(k_tid_t partner)
+{
+	static const int num_waiters[] = { 8, 32, MAX_WAITERS };
+	int prio = k_thread_priority_get(partner);
+	int n = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(num_waiters); i++) {
+		uint64_t unpend_cyc = 0U, pend_cyc = 0U;
+
+		/* Being of higher priority, each waiter pends before
+		 * k_thread_create() returns
+		 */
+		for (; n < num_waiters[i]; n++) {
+			k_thread_create(&waiter_threads[n], waiter_stacks[n],
+					WAITER_STACK_SIZE, waiter_fn,
+					NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+		}
+
+		for (int run = 0; run < N_WAITER_RUNS; run++) {
+			stamp(UNPENDING);
+			z_unpend_thread(partner);
+			stamp(UNPENDED_READYING);
+			z_ready_thread(partner);
+			k_yield();
+			stamp(YIELDED);
+
+			unpend_cyc += stamps[UNPENDED_READYING] - stamps[UNPENDING];
+			pend_cyc += stamps[YIELDED] - stamps[PARTNER_AWAKE_PENDING];
+		}
+
+		printk("waiters %3d unpend %4u pend %4u\n", n,
+		       (uint32_t)(unpend_cyc / N_WAITER_RUNS),
+		       (uint32_t)(pend_cyc / N_WAITER_RUNS));
+	}
+}
+
 int main(void)
 {
 	z_waitq_init(&waitq);
@@ -148,6 +277,13 @@ int main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#ifdef CONFIG_SMP
+	smp_contention();
+#endif
+
+	waiter_scaling(th);
+
 	printk("fin\n");
 	return 0;
 }
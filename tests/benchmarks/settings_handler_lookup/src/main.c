@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/settings/settings.h>
+
+/* Time to find the handler of settings with more and more handlers
+ * registered, and to find no handler for settings of another name.
+ */
+
+#define MAX_HANDLERS 256
+#define LOOKUPS 4096
+#define NAME_LEN 16
+
+static const int handler_counts[] = { 8, 64, MAX_HANDLERS };
+
+static struct settings_handler handlers[MAX_HANDLERS];
+static char handler_names[MAX_HANDLERS][NAME_LEN];
+static char names[MAX_HANDLERS][NAME_LEN + sizeof("/value")];
+static char missing[MAX_HANDLERS][NAME_LEN + sizeof("/value")];
+
+static int bench_set(const char *key, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	ARG_UNUSED(key);
+	ARG_UNUSED(len);
+	ARG_UNUSED(read_cb);
+	ARG_UNUSED(cb_arg);
+
+	return 0;
+}
+
+static int register_handlers(int first, int count)
+{
+	int rc;
+
+	for (int i = first; i < count; i++) {
+		snprintf(handler_names[i], sizeof(handler_names[i]),
+			 "bench/h%03d", i);
+		snprintf(names[i], sizeof(names[i]), "bench/h%03d/value", i);
+		snprintf(missing[i], sizeof(missing[i]), "bench/x%03d/value", i);
+
+		handlers[i].name = handler_names[i];
+		handlers[i].h_set = bench_set;
+
+		rc = settings_register(&handlers[i]);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+static uint64_t bench_lookups(char (*lookup_names)[NAME_LEN + sizeof("/value")],
+			      int count, bool match)
+{
+	struct settings_handler_static *handler;
+	timing_t start, end;
+	const char *next;
+	int found = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		handler = settings_parse_and_lookup(lookup_names[i % count], &next);
+		if (handler != NULL) {
+			found++;
+		}
+	}
+
+	end = timing_counter_get();
+
+	if (found != (match ? LOOKUPS : 0)) {
+		printk("%d lookups of %d found a handler\n", found, LOOKUPS);
+	}
+
+	return timing_cycles_to_ns_avg(timing_cycles_get(&start, &end), LOOKUPS);
+}
+
+int main(void)
+{
+	int registered = 0;
+	int rc;
+
+	rc = settings_subsys_init();
+	if (rc) {
+		printk("Cannot initialize settings (%d)\n", rc);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(handler_counts); i++) {
+		uint64_t lookup_ns, miss_ns;
+
+		rc = register_handlers(registered, handler_counts[i]);
+		if (rc) {
+			printk("Cannot register %d handlers (%d)\n",
+			       handler_counts[i], rc);
+			break;
+		}
+		registered = handler_counts[i];
+
+		lookup_ns = bench_lookups(names, registered, true);
+		miss_ns = bench_lookups(missing, registered, false);
+
+		printk("handlers %3d %6u ns/lookup %6u ns/miss\n", registered,
+		       (uint32_t)lookup_ns, (uint32_t)miss_ns);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
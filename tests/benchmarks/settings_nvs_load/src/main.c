@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/settings/settings.h>
+
+#include "settings/settings_nvs.h"
+
+/* Time to load more and more settings from NVS, compared with reading the
+ * name and the value of each setting by their NVS ids.
+ */
+
+#define MAX_KEYS 2000
+
+static const int key_counts[] = { 50, 500, MAX_KEYS };
+
+static int loaded;
+
+static int bench_set(const char *key, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t val;
+
+	if (len == sizeof(val) && read_cb(cb_arg, &val, sizeof(val)) > 0) {
+		loaded++;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+/* Stores the settings as settings_nvs_save() does, without looking for an
+ * existing one of the same name first, which would take most of the time.
+ */
+static int save_keys(struct nvs_fs *fs, int first, int count)
+{
+	char name[SETTINGS_MAX_NAME_LEN];
+	uint16_t name_id;
+	int rc;
+
+	for (uint32_t i = first; i < count; i++) {
+		name_id = NVS_NAMECNT_ID + 1 + i;
+		snprintf(name, sizeof(name), "bench/key%u", i);
+
+		rc = nvs_write(fs, name_id, name, strlen(name));
+		if (rc < 0) {
+			return rc;
+		}
+
+		rc = nvs_write(fs, name_id + NVS_NAME_ID_OFFSET, &i, sizeof(i));
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	name_id = NVS_NAMECNT_ID + count;
+	rc = nvs_write(fs, NVS_NAMECNT_ID, &name_id, sizeof(name_id));
+
+	return rc < 0 ? rc : 0;
+}
+
+/* Reads by id as settings_nvs_load() used to do */
+static int read_by_id(struct nvs_fs *fs)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t last_name_id;
+	uint32_t val;
+	int found = 0;
+
+	if (nvs_read(fs, NVS_NAMECNT_ID, &last_name_id,
+		     sizeof(last_name_id)) < 0) {
+		return 0;
+	}
+
+	for (uint16_t id = last_name_id; id > NVS_NAMECNT_ID; id--) {
+		if (nvs_read(fs, id, name, sizeof(name)) > 0 &&
+		    nvs_read(fs, id + NVS_NAME_ID_OFFSET, &val, sizeof(val)) > 0) {
+			found++;
+		}
+	}
+
+	return found;
+}
+
+int main(void)
+{
+	struct settings_nvs *cf;
+	struct nvs_fs *fs;
+	int saved = 0;
+	int rc;
+
+	rc = settings_subsys_init();
+	if (rc) {
+		printk("Cannot initialize settings (%d)\n", rc);
+		return 0;
+	}
+
+	rc = settings_storage_get((void **)&fs);
+	if (rc) {
+		printk("Cannot get settings storage (%d)\n", rc);
+		return 0;
+	}
+
+	cf = CONTAINER_OF(fs, struct settings_nvs, cf_nvs);
+
+	/* Start from an empty storage, and so from the first name id */
+	rc = nvs_clear(fs);
+	if (rc == 0) {
+		rc = settings_nvs_backend_init(cf);
+	}
+
+	if (rc) {
+		printk("Cannot clear settings storage (%d)\n", rc);
+		return 0;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(key_counts); i++) {
+		uint32_t start, load_us, read_us;
+		int found;
+
+		rc = save_keys(fs, saved, key_counts[i]);
+		if (rc == 0) {
+			/* Picks up the new last name id */
+			rc = settings_nvs_backend_init(cf);
+		}
+
+		if (rc) {
+			printk("Cannot save %d keys (%d)\n", key_counts[i], rc);
+			break;
+		}
+		saved = key_counts[i];
+
+		loaded = 0;
+		start = k_cycle_get_32();
+		rc = settings_load();
+		load_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		start = k_cycle_get_32();
+		found = read_by_id(fs);
+		read_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		if (rc || loaded != saved || found != saved) {
+			printk("Loaded %d, read %d of %d keys (%d)\n", loaded,
+			       found, saved, rc);
+		}
+
+		printk("keys %4d load %8u us, read by id %8u us\n", saved,
+		       load_us, read_us);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/timeout_q.h>
+
+/* This is a microbenchmark of the kernel timeout queue.  For each
+ * population size it fills the queue with that many timeouts far in
+ * the future (inserted in a scrambled order so the list backend does
+ * not always append at the tail), then measures:
+ *
+ * - insert: z_add_timeout() of a probe timeout whose expiry lands at
+ *   a pseudo-random position inside the population
+ * - abort: z_abort_timeout() of that same probe
+ * - expire: the per-timeout cost of sys_clock_announce() working
+ *   through a batch of timeouts due on the same tick, measured from
+ *   inside their callbacks while the population is still pending
+ */
+
+#define MAX_PENDING 1000
+#define N_RUNS 200
+#define EXPIRE_BATCH 16
+
+/* Keep the background population well clear of anything the
+ * benchmark itself waits for.
+ */
+#define FAR_TICKS 1000000
+#define STRIDE_TICKS 7
+
+static const int populations[] = { 10, 100, 1000 };
+
+static struct _timeout pending[MAX_PENDING];
+static struct _timeout probe;
+static struct _timeout batch[EXPIRE_BATCH];
+
+static K_SEM_DEFINE(batch_done, 0, 1);
+static int batch_count;
+static timing_t batch_first, batch_last;
+
+static uint32_t rand_state = 12345U;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void batch_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	batch_last = timing_counter_get();
+	if (batch_count++ == 0) {
+		batch_first = batch_last;
+	}
+	if (batch_count == EXPIRE_BATCH) {
+		k_sem_give(&batch_done);
+	}
+}
+
+static void fill(int n)
+{
+	/* Multiplying by a constant coprime to n visits every slot
+	 * exactly once in scrambled order.
+	 */
+	for (int i = 0; i < n; i++) {
+		int slot = (i * 617) % n;
+
+		z_add_timeout(&pending[i], dummy_fn,
+			      K_TICKS(FAR_TICKS + slot * STRIDE_TICKS));
+	}
+}
+
+static void drain(int n)
+{
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+}
+
+static void bench_insert_abort(int n, uint64_t *insert_ns,
+			       uint64_t *abort_ns)
+{
+	uint64_t insert_cyc = 0U, abort_cyc = 0U;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		k_ticks_t ticks = FAR_TICKS + next_rand() % (n * STRIDE_TICKS);
+		timing_t t0, t1, t2;
+
+		t0 = timing_counter_get();
+		z_add_timeout(&probe, dummy_fn, K_TICKS(ticks));
+		t1 = timing_counter_get();
+		z_abort_timeout(&probe);
+		t2 = timing_counter_get();
+
+		insert_cyc += timing_cycles_get(&t0, &t1);
+		abort_cyc += timing_cycles_get(&t1, &t2);
+	}
+
+	*insert_ns = timing_cycles_to_ns_avg(insert_cyc, N_RUNS);
+	*abort_ns = timing_cycles_to_ns_avg(abort_cyc, N_RUNS);
+}
+
+static uint64_t bench_expire(void)
+{
+	uint64_t cyc = 0U;
+
+	for (int i = 0; i < N_RUNS / EXPIRE_BATCH; i++) {
+		k_ticks_t when = sys_clock_tick_get() + k_ms_to_ticks_ceil32(10);
+
+		batch_count = 0;
+		for (int j = 0; j < EXPIRE_BATCH; j++) {
+			z_add_timeout(&batch[j], batch_fn,
+				      K_TIMEOUT_ABS_TICKS(when));
+		}
+
+		k_sem_take(&batch_done, K_FOREVER);
+		cyc += timing_cycles_get(&batch_first, &batch_last);
+	}
+
+	return timing_cycles_to_ns_avg(cyc, (N_RUNS / EXPIRE_BATCH) *
+				       (EXPIRE_BATCH - 1));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < MAX_PENDING; i++) {
+		z_init_timeout(&pending[i]);
+	}
+	z_init_timeout(&probe);
+	for (int i = 0; i < EXPIRE_BATCH; i++) {
+		z_init_timeout(&batch[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(populations); i++) {
+		int n = populations[i];
+		uint64_t insert_ns, abort_ns, expire_ns;
+
+		fill(n);
+		bench_insert_abort(n, &insert_ns, &abort_ns);
+		expire_ns = bench_expire();
+		drain(n);
+
+		printk("pending %4d insert %6u ns abort %6u ns expire %6u ns\n",
+		       n, (uint32_t)insert_ns, (uint32_t)abort_ns,
+		       (uint32_t)expire_ns);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#include <tracing_buffer.h>
+#endif
+
+/* One thread per CPU traces semaphore give events as fast as it can, in
+ * bursts short enough for the packets of all the threads to fit in the
+ * tracing buffers. Between bursts the threads sleep, so that the tracing
+ * thread empties the buffers. Only the bursts are timed.
+ */
+
+#define BURSTS 100
+#define BURST_EVENTS 32
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_sem sems[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+	uint64_t *total = p2;
+	timing_t start, end;
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < BURSTS; i++) {
+		start = timing_counter_get();
+
+		for (int j = 0; j < BURST_EVENTS; j++) {
+			sys_trace_k_sem_give_enter(sem);
+		}
+
+		end = timing_counter_get();
+		*total += timing_cycles_get(&start, &end);
+
+		k_msleep(2);
+	}
+}
+
+/* Average time to trace an event with n threads tracing at once */
+static uint32_t bench(unsigned int n)
+{
+	uint64_t sum = 0;
+
+	for (unsigned int i = 0; i < n; i++) {
+		cycles[i] = 0;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				&sems[i], &cycles[i], NULL, WORKER_PRIO, 0,
+				K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		sum += cycles[i];
+	}
+
+	return (uint32_t)timing_cycles_to_ns_avg(sum, n * BURSTS * BURST_EVENTS);
+}
+
+static uint32_t drops(void)
+{
+	uint32_t sum = 0;
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		sum += tracing_cpu_buffer_drops_get(cpu);
+	}
+#endif
+
+	return sum;
+}
+
+int main(void)
+{
+	unsigned int cpus = arch_num_cpus();
+
+	timing_init();
+	timing_start();
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_sem_init(&sems[i], 0, 1);
+	}
+
+	/* Keep the main thread out of the way of the workers */
+	k_thread_priority_set(k_current_get(), K_LOWEST_APPLICATION_THREAD_PRIO);
+
+	printk("per cpu buffers %s\n",
+	       IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS) ? "on" : "off");
+
+	printk("threads %2u %6u ns/event\n", 1U, bench(1));
+	if (cpus > 1) {
+		printk("threads %2u %6u ns/event\n", cpus, bench(cpus));
+	}
+
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		printk("dropped %u packets\n", drops());
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
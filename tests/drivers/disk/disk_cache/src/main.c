@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/storage/disk_access.h>
+
+/* The cache is attached to a disk counting the sectors read from and
+ * written to it.
+ */
+
+#define DISK_NAME "CACHE"
+#define SECTOR_SIZE 512
+#define SECTOR_COUNT 32
+#define CACHE_SECTORS 4
+
+static uint8_t disk_data[SECTOR_COUNT][SECTOR_SIZE];
+static uint32_t disk_reads;
+static uint32_t disk_writes;
+
+static uint8_t buf[8][SECTOR_SIZE];
+
+DISK_CACHE_DEFINE(test_cache, CACHE_SECTORS, SECTOR_SIZE);
+
+static int test_disk_status(struct disk_info *disk)
+{
+	return DISK_STATUS_OK;
+}
+
+static int test_disk_read(struct disk_info *disk, uint8_t *data_buf,
+			  uint32_t start_sector, uint32_t num_sector)
+{
+	zassert_true(start_sector + num_sector <= SECTOR_COUNT, "Bad sector");
+
+	memcpy(data_buf, disk_data[start_sector], num_sector * SECTOR_SIZE);
+	disk_reads += num_sector;
+
+	return 0;
+}
+
+static int test_disk_write(struct disk_info *disk, const uint8_t *data_buf,
+			   uint32_t start_sector, uint32_t num_sector)
+{
+	zassert_true(start_sector + num_sector <= SECTOR_COUNT, "Bad sector");
+
+	memcpy(disk_data[start_sector], data_buf, num_sector * SECTOR_SIZE);
+	disk_writes += num_sector;
+
+	return 0;
+}
+
+static int test_disk_ioctl(struct disk_info *disk, uint8_t cmd, void *buff)
+{
+	switch (cmd) {
+	case DISK_IOCTL_CTRL_SYNC:
+		break;
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buff = SECTOR_COUNT;
+		break;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buff = SECTOR_SIZE;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static const struct disk_operations test_disk_ops = {
+	.status = test_disk_status,
+	.read = test_disk_read,
+	.write = test_disk_write,
+	.ioctl = test_disk_ioctl,
+};
+
+static struct disk_info test_disk = {
+	.name = DISK_NAME,
+	.ops = &test_disk_ops,
+};
+
+static void read_sector(uint32_t sector)
+{
+	zassert_ok(disk_access_read(DISK_NAME, buf[0], sector, 1),
+		   "Cannot read sector %u", sector);
+	zassert_mem_equal(buf[0], disk_data[sector], SECTOR_SIZE,
+			  "Wrong data read from sector %u", sector);
+}
+
+static void write_sector(uint32_t sector, uint8_t fill)
+{
+	memset(buf[0], fill, SECTOR_SIZE);
+	zassert_ok(disk_access_write(DISK_NAME, buf[0], sector, 1),
+		   "Cannot write sector %u", sector);
+}
+
+static void check_stats(uint32_t hits, uint32_t misses, uint32_t write_backs)
+{
+	struct disk_cache_stats stats;
+
+	zassert_ok(disk_access_cache_stats(DISK_NAME, &stats), "No stats");
+	zassert_equal(stats.hits, hits, "%u hits", stats.hits);
+	zassert_equal(stats.misses, misses, "%u misses", stats.misses);
+	zassert_equal(stats.write_backs, write_backs, "%u write backs",
+		      stats.write_backs);
+}
+
+ZTEST(disk_cache, test_read_hits)
+{
+	zassert_ok(disk_access_cache_attach(DISK_NAME, &test_cache, 0),
+		   "Cannot attach cache");
+
+	read_sector(3);
+	read_sector(3);
+	read_sector(4);
+	read_sector(3);
+
+	zassert_equal(disk_reads, 2, "%u sectors read from disk", disk_reads);
+	check_stats(2, 2, 0);
+}
+
+ZTEST(disk_cache, test_lru_eviction)
+{
+	zassert_ok(disk_access_cache_attach(DISK_NAME, &test_cache, 0),
+		   "Cannot attach cache");
+
+	for (uint32_t i = 0; i < CACHE_SECTORS; i++) {
+		read_sector(i);
+	}
+
+	/* Sector 1 is now the least recently used one */
+	read_sector(0);
+	read_sector(CACHE_SECTORS);
+	check_stats(1, CACHE_SECTORS + 1, 0);
+
+	read_sector(0);
+	read_sector(2);
+	check_stats(3, CACHE_SECTORS + 1, 0);
+
+	read_sector(1);
+	check_stats(3, CACHE_SECTORS + 2, 0);
+}
+
+ZTEST(disk_cache, test_write_through)
+{
+	zassert_ok(disk_access_cache_attach(DISK_NAME, &test_cache, 0),
+		   "Cannot attach cache");
+
+	write_sector(5, 0x55);
+	zassert_equal(disk_writes, 1, "Sector not written through");
+	zassert_equal(disk_data[5][0], 0x55, "Sector not written through");
+
+	read_sector(5);
+	zassert_equal(disk_reads, 0, "Written sector read from disk");
+}
+
+ZTEST(disk_cache, test_write_back)
+{
+	uint8_t zero[SECTOR_SIZE] = { 0 };
+
+	zassert_ok(disk_access_cache_attach(DISK_NAME, &test_cache,
+					    DISK_CACHE_WRITE_BACK),
+		   "Cannot attach cache");
+
+	write_sector(6, 0x66);
+	write_sector(6, 0x67);
+	write_sector(7, 0x77);
+	zassert_equal(disk_writes, 0, "Sectors written through");
+
+	zassert_ok(disk_access_read(DISK_NAME, buf[1], 6, 1), "Cannot read");
+	zassert_equal(buf[1][0], 0x67, "Written data not read back");
+	zassert_equal(disk_reads, 0, "Written sector read from disk");
+
+	/* Reads of several sectors see the sectors not flushed yet */
+	zassert_ok(disk_access_read(DISK_NAME, buf[0], 5, 3), "Cannot read");
+	zassert_mem_equal(buf[0], zero, SECTOR_SIZE, "Wrong sector 5");
+	zassert_equal(buf[1][0], 0x67, "Wrong sector 6");
+	zassert_equal(buf[2][0], 0x77, "Wrong sector 7");
+
+	zassert_ok(disk_access_ioctl(DISK_NAME, DISK_IOCTL_CTRL_SYNC, NULL),
+		   "Cannot sync");
+	zassert_equal(disk_writes, 2, "%u sectors written back", disk_writes);
+	zassert_equal(disk_data[6][0], 0x67, "Sector 6 not written back");
+	zassert_equal(disk_data[7][0], 0x77, "Sector 7 not written back");
+	check_stats(1, 0, 2);
+
+	/* Nothing left to write back */
+	zassert_ok(disk_access_cache_flush(DISK_NAME), "Cannot flush");
+	zassert_equal(disk_writes, 2, "Clean sectors written back");
+}
+
+ZTEST(disk_cache, test_dirty_eviction)
+{
+	zassert_ok(disk_access_cache_attach(DISK_NAME, &test_cache,
+					    DISK_CACHE_WRITE_BACK),
+		   "Cannot attach cache");
+
+	for (uint32_t i = 0; i <= CACHE_SECTORS; i++) {
+		write_sector(i, i + 1);
+	}
+
+	/* Sector 0 made room for the last one */
+	zassert_equal(disk_writes, 1, "%u sectors written back", disk_writes);
+	zassert_equal(disk_data[0][0], 1, "Evicted sector not written back");
+	check_stats(0, 0, 1);
+
+	/* Detaching the cache flushes it */
+	zassert_ok(disk_access_cache_attach(DISK_NAME, NULL, 0),
+		   "Cannot detach cache");
+	zassert_equal(disk_writes, CACHE_SECTORS + 1, "Cache not flushed");
+
+	for (uint32_t i = 0; i <= CACHE_SECTORS; i++) {
+		zassert_equal(disk_data[i][0], i + 1, "Wrong sector %u", i);
+	}
+}
+
+ZTEST(disk_cache, test_multi_sector_write)
+{
+	zassert_ok(disk_access_cache_attach(DISK_NAME, &test_cache,
+					    DISK_CACHE_WRITE_BACK),
+		   "Cannot attach cache");
+
+	write_sector(9, 0x99);
+	read_sector(10);
+
+	memset(buf, 0xab, sizeof(buf));
+	zassert_ok(disk_access_write(DISK_NAME, buf[0], 8, 4), "Cannot write");
+	zassert_equal(disk_writes, 4, "%u sectors written", disk_writes);
+
+	/* The cached sectors are updated and clean */
+	read_sector(9);
+	read_sector(10);
+	zassert_equal(disk_data[9][0], 0xab, "Sector 9 not written");
+
+	zassert_ok(disk_access_cache_flush(DISK_NAME), "Cannot flush");
+	zassert_equal(disk_writes, 4, "Stale sector written back");
+	check_stats(2, 1, 0);
+}
+
+ZTEST(disk_cache, test_attach_errors)
+{
+	zassert_equal(disk_access_cache_attach("NODISK", &test_cache, 0),
+		      -EINVAL, "Cache attached to missing disk");
+	zassert_equal(disk_access_cache_flush("NODISK"), -EINVAL,
+		      "Missing disk flushed");
+
+	zassert_ok(disk_access_cache_attach(DISK_NAME, NULL, 0),
+		   "Cannot detach cache");
+	zassert_equal(disk_access_cache_flush(DISK_NAME), -EINVAL,
+		      "Disk without cache flushed");
+}
+
+static void *disk_cache_setup(void)
+{
+	zassert_ok(disk_access_register(&test_disk), "Cannot register disk");
+
+	return NULL;
+}
+
+static void disk_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(disk_data, 0, sizeof(disk_data));
+	disk_reads = 0;
+	disk_writes = 0;
+}
+
+static void disk_cache_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)disk_access_cache_attach(DISK_NAME, NULL, 0);
+}
+
+ZTEST_SUITE(disk_cache, NULL, disk_cache_setup, disk_cache_before,
+	    disk_cache_after, NULL);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 8
+#define NUM_BATCH_MSGS 20
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+
+K_MSGQ_DEFINE(batch_msgq, MSG_SIZE, BATCH_LEN, 4);
+
+static ZTEST_BMEM uint32_t rx_msgs[NUM_BATCH_MSGS];
+
+static void fill_msgs(uint32_t *msgs, int num, uint32_t first)
+{
+	for (int i = 0; i < num; i++) {
+		msgs[i] = first + i;
+	}
+}
+
+static void batch_receiver(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+	int received = 0;
+
+	while (received < NUM_BATCH_MSGS) {
+		int ret = k_msgq_get_many(q, &rx_msgs[received],
+					  NUM_BATCH_MSGS - received, K_FOREVER);
+
+		zassert_true(ret > 0, "get_many failed: %d", ret);
+		received += ret;
+	}
+}
+
+static void batch_put_get(struct k_msgq *q)
+{
+	uint32_t tx[BATCH_LEN + 2], rx[BATCH_LEN + 2];
+	uint32_t msg;
+	int ret;
+
+	k_msgq_purge(q);
+
+	/* Move the read and write positions off the start of the buffer so
+	 * that batches wrap around its end.
+	 */
+	for (int i = 0; i < 3; i++) {
+		zassert_ok(k_msgq_put(q, &i, K_NO_WAIT));
+		zassert_ok(k_msgq_get(q, &msg, K_NO_WAIT));
+	}
+
+	/**TESTPOINT: partial batch put into a queue with less room */
+	fill_msgs(tx, ARRAY_SIZE(tx), 100);
+	ret = k_msgq_put_many(q, tx, ARRAY_SIZE(tx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, "put_many returned %d", ret);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN);
+	zassert_equal(k_msgq_put_many(q, tx, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_put_many(q, tx, 1, TIMEOUT), -EAGAIN);
+
+	/**TESTPOINT: batch get returns what is there, in order */
+	ret = k_msgq_get_many(q, rx, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, "get_many returned %d", ret);
+	ret = k_msgq_get_many(q, &rx[3], ARRAY_SIZE(rx) - 3, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN - 3, "get_many returned %d", ret);
+	zassert_mem_equal(rx, tx, BATCH_LEN * sizeof(tx[0]));
+
+	zassert_equal(k_msgq_get_many(q, rx, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_many(q, rx, 1, TIMEOUT), -EAGAIN);
+	zassert_equal(k_msgq_put_many(q, tx, 0, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_get_many(q, rx, 0, K_NO_WAIT), 0);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batched put and get without waiting
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_batch_put_get)
+{
+	batch_put_get(&batch_msgq);
+}
+
+/**
+ * @brief Test a batch larger than the queue against a batched receiver
+ *
+ * @details The sender has to wait for room for the later messages of its
+ * batch, the receiver for the queue to fill; all messages must arrive in
+ * order.
+ *
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_batch_blocking)
+{
+	uint32_t tx[NUM_BATCH_MSGS];
+	int ret;
+
+	k_msgq_purge(&batch_msgq);
+	memset(rx_msgs, 0, sizeof(rx_msgs));
+	fill_msgs(tx, ARRAY_SIZE(tx), 1000);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, batch_receiver,
+			&batch_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+
+	ret = k_msgq_put_many(&batch_msgq, tx, ARRAY_SIZE(tx), K_FOREVER);
+	zassert_equal(ret, NUM_BATCH_MSGS, "put_many returned %d", ret);
+
+	zassert_ok(k_thread_join(&tdata, K_FOREVER));
+	zassert_mem_equal(rx_msgs, tx, sizeof(tx));
+	zassert_equal(k_msgq_num_used_get(&batch_msgq), 0);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test batched put and get from user mode
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_batch_put_get)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_LEN));
+
+	batch_put_get(q);
+}
+#endif
+
+/**
+ * @}
+ */
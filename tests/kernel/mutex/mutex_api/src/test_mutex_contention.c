@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_CONTENTION_STATS
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_mutex contended_mutex;
+static K_THREAD_STACK_DEFINE(contender_stack, STACK_SIZE);
+static struct k_thread contender;
+
+static void contender_entry(void *p1, void *p2, void *p3)
+{
+	struct k_mutex *mutex = p1;
+
+	zassert_equal(k_mutex_lock(mutex, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_mutex_lock(mutex, K_MSEC(10)), -EAGAIN);
+	zassert_ok(k_mutex_lock(mutex, K_FOREVER));
+	zassert_ok(k_mutex_unlock(mutex));
+}
+
+/**
+ * @brief Test the contention statistics of a mutex
+ *
+ * @details The contender finds the mutex locked three times: once without
+ * waiting and twice pending on it.  Its owner is not running on another
+ * CPU, so none of the attempts may be satisfied by spinning.
+ *
+ * @see k_mutex_contention_get()
+ */
+ZTEST(mutex_api_1cpu, test_mutex_contention_stats)
+{
+	struct k_contention_stats stats;
+
+	zassert_ok(k_mutex_init(&contended_mutex));
+	k_mutex_contention_get(&contended_mutex, &stats, true);
+	zassert_equal(stats.contended + stats.blocked + stats.spin_acquired, 0);
+
+	/* Uncontended and recursive locking is not contention */
+	zassert_ok(k_mutex_lock(&contended_mutex, K_FOREVER));
+	zassert_ok(k_mutex_lock(&contended_mutex, K_NO_WAIT));
+	zassert_ok(k_mutex_unlock(&contended_mutex));
+
+	k_thread_create(&contender, contender_stack, STACK_SIZE,
+			contender_entry, &contended_mutex, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(50);
+	zassert_ok(k_mutex_unlock(&contended_mutex));
+	zassert_ok(k_thread_join(&contender, K_FOREVER));
+
+	k_mutex_contention_get(&contended_mutex, &stats, true);
+	zassert_equal(stats.contended, 3, "contended %u", stats.contended);
+	zassert_equal(stats.blocked, 2, "blocked %u", stats.blocked);
+	zassert_equal(stats.spin_acquired, 0);
+
+	/**TESTPOINT: reading with reset cleared the statistics */
+	k_mutex_contention_get(&contended_mutex, &stats, false);
+	zassert_equal(stats.contended + stats.blocked + stats.spin_acquired, 0);
+}
+
+static void busy_contender_entry(void *p1, void *p2, void *p3)
+{
+	struct k_mutex *mutex = p1;
+
+	zassert_equal(k_mutex_lock(mutex, K_NO_WAIT), -EBUSY);
+}
+
+/**
+ * @brief Test that initializing a mutex clears its contention statistics
+ *
+ * @details Both a used mutex initialized again and a mutex on the stack,
+ * whose memory held something else before, start with no contention.
+ *
+ * @see k_mutex_init(), k_mutex_contention_get()
+ */
+ZTEST(mutex_api_1cpu, test_mutex_contention_stats_init)
+{
+	struct k_contention_stats stats;
+	struct k_mutex stack_mutex;
+
+	zassert_ok(k_mutex_init(&contended_mutex));
+	zassert_ok(k_mutex_lock(&contended_mutex, K_FOREVER));
+
+	k_thread_create(&contender, contender_stack, STACK_SIZE,
+			busy_contender_entry, &contended_mutex, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&contender, K_FOREVER));
+	zassert_ok(k_mutex_unlock(&contended_mutex));
+
+	k_mutex_contention_get(&contended_mutex, &stats, false);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+
+	/**TESTPOINT: initializing the mutex again clears the statistics */
+	zassert_ok(k_mutex_init(&contended_mutex));
+	k_mutex_contention_get(&contended_mutex, &stats, false);
+	zassert_equal(stats.contended + stats.blocked + stats.spin_acquired, 0);
+
+	/**TESTPOINT: so does initializing one in reused memory */
+	memset(&stack_mutex, 0xa5, sizeof(stack_mutex));
+	zassert_ok(k_mutex_init(&stack_mutex));
+	k_mutex_contention_get(&stack_mutex, &stats, false);
+	zassert_equal(stats.contended + stats.blocked + stats.spin_acquired, 0);
+}
+
+#endif /* CONFIG_CONTENTION_STATS */
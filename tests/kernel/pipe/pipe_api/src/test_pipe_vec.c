@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for vectored pipe transfers
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define VEC_PIPE_LEN	16
+#define VEC_XFER_LEN	40
+
+static const unsigned char src[VEC_XFER_LEN] =
+	"0123456789abcdefghijklmnopqrstuvwxyzABCD";
+static unsigned char dst[VEC_XFER_LEN];
+
+K_PIPE_DEFINE(vec_pipe, VEC_PIPE_LEN, 4);
+K_PIPE_DEFINE(vec_nobuf_pipe, 0, 4);
+
+static K_THREAD_STACK_DEFINE(vec_stack, STACK_SIZE);
+static struct k_thread vec_thread;
+
+static void vec_writer(void *p1, void *p2, void *p3)
+{
+	/* Uneven segments, including an empty one */
+	const struct k_pipe_iovec iov[] = {
+		{ (void *)&src[0], 9 },
+		{ (void *)&src[9], 0 },
+		{ (void *)&src[9], 20 },
+		{ (void *)&src[29], VEC_XFER_LEN - 29 },
+	};
+	size_t written;
+
+	zassert_ok(k_pipe_put_vec(p1, iov, ARRAY_SIZE(iov), &written,
+				  VEC_XFER_LEN, K_FOREVER));
+	zassert_equal(written, VEC_XFER_LEN);
+}
+
+static void vec_read_all(struct k_pipe *pipe)
+{
+	const struct k_pipe_iovec iov[] = {
+		{ &dst[0], 7 },
+		{ &dst[7], 13 },
+		{ &dst[20], VEC_XFER_LEN - 20 },
+	};
+	size_t read;
+
+	memset(dst, 0, sizeof(dst));
+
+	zassert_ok(k_pipe_get_vec(pipe, iov, ARRAY_SIZE(iov), &read,
+				  VEC_XFER_LEN, K_FOREVER));
+	zassert_equal(read, VEC_XFER_LEN);
+	zassert_mem_equal(dst, src, VEC_XFER_LEN);
+}
+
+/**
+ * @brief Test vectored put and get without waiting
+ * @see k_pipe_put_vec(), k_pipe_get_vec()
+ */
+ZTEST(pipe_api, test_pipe_vec_no_wait)
+{
+	const struct k_pipe_iovec put1[] = {
+		{ (void *)&src[0], 5 },
+		{ (void *)&src[5], 0 },
+		{ (void *)&src[5], 7 },
+	};
+	const struct k_pipe_iovec put2[] = {
+		{ (void *)&src[12], 2 },
+		{ (void *)&src[14], 6 },
+	};
+	const struct k_pipe_iovec get[] = {
+		{ &dst[0], 3 },
+		{ &dst[3], 10 },
+		{ &dst[13], 3 },
+		{ &dst[16], 4 },
+	};
+	size_t bytes;
+
+	k_pipe_flush(&vec_pipe);
+	memset(dst, 0, sizeof(dst));
+
+	zassert_ok(k_pipe_put_vec(&vec_pipe, put1, ARRAY_SIZE(put1), &bytes,
+				  12, K_NO_WAIT));
+	zassert_equal(bytes, 12);
+
+	/**TESTPOINT: partial write when the pipe fills up */
+	zassert_ok(k_pipe_put_vec(&vec_pipe, put2, ARRAY_SIZE(put2), &bytes,
+				  0, K_NO_WAIT));
+	zassert_equal(bytes, VEC_PIPE_LEN - 12);
+	zassert_equal(k_pipe_put_vec(&vec_pipe, put2, ARRAY_SIZE(put2),
+				     &bytes, 1, K_NO_WAIT), -EIO);
+
+	/**TESTPOINT: scatter across segments, short read */
+	zassert_ok(k_pipe_get_vec(&vec_pipe, get, ARRAY_SIZE(get), &bytes,
+				  0, K_NO_WAIT));
+	zassert_equal(bytes, VEC_PIPE_LEN);
+	zassert_mem_equal(dst, src, VEC_PIPE_LEN);
+	zassert_equal(k_pipe_get_vec(&vec_pipe, get, ARRAY_SIZE(get),
+				     &bytes, 1, K_NO_WAIT), -EIO);
+
+	zassert_equal(k_pipe_put_vec(&vec_pipe, put1, ARRAY_SIZE(put1),
+				     &bytes, 13, K_NO_WAIT), -EINVAL);
+}
+
+/**
+ * @brief Test vectored transfers that have to wait for the other side
+ *
+ * @details The writer's data does not fit in the pipe buffer, or there is
+ * no buffer at all, so both sides block on part of their segments.
+ *
+ * @see k_pipe_put_vec(), k_pipe_get_vec()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_vec_blocking)
+{
+	struct k_pipe *pipes[] = { &vec_pipe, &vec_nobuf_pipe };
+
+	for (int i = 0; i < ARRAY_SIZE(pipes); i++) {
+		k_pipe_flush(pipes[i]);
+
+		/* Reader first, so it waits on its first segment */
+		k_thread_create(&vec_thread, vec_stack, STACK_SIZE, vec_writer,
+				pipes[i], NULL, NULL, K_PRIO_PREEMPT(0), 0,
+				K_MSEC(10));
+		vec_read_all(pipes[i]);
+		zassert_ok(k_thread_join(&vec_thread, K_FOREVER));
+
+		/* Writer first, so it waits for room */
+		k_thread_create(&vec_thread, vec_stack, STACK_SIZE, vec_writer,
+				pipes[i], NULL, NULL, K_PRIO_PREEMPT(0), 0,
+				K_NO_WAIT);
+		k_msleep(10);
+		vec_read_all(pipes[i]);
+		zassert_ok(k_thread_join(&vec_thread, K_FOREVER));
+	}
+}
+
+/**
+ * @brief Test a vectored put timing out after a partial transfer
+ * @see k_pipe_put_vec()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_vec_timeout)
+{
+	const struct k_pipe_iovec iov[] = {
+		{ (void *)&src[0], 10 },
+		{ (void *)&src[10], 10 },
+	};
+	size_t bytes;
+
+	k_pipe_flush(&vec_pipe);
+
+	zassert_equal(k_pipe_put_vec(&vec_pipe, iov, ARRAY_SIZE(iov), &bytes,
+				     20, K_MSEC(20)), -EAGAIN);
+	zassert_equal(bytes, VEC_PIPE_LEN);
+
+	zassert_ok(k_pipe_get(&vec_pipe, dst, VEC_PIPE_LEN, &bytes,
+			      VEC_PIPE_LEN, K_NO_WAIT));
+	zassert_mem_equal(dst, src, VEC_PIPE_LEN);
+}
+
+/**
+ * @}
+ */
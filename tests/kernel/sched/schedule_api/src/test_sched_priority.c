@@ -171,6 +171,66 @@ ZTEST(threads_scheduling_1cpu, test_priority_preemptible_wait_prio)
 	k_thread_priority_set(k_current_get(), old_prio);
 }
 
+static int woken;
+
+static void thread_entry_pended(void *p1, void *p2, void *p3)
+{
+	k_sem_take(&sync_sema, K_FOREVER);
+
+	tid_num[woken++] = POINTER_TO_INT(p1);
+}
+
+/**
+ * @brief Validate changing the priority of pended threads
+ *
+ * @details Three threads of different priorities pend on a semaphore.
+ * The lowest priority one is raised to the highest priority and the
+ * highest priority one is lowered below the others while they wait.
+ * Make sure that the semaphore wakes them up in the order of their new
+ * priorities.
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(threads_scheduling_1cpu, test_priority_set_pended)
+{
+	int old_prio = k_thread_priority_get(k_current_get());
+	k_tid_t tid[3];
+	uint8_t tid_chk[3] = { 2, 1, 0 };
+	int prio[3] = { K_PRIO_PREEMPT(0), K_PRIO_PREEMPT(5),
+			K_PRIO_PREEMPT(10) };
+
+	k_sem_init(&sync_sema, 0, ARRAY_SIZE(tid));
+	woken = 0;
+
+	/* the threads preempt this one and pend right away */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(15));
+
+	for (int i = 0; i < ARRAY_SIZE(tid); i++) {
+		tid[i] = k_thread_create(&tdata_prio[i], tstacks[i], STACK_SIZE,
+					 thread_entry_pended, INT_TO_POINTER(i),
+					 NULL, NULL, prio[i], 0, K_NO_WAIT);
+	}
+	zassert_equal(woken, 0);
+
+	k_thread_priority_set(tid[2], K_HIGHEST_APPLICATION_THREAD_PRIO);
+	k_thread_priority_set(tid[0], K_PRIO_PREEMPT(12));
+
+	for (int i = 0; i < ARRAY_SIZE(tid); i++) {
+		k_sem_give(&sync_sema);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(tid); i++) {
+		zassert_ok(k_thread_join(tid[i], K_FOREVER));
+	}
+
+	zassert_equal(woken, ARRAY_SIZE(tid));
+	zassert_mem_equal(tid_num, tid_chk, sizeof(tid_chk),
+			  "woken up in the wrong order");
+
+	/* restore environment */
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+
 extern void idle(void *p1, void *p2, void *p3);
 
 /**
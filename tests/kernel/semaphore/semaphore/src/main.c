@@ -1147,6 +1147,63 @@ ZTEST(semaphore_1cpu, test_sem_queue_mutual_exclusion)
 	k_thread_join(&sem_tid_2, K_FOREVER);
 }
 
+#ifdef CONFIG_CONTENTION_STATS
+/**
+ * @brief Test the contention statistics of a semaphore
+ * @details Takes that find the count at zero are contended, the ones
+ * that have to wait for a give also blocked.
+ * @ingroup kernel_semaphore_tests
+ * @see k_sem_contention_get()
+ */
+ZTEST(semaphore_1cpu, test_sem_contention_stats)
+{
+	struct k_contention_stats stats;
+
+	expect_k_sem_init_nomsg(&simple_sem, 1, SEM_MAX_VAL, 0);
+	k_sem_contention_get(&simple_sem, &stats, true);
+
+	expect_k_sem_take_nomsg(&simple_sem, K_NO_WAIT, 0);
+	expect_k_sem_take_nomsg(&simple_sem, K_NO_WAIT, -EBUSY);
+	expect_k_sem_take_nomsg(&simple_sem, K_MSEC(10), -EAGAIN);
+
+	k_sem_contention_get(&simple_sem, &stats, true);
+	zassert_equal(stats.contended, 2, "contended %u", stats.contended);
+	zassert_equal(stats.blocked, 1, "blocked %u", stats.blocked);
+	zassert_equal(stats.spin_acquired, 0);
+
+	k_sem_contention_get(&simple_sem, &stats, false);
+	zassert_equal(stats.contended + stats.blocked + stats.spin_acquired, 0);
+}
+
+/**
+ * @brief Test that initializing a semaphore clears its contention statistics
+ * @details Both a used semaphore initialized again and a semaphore on the
+ * stack, whose memory held something else before, start with no contention.
+ * @ingroup kernel_semaphore_tests
+ * @see k_sem_init(), k_sem_contention_get()
+ */
+ZTEST(semaphore_1cpu, test_sem_contention_stats_init)
+{
+	struct k_contention_stats stats;
+	struct k_sem stack_sem;
+
+	expect_k_sem_init_nomsg(&simple_sem, 0, SEM_MAX_VAL, 0);
+	expect_k_sem_take_nomsg(&simple_sem, K_NO_WAIT, -EBUSY);
+
+	k_sem_contention_get(&simple_sem, &stats, false);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+
+	expect_k_sem_init_nomsg(&simple_sem, 0, SEM_MAX_VAL, 0);
+	k_sem_contention_get(&simple_sem, &stats, false);
+	zassert_equal(stats.contended + stats.blocked + stats.spin_acquired, 0);
+
+	memset(&stack_sem, 0xa5, sizeof(stack_sem));
+	expect_k_sem_init_nomsg(&stack_sem, 0, SEM_MAX_VAL, 0);
+	k_sem_contention_get(&stack_sem, &stats, false);
+	zassert_equal(stats.contended + stats.blocked + stats.spin_acquired, 0);
+}
+#endif
+
 #ifdef CONFIG_USERSPACE
 static void thread_sem_give_null(void *p1, void *p2, void *p3)
 {
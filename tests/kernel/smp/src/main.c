@@ -1064,6 +1064,113 @@ ZTEST(smp, test_smp_switch_torture)
 	}
 }
 
+#define FAIR_NUM_THREADS (CONFIG_MP_MAX_NUM_CPUS + 1)
+#define FAIR_PRIO K_PRIO_PREEMPT(5)
+#define FAIR_RUN_MS ((int)(1000 * RUN_FACTOR))
+#define FAIR_SLICE_MS 10
+
+static struct k_thread fair_thread[FAIR_NUM_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(fair_stack, FAIR_NUM_THREADS, STACK_SIZE);
+static volatile uint32_t fair_count[FAIR_NUM_THREADS];
+static volatile bool fair_stop;
+
+static void fair_yield_entry(void *p1, void *p2, void *p3)
+{
+	volatile uint32_t *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!fair_stop) {
+		(*count)++;
+		k_yield();
+	}
+}
+
+static void fair_spin_entry(void *p1, void *p2, void *p3)
+{
+	volatile uint32_t *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!fair_stop) {
+		(*count)++;
+	}
+}
+
+/* Runs one more thread of the same priority than there are CPUs, so
+ * that a thread always waits, and checks that they all got about the
+ * same share of the CPUs: the waiting thread must be the next one to
+ * run on whichever CPU yields or ends its time slice, whatever CPU it
+ * was queued on.
+ */
+static void check_fairness(k_thread_entry_t entry)
+{
+	unsigned int num_threads = arch_num_cpus() + 1;
+	uint32_t min = UINT32_MAX, max = 0;
+
+	fair_stop = false;
+
+	for (int i = 0; i < num_threads; i++) {
+		fair_count[i] = 0;
+		k_thread_create(&fair_thread[i], fair_stack[i], STACK_SIZE,
+				entry, (void *)&fair_count[i], NULL, NULL,
+				FAIR_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(FAIR_RUN_MS);
+	fair_stop = true;
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&fair_thread[i], K_FOREVER);
+		min = MIN(min, fair_count[i]);
+		max = MAX(max, fair_count[i]);
+	}
+
+	/* Sharing one CPU between two threads while the others keep a
+	 * CPU each would give a ratio of 1/2.
+	 */
+	zassert_true(min > 0, "a thread never ran");
+	zassert_true((uint64_t)min * 3 >= (uint64_t)max * 2,
+		     "unfair share: min %u max %u", min, max);
+}
+
+/**
+ * @brief Test that threads of equal priority take turns on k_yield()
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Spawn one more preemptible thread than there are CPUs, all
+ * of the same priority and calling k_yield() in a loop. Each thread
+ * must run about as many times as the others.
+ */
+ZTEST(smp, test_yield_fairness)
+{
+	check_fairness(fair_yield_entry);
+}
+
+/**
+ * @brief Test that threads of equal priority take turns on time slice
+ * expiry
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Spawn one more preemptible thread than there are CPUs, all
+ * of the same priority and spinning without yielding, with time
+ * slicing enabled. Each thread must get about the same CPU time.
+ */
+ZTEST(smp, test_timeslice_fairness)
+{
+#ifdef CONFIG_TIMESLICING
+	k_sched_time_slice_set(FAIR_SLICE_MS, FAIR_PRIO);
+	check_fairness(fair_spin_entry);
+	k_sched_time_slice_set(0, 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void *smp_tests_setup(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define HELPER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_WAKEUPS 10
+#define NUM_READY 3
+
+static K_THREAD_STACK_ARRAY_DEFINE(helper_stacks, NUM_READY, HELPER_STACK_SIZE);
+static struct k_thread helper_threads[NUM_READY];
+
+K_SEM_DEFINE(wake_sem, 0, 1);
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		k_sem_take(&wake_sem, K_FOREVER);
+	}
+}
+
+static void dummy(void *p1, void *p2, void *p3)
+{
+}
+
+/**
+ * @brief Test the k_thread_wakeup_stats_get() API
+ *
+ * A higher priority thread is started and then woken up NUM_WAKEUPS
+ * times by a semaphore.  Every one of these, including the start, must
+ * be measured once and land in the histogram.
+ */
+ZTEST(wakeup_latency, test_thread_wakeup_stats)
+{
+	struct k_wakeup_stats stats;
+	uint32_t hist_total = 0;
+
+	zassert_equal(k_thread_wakeup_stats_get(NULL, &stats, false), -EINVAL);
+	zassert_equal(k_thread_wakeup_stats_get(k_current_get(), NULL, false),
+		      -EINVAL);
+
+	k_thread_create(&helper_threads[0], helper_stacks[0], HELPER_STACK_SIZE,
+			waiter, NULL, NULL, NULL, K_HIGHEST_APPLICATION_THREAD_PRIO,
+			0, K_NO_WAIT);
+
+	/* The test thread may be cooperative, so sleep to let the
+	 * helper start and pend, and to let it run after each give.
+	 */
+	k_msleep(1);
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		k_sem_give(&wake_sem);
+		k_msleep(1);
+	}
+
+	zassert_ok(k_thread_join(&helper_threads[0], K_FOREVER));
+
+	zassert_ok(k_thread_wakeup_stats_get(&helper_threads[0], &stats, true));
+	zassert_equal(stats.count, NUM_WAKEUPS + 1, "%u wakeups", stats.count);
+	zassert_true(stats.total <= (uint64_t)stats.longest * stats.count);
+
+	for (int i = 0; i < ARRAY_SIZE(stats.hist); i++) {
+		hist_total += stats.hist[i];
+	}
+	zassert_equal(hist_total, stats.count, "histogram holds %u", hist_total);
+
+	/**TESTPOINT: reading with reset cleared the statistics */
+	zassert_ok(k_thread_wakeup_stats_get(&helper_threads[0], &stats, false));
+	zassert_equal(stats.count, 0);
+}
+
+/**
+ * @brief Test the k_sched_runq_stats_get() API
+ *
+ * NUM_READY lower priority threads are made ready, then the test thread
+ * sleeps: when the CPU switches to the first of them all are still in the
+ * run queue.
+ */
+ZTEST(wakeup_latency, test_runq_stats)
+{
+	struct k_runq_stats stats;
+	uint32_t depth;
+
+	zassert_equal(k_sched_runq_stats_get(0, NULL, false), -EINVAL);
+	zassert_equal(k_sched_runq_stats_get(-1, &stats, false), -EINVAL);
+	zassert_equal(k_sched_runq_stats_get(arch_num_cpus(), &stats, false),
+		      -EINVAL);
+
+	zassert_ok(k_sched_runq_stats_get(0, &stats, true));
+	depth = stats.depth;
+
+	for (int i = 0; i < NUM_READY; i++) {
+		k_thread_create(&helper_threads[i], helper_stacks[i],
+				HELPER_STACK_SIZE, dummy, NULL, NULL, NULL,
+				K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	zassert_ok(k_sched_runq_stats_get(0, &stats, false));
+	zassert_equal(stats.depth, depth + NUM_READY, "depth %u", stats.depth);
+
+	k_msleep(10);
+
+	for (int i = 0; i < NUM_READY; i++) {
+		zassert_ok(k_thread_join(&helper_threads[i], K_FOREVER));
+	}
+
+	zassert_ok(k_sched_runq_stats_get(0, &stats, true));
+	zassert_true(stats.peak >= NUM_READY, "peak %u", stats.peak);
+	zassert_true(stats.num_samples >= NUM_READY, "%u samples",
+		     stats.num_samples);
+}
+
+ZTEST_SUITE(wakeup_latency, NULL, NULL, NULL, NULL, NULL);
@@ -770,4 +770,190 @@ ZTEST(lib_json_test, test_large_descriptor)
 	zassert_true(ret & ((int64_t)1 << 39), "Field int39 not decoded");
 }
 
+ZTEST(lib_json_test, test_json_out_of_order_keys)
+{
+	struct test_nested nested;
+	char encoded[] = "{\"nested_string\":\"last\","
+		"\"nested_bool\":true,"
+		"\"unknown\":1,"
+		"\"nested_int\":7}";
+	int64_t ret;
+
+	/* Keys in reverse descriptor order, with an unknown one mixed in */
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, nested_descr,
+			     ARRAY_SIZE(nested_descr), &nested);
+
+	zassert_equal(ret, (1 << ARRAY_SIZE(nested_descr)) - 1,
+		      "Not all fields decoded correctly");
+	zassert_equal(nested.nested_int, 7, "Integer not decoded correctly");
+	zassert_true(nested.nested_bool, "Boolean not decoded correctly");
+	zassert_true(!strcmp(nested.nested_string, "last"),
+		     "String not decoded correctly");
+}
+
+ZTEST(lib_json_test, test_json_out_of_order_keys_index)
+{
+	struct test_struct ts;
+	char encoded[] = "{\"4nother_ne$+\":{\"nested_int\":2},"
+		"\"if\":true,"
+		"\"some_int\":42,"
+		"\"another_b!@l\":true,"
+		"\"some_int\":43,"
+		"\"some_ints\":44,"
+		"\"some_string\":\"first\"}";
+	static const struct json_obj_descr hashless_descr[] = {
+		{ .field_name = "nested_int", .field_name_len = 10,
+		  .align_shift = Z_ALIGN_SHIFT(int), .type = JSON_TOK_NUMBER,
+		  .offset = offsetof(struct test_nested, nested_int) },
+		{ .field_name = "nested_bool", .field_name_len = 11,
+		  .align_shift = Z_ALIGN_SHIFT(bool), .type = JSON_TOK_TRUE,
+		  .offset = offsetof(struct test_nested, nested_bool) },
+	};
+	char hashless[] = "{\"nested_bool\":true,\"nested_int\":5}";
+	struct test_nested nested;
+	int64_t ret;
+
+	/* Keys far from their descriptor position go through the name index,
+	 * repeated keys keep the first value and near misses are skipped.
+	 */
+	memset(&ts, 0, sizeof(ts));
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+
+	zassert_equal(ret, BIT(0) | BIT(1) | BIT(5) | BIT(6) | BIT(8),
+		      "Unexpected fields decoded: %lld", ret);
+	zassert_true(!strcmp(ts.some_string, "first"),
+		     "String not decoded correctly");
+	zassert_equal(ts.some_int, 42, "Repeated key overwrote the value");
+	zassert_true(ts.another_bxxl, "Named boolean not decoded correctly");
+	zassert_true(ts.if_, "Named boolean not decoded correctly");
+	zassert_equal(ts.xnother_nexx.nested_int, 2,
+		      "Named object not decoded correctly");
+
+	/* Descriptors built without the macros have no precomputed hash */
+	ret = json_obj_parse(hashless, sizeof(hashless) - 1, hashless_descr,
+			     ARRAY_SIZE(hashless_descr), &nested);
+
+	zassert_equal(ret, BIT(0) | BIT(1), "Unexpected fields decoded: %lld",
+		      ret);
+	zassert_equal(nested.nested_int, 5, "Integer not decoded correctly");
+	zassert_true(nested.nested_bool, "Boolean not decoded correctly");
+}
+
+ZTEST(lib_json_test, test_json_out_of_order_keys_nested)
+{
+	struct test_struct ts;
+	char encoded[] = "{\"if\":true,"
+		"\"some_nested_struct\":{\"nested_string\":\"a\","
+		"\"nested_int\":1},"
+		"\"some_bool\":true,"
+		"\"4nother_ne$+\":{\"nested_bool\":true,\"nested_int\":2},"
+		"\"some_string\":\"b\"}";
+	int64_t ret;
+
+	/* Objects at every level need the name index in turn, so that it is
+	 * rebuilt for the outer object after each nested one.
+	 */
+	memset(&ts, 0, sizeof(ts));
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+
+	zassert_equal(ret, BIT(0) | BIT(2) | BIT(3) | BIT(6) | BIT(8),
+		      "Unexpected fields decoded: %lld", ret);
+	zassert_true(!strcmp(ts.some_string, "b"),
+		     "String not decoded correctly");
+	zassert_true(ts.some_bool, "Boolean not decoded correctly");
+	zassert_true(ts.if_, "Named boolean not decoded correctly");
+	zassert_equal(ts.some_nested_struct.nested_int, 1,
+		      "Nested integer not decoded correctly");
+	zassert_true(!strcmp(ts.some_nested_struct.nested_string, "a"),
+		     "Nested string not decoded correctly");
+	zassert_equal(ts.xnother_nexx.nested_int, 2,
+		      "Named object not decoded correctly");
+	zassert_true(ts.xnother_nexx.nested_bool,
+		     "Named object not decoded correctly");
+}
+
+ZTEST(lib_json_test, test_json_obj_buffered)
+{
+	const char encoded[] = "  {\"some_string\":\"brace } and \\\"quote\\\"\","
+		"\"some_int\": 42,\n"
+		"\"some_nested_struct\":{\"nested_int\":-3,"
+		"\"nested_bool\":true,\"nested_string\":\"{\"},"
+		"\"some_array\":[1, 2, 3]}\r\n";
+	const size_t chunk_sizes[] = { 1, 3, 16, sizeof(encoded) - 1 };
+	struct json_obj_buffered state;
+	struct test_struct ts;
+	char buf[sizeof(encoded)];
+	int64_t ret;
+
+	for (int i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		size_t pos = 0;
+
+		memset(&ts, 0, sizeof(ts));
+		zassert_ok(json_obj_buffered_init(&state, buf, sizeof(buf),
+						  test_descr,
+						  ARRAY_SIZE(test_descr), &ts));
+
+		while (pos < sizeof(encoded) - 1) {
+			size_t n = MIN(chunk_sizes[i], sizeof(encoded) - 1 - pos);
+
+			ret = json_obj_buffered_feed(&state, encoded + pos, n);
+			pos += n;
+			zassert_true(ret != -EAGAIN || pos < sizeof(encoded) - 1,
+				     "Object not complete with chunk size %zu",
+				     chunk_sizes[i]);
+		}
+
+		zassert_equal(ret, BIT(0) | BIT(1) | BIT(3) | BIT(4),
+			      "Unexpected fields decoded: %lld", ret);
+		zassert_true(!strcmp(ts.some_string,
+				     "brace } and \\\"quote\\\""),
+			     "String not decoded correctly");
+		zassert_equal(ts.some_int, 42, "Integer not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int, -3,
+			      "Nested integer not decoded correctly");
+		zassert_true(!strcmp(ts.some_nested_struct.nested_string, "{"),
+			     "Nested string not decoded correctly");
+		zassert_equal(ts.some_array_len, 3,
+			      "Array doesn't have correct number of items");
+		zassert_equal(json_obj_buffered_feed(&state, "{", 1), -EINVAL,
+			      "Data accepted after the object was complete");
+	}
+
+	/* Object larger than the scratch buffer */
+	zassert_ok(json_obj_buffered_init(&state, buf, 8, test_descr,
+					  ARRAY_SIZE(test_descr), &ts));
+	zassert_equal(json_obj_buffered_feed(&state, encoded, sizeof(encoded) - 1),
+		      -ENOMEM, "Overflow not detected");
+
+	/* Not an object, and garbage after the object */
+	zassert_ok(json_obj_buffered_init(&state, buf, sizeof(buf), test_descr,
+					  ARRAY_SIZE(test_descr), &ts));
+	zassert_equal(json_obj_buffered_feed(&state, "[1]", 3), -EINVAL,
+		      "Array accepted as an object");
+	zassert_ok(json_obj_buffered_init(&state, buf, sizeof(buf), test_descr,
+					  ARRAY_SIZE(test_descr), &ts));
+	zassert_equal(json_obj_buffered_feed(&state, "{} x", 4), -EINVAL,
+		      "Trailing data accepted");
+
+	/* Whitespace separating two tokens is significant, also when it ends
+	 * a fragment.
+	 */
+	zassert_ok(json_obj_buffered_init(&state, buf, sizeof(buf), test_descr,
+					  ARRAY_SIZE(test_descr), &ts));
+	zassert_equal(json_obj_buffered_feed(&state, "{\"some_int\":1 2}", 16),
+		      -EINVAL, "Separated numbers accepted as one");
+	zassert_ok(json_obj_buffered_init(&state, buf, sizeof(buf), test_descr,
+					  ARRAY_SIZE(test_descr), &ts));
+	zassert_equal(json_obj_buffered_feed(&state, "{\"some_int\":1 ", 14),
+		      -EAGAIN, "Object complete too early");
+	zassert_equal(json_obj_buffered_feed(&state, "2}", 2), -EINVAL,
+		      "Separated numbers accepted as one");
+	zassert_ok(json_obj_buffered_init(&state, buf, sizeof(buf), test_descr,
+					  ARRAY_SIZE(test_descr), &ts));
+	zassert_equal(json_obj_buffered_feed(&state, "{\"some_bool\":tr ue}", 19),
+		      -EINVAL, "Split literal accepted");
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mpmc_ring.h>
+
+struct msg {
+	uint16_t id;
+	uint32_t seq;
+	uint8_t pad;
+} __packed;
+
+#define RING_MSGS 8
+
+static atomic_t ring_buf[MPMC_RING_BUF_WORDS(sizeof(struct msg), RING_MSGS)];
+static struct mpmc_ring ring;
+
+MPMC_RING_DEFINE(static_ring, sizeof(uint32_t), 4);
+
+ZTEST(mpmc_ring, test_init_invalid)
+{
+	zassert_equal(mpmc_ring_init(&ring, ring_buf, sizeof(struct msg), 6),
+		      -EINVAL, "Non power of two size accepted");
+	zassert_equal(mpmc_ring_init(&ring, ring_buf, 0, RING_MSGS),
+		      -EINVAL, "Zero message size accepted");
+}
+
+ZTEST(mpmc_ring, test_put_get)
+{
+	struct msg in = { 0 }, out;
+	uint32_t next_out = 0;
+
+	zassert_ok(mpmc_ring_init(&ring, ring_buf, sizeof(struct msg), RING_MSGS));
+	zassert_equal(mpmc_ring_get(&ring, &out), -EAGAIN, "Empty ring not empty");
+
+	/* Go around the ring several times at varying fill levels */
+	for (int lap = 0; lap < 10; lap++) {
+		int fill = (lap % RING_MSGS) + 1;
+
+		for (int i = 0; i < fill; i++) {
+			in.seq++;
+			zassert_ok(mpmc_ring_put(&ring, &in));
+		}
+		zassert_equal(mpmc_ring_num_used_get(&ring), fill);
+
+		for (int i = 0; i < fill; i++) {
+			zassert_ok(mpmc_ring_get(&ring, &out));
+			zassert_equal(out.seq, ++next_out, "Out of order");
+		}
+		zassert_equal(mpmc_ring_get(&ring, &out), -EAGAIN,
+			      "Drained ring not empty");
+	}
+
+	for (int i = 0; i < RING_MSGS; i++) {
+		zassert_ok(mpmc_ring_put(&ring, &in));
+	}
+	zassert_equal(mpmc_ring_put(&ring, &in), -ENOSPC, "Full ring accepted");
+	zassert_equal(mpmc_ring_num_used_get(&ring), RING_MSGS);
+}
+
+ZTEST(mpmc_ring, test_static_define)
+{
+	uint32_t val;
+
+	for (uint32_t i = 0; i < 4; i++) {
+		zassert_ok(mpmc_ring_put(&static_ring, &i));
+	}
+	zassert_equal(mpmc_ring_put(&static_ring, &val), -ENOSPC);
+
+	for (uint32_t i = 0; i < 4; i++) {
+		zassert_ok(mpmc_ring_get(&static_ring, &val));
+		zassert_equal(val, i);
+	}
+}
+
+/* Message queue facade */
+
+#define NUM_PRODUCERS 3
+#define NUM_CONSUMERS 3
+#define MSGS_PER_PRODUCER 2000
+#define ISR_ID NUM_PRODUCERS
+#define ISR_MSGS 50
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+MPMC_MSGQ_DEFINE(msgq, sizeof(struct msg), 16);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_PRODUCERS + NUM_CONSUMERS,
+				   STACK_SIZE);
+static struct k_thread threads[NUM_PRODUCERS + NUM_CONSUMERS];
+
+static atomic_t received[NUM_PRODUCERS + 1];
+static atomic_t isr_sent;
+static struct k_timer isr_timer;
+
+static void drain(void)
+{
+	struct msg out;
+
+	while (mpmc_msgq_get(&msgq, &out, K_NO_WAIT) == 0) {
+	}
+}
+
+ZTEST(mpmc_ring, test_msgq_no_wait)
+{
+	struct msg in = { 0 }, out;
+
+	drain();
+
+	zassert_equal(mpmc_msgq_get(&msgq, &out, K_NO_WAIT), -ENOMSG);
+	zassert_equal(mpmc_msgq_get(&msgq, &out, K_MSEC(10)), -EAGAIN);
+
+	for (int i = 0; i < 16; i++) {
+		zassert_ok(mpmc_msgq_put(&msgq, &in, K_NO_WAIT));
+	}
+	zassert_equal(mpmc_msgq_put(&msgq, &in, K_NO_WAIT), -ENOMSG);
+	zassert_equal(mpmc_msgq_put(&msgq, &in, K_MSEC(10)), -EAGAIN);
+	zassert_equal(mpmc_msgq_num_used_get(&msgq), 16);
+
+	drain();
+}
+
+static void blocked_getter(void *p1, void *p2, void *p3)
+{
+	struct msg out;
+
+	zassert_ok(mpmc_msgq_get(&msgq, &out, K_FOREVER));
+	zassert_equal(out.seq, 42);
+}
+
+static void blocked_putter(void *p1, void *p2, void *p3)
+{
+	struct msg in = { .seq = 43 };
+
+	zassert_ok(mpmc_msgq_put(&msgq, &in, K_FOREVER));
+}
+
+ZTEST(mpmc_ring, test_msgq_wakeup)
+{
+	struct msg in = { .seq = 42 }, out;
+
+	drain();
+
+	/* A sleeping consumer is woken by a put */
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE, blocked_getter,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+	zassert_equal(atomic_get(&msgq.get_waiters), 1, "Consumer not waiting");
+	zassert_ok(mpmc_msgq_put(&msgq, &in, K_NO_WAIT));
+	zassert_ok(k_thread_join(&threads[0], K_MSEC(100)), "Consumer not woken");
+
+	/* A sleeping producer is woken by a get */
+	for (int i = 0; i < 16; i++) {
+		zassert_ok(mpmc_msgq_put(&msgq, &in, K_NO_WAIT));
+	}
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE, blocked_putter,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+	zassert_equal(atomic_get(&msgq.put_waiters), 1, "Producer not waiting");
+	zassert_ok(mpmc_msgq_get(&msgq, &out, K_NO_WAIT));
+	zassert_ok(k_thread_join(&threads[0], K_MSEC(100)), "Producer not woken");
+
+	for (int i = 0; i < 16; i++) {
+		zassert_ok(mpmc_msgq_get(&msgq, &out, K_NO_WAIT));
+		zassert_equal(out.seq, i < 15 ? 42 : 43);
+	}
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	struct msg in = { .id = POINTER_TO_UINT(p1) };
+
+	for (in.seq = 1; in.seq <= MSGS_PER_PRODUCER; in.seq++) {
+		zassert_ok(mpmc_msgq_put(&msgq, &in, K_FOREVER));
+		if ((in.seq % 64) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t last[NUM_PRODUCERS + 1] = { 0 };
+	struct msg out;
+
+	while (mpmc_msgq_get(&msgq, &out, K_MSEC(500)) == 0) {
+		zassert_true(out.id <= ISR_ID, "Corrupted message");
+		/* Each consumer sees every producer's messages in order */
+		zassert_true(out.seq > last[out.id], "Out of order");
+		last[out.id] = out.seq;
+		atomic_inc(&received[out.id]);
+	}
+}
+
+static void isr_producer(struct k_timer *timer)
+{
+	struct msg in = {
+		.id = ISR_ID,
+		.seq = atomic_get(&isr_sent) + 1,
+	};
+
+	if (mpmc_msgq_put(&msgq, &in, K_NO_WAIT) == 0) {
+		if (atomic_inc(&isr_sent) + 1 == ISR_MSGS) {
+			k_timer_stop(timer);
+		}
+	}
+}
+
+ZTEST(mpmc_ring, test_msgq_concurrent)
+{
+	int prio = K_PRIO_PREEMPT(1);
+
+	drain();
+
+	for (int i = 0; i < ARRAY_SIZE(received); i++) {
+		atomic_clear(&received[i]);
+	}
+	atomic_clear(&isr_sent);
+
+	for (int i = 0; i < NUM_CONSUMERS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, consumer,
+				NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		int t = NUM_CONSUMERS + i;
+
+		k_thread_create(&threads[t], stacks[t], STACK_SIZE, producer,
+				UINT_TO_POINTER(i), NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	k_timer_init(&isr_timer, isr_producer, NULL);
+	k_timer_start(&isr_timer, K_MSEC(1), K_MSEC(1));
+
+	for (int i = 0; i < ARRAY_SIZE(threads); i++) {
+		zassert_ok(k_thread_join(&threads[i], K_SECONDS(60)));
+	}
+	k_timer_stop(&isr_timer);
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		zassert_equal(atomic_get(&received[i]), MSGS_PER_PRODUCER,
+			      "Producer %d: %ld messages received", i,
+			      atomic_get(&received[i]));
+	}
+	zassert_equal(atomic_get(&received[ISR_ID]), atomic_get(&isr_sent),
+		      "ISR messages lost");
+	zassert_equal(mpmc_msgq_num_used_get(&msgq), 0);
+}
+
+ZTEST_SUITE(mpmc_ring, NULL, NULL, NULL, NULL, NULL);
@@ -34,6 +34,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "ipv6.h"
 #include "nbr.h"
 #include "route.h"
+#include "route_trie.h"
 
 #if defined(CONFIG_NET_ROUTE_LOG_LEVEL_DBG)
 #define DBG(fmt, ...) printk(fmt, ##__VA_ARGS__)
@@ -544,6 +545,103 @@ static void test_route_preference(void)
 	net_route_del(entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct in6_addr prefix48 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr prefix64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0x02,
+					 0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr host = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0x02,
+				     0, 0, 0, 0, 0, 0, 0, 0x05 } } };
+	struct in6_addr in64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0x02,
+				     0, 0, 0, 0, 0, 0, 0, 0x06 } } };
+	struct in6_addr in48 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0x03,
+				     0, 0, 0, 0, 0, 0, 0, 0x05 } } };
+	struct net_route_entry *route48, *route64, *route128;
+
+	/* The covering prefix is added first, the longer ones must not
+	 * replace it.
+	 */
+	route48 = net_route_add(my_iface, &prefix48, 48, &peer_addr,
+				NET_IPV6_ND_INFINITE_LIFETIME,
+				NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route48, "Route add failed");
+
+	route64 = net_route_add(my_iface, &prefix64, 64, &peer_addr_alt,
+				NET_IPV6_ND_INFINITE_LIFETIME,
+				NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route64, "Route add failed");
+	zassert_not_equal(route64, route48, "Longer prefix replaced route");
+
+	route128 = net_route_add(my_iface, &host, 128, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route128, "Route add failed");
+	zassert_not_equal(route128, route48, "Longer prefix replaced route");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &host), route128,
+			  "Host route not selected");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in64), route64,
+			  "/64 route not selected");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in48), route48,
+			  "/48 route not selected");
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Route found for an unrelated address");
+	zassert_is_null(net_route_lookup(peer_iface, &host),
+			"Route found on the wrong interface");
+
+	/* The addresses of the removed prefix fall back to the shorter one */
+	zassert_ok(net_route_del(route64), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in64), route48,
+			  "No fallback to the /48 route");
+	zassert_equal_ptr(net_route_lookup(my_iface, &host), route128,
+			  "Host route not selected");
+
+	zassert_ok(net_route_del(route128), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &host), route48,
+			  "No fallback to the /48 route");
+
+	zassert_ok(net_route_del(route48), "Route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &host),
+			"Route found after all were removed");
+}
+
+static void test_route_invalid_prefix_len(void)
+{
+	struct net_route_trie_node nodes[2];
+	struct net_route_trie trie;
+	sys_snode_t trie_entry;
+	struct net_route_entry *route;
+
+	/* A Router Advertisement carries an 8-bit prefix length, anything
+	 * longer than an address must not reach the trie.
+	 */
+	route = net_route_add(my_iface, &dest_addr, 129, &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_is_null(route, "Route with a 129 bit prefix added");
+
+	route = net_route_add(my_iface, &dest_addr, 255, &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_is_null(route, "Route with a 255 bit prefix added");
+
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Route found for an invalid prefix");
+
+	net_route_trie_init(&trie, nodes, ARRAY_SIZE(nodes));
+
+	zassert_equal(net_route_trie_add(&trie, &dest_addr, 255, &trie_entry),
+		      -EINVAL, "Invalid prefix length added to the trie");
+	zassert_is_null(net_route_trie_find(&trie, &dest_addr, 255, NULL,
+					    NULL),
+			"Invalid prefix length found in the trie");
+
+	zassert_ok(net_route_trie_add(&trie, &dest_addr, 128, &trie_entry),
+		   "Host prefix not added to the trie");
+	zassert_equal_ptr(net_route_trie_lookup(&trie, &dest_addr, NULL, NULL),
+			  &trie_entry, "Host prefix not found in the trie");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +664,8 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
+	test_route_invalid_prefix_len();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+#include "net_stats.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define TEST_PORT 4242
+#define FLOW_PORT 5000
+#define FLOWS 8
+#define PKTS_PER_FLOW 16
+#define WAIT_TIME K_SECONDS(1)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static struct net_context *udp_ctx;
+static K_SEM_DEFINE(recv_sem, 0, UINT_MAX);
+
+static struct {
+	k_tid_t thread;
+	uint32_t next_seq;
+	bool out_of_order;
+	bool thread_changed;
+} flows[FLOWS];
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api dummy_if_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_rx_flow_test, "net_rx_flow_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static void recv_cb(struct net_context *context, struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr,
+		    union net_proto_header *proto_hdr,
+		    int status, void *user_data)
+{
+	int flow = ntohs(proto_hdr->udp->src_port) - FLOW_PORT;
+	uint32_t seq;
+
+	ARG_UNUSED(context);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(status);
+	ARG_UNUSED(user_data);
+
+	if (flow >= 0 && flow < FLOWS && net_pkt_read_be32(pkt, &seq) == 0) {
+		if (flows[flow].thread == NULL) {
+			flows[flow].thread = k_current_get();
+		} else if (flows[flow].thread != k_current_get()) {
+			flows[flow].thread_changed = true;
+		}
+
+		if (seq != flows[flow].next_seq) {
+			flows[flow].out_of_order = true;
+		}
+
+		flows[flow].next_seq = seq + 1;
+	}
+
+	net_pkt_unref(pkt);
+	k_sem_give(&recv_sem);
+}
+
+static void recv_udp(int flow, uint32_t seq)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, NET_UDPH_LEN + sizeof(seq),
+					AF_INET, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_ipv4_create(pkt, &peer_addr, &my_addr), "IPv4 header");
+	zassert_ok(net_udp_create(pkt, htons(FLOW_PORT + flow), htons(TEST_PORT)),
+		   "UDP header");
+	zassert_ok(net_pkt_write_be32(pkt, seq), "UDP payload");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_UDP), "Finalize");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_recv_data(iface, pkt), "Cannot receive packet");
+}
+
+static void recv_raw(const uint8_t *data, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, data, len), "Cannot write packet");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_recv_data(iface, pkt), "Cannot receive packet");
+}
+
+static void get_queue_pkts(net_stats_t *pkts)
+{
+	for (int i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		pkts[i] = GET_STAT(iface, rx_queue[i].pkts);
+	}
+}
+
+ZTEST(net_rx_flow_steering, test_flows_keep_order)
+{
+	net_stats_t before[NET_RX_QUEUE_COUNT];
+	net_stats_t after[NET_RX_QUEUE_COUNT];
+	net_stats_t total = 0;
+	int queues_used = 0;
+	k_tid_t first = NULL;
+	bool spread = false;
+
+	memset(flows, 0, sizeof(flows));
+	get_queue_pkts(before);
+
+	for (int seq = 0; seq < PKTS_PER_FLOW; seq++) {
+		for (int flow = 0; flow < FLOWS; flow++) {
+			recv_udp(flow, seq);
+		}
+
+		/* Let the RX threads drain their queues now and then */
+		if (seq % 4 == 3) {
+			k_yield();
+		}
+	}
+
+	for (int i = 0; i < FLOWS * PKTS_PER_FLOW; i++) {
+		zassert_ok(k_sem_take(&recv_sem, WAIT_TIME),
+			   "Timeout after %d packets", i);
+	}
+
+	for (int flow = 0; flow < FLOWS; flow++) {
+		zassert_false(flows[flow].out_of_order,
+			      "Flow %d received out of order", flow);
+		zassert_false(flows[flow].thread_changed,
+			      "Flow %d processed by several threads", flow);
+		zassert_equal(flows[flow].next_seq, PKTS_PER_FLOW,
+			      "Flow %d lost packets", flow);
+
+		if (first == NULL) {
+			first = flows[flow].thread;
+		} else if (flows[flow].thread != first) {
+			spread = true;
+		}
+	}
+
+	zassert_true(spread, "All the flows were processed by one thread");
+
+	get_queue_pkts(after);
+
+	for (int i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		total += after[i] - before[i];
+
+		if (after[i] != before[i]) {
+			queues_used++;
+		}
+	}
+
+	zassert_equal(total, FLOWS * PKTS_PER_FLOW,
+		      "Queue statistics count %u packets", total);
+	zassert_true(queues_used > 1, "Only one queue used");
+}
+
+ZTEST(net_rx_flow_steering, test_fragments_same_queue)
+{
+	/* The first and second fragment of a UDP datagram. The second one
+	 * does not start with the UDP header but with the rest of the data.
+	 */
+	uint8_t frag1[NET_IPV4H_LEN + 8] = {
+		0x45, 0x00, 0x00, 0x1c, 0x12, 0x34, 0x20, 0x00,
+		0x40, IPPROTO_UDP, 0x00, 0x00, 192, 0, 2, 2,
+		192, 0, 2, 1, 0x13, 0x88, 0x10, 0x92,
+	};
+	uint8_t frag2[NET_IPV4H_LEN + 8] = {
+		0x45, 0x00, 0x00, 0x1c, 0x12, 0x34, 0x00, 0x01,
+		0x40, IPPROTO_UDP, 0x00, 0x00, 192, 0, 2, 2,
+		192, 0, 2, 1, 0xde, 0xad, 0xbe, 0xef,
+	};
+	net_stats_t before[NET_RX_QUEUE_COUNT];
+	net_stats_t after[NET_RX_QUEUE_COUNT];
+	int queue = -1;
+
+	get_queue_pkts(before);
+
+	recv_raw(frag1, sizeof(frag1));
+	recv_raw(frag2, sizeof(frag2));
+
+	get_queue_pkts(after);
+
+	for (int i = 0; i < NET_RX_QUEUE_COUNT; i++) {
+		if (after[i] == before[i]) {
+			continue;
+		}
+
+		zassert_equal(queue, -1, "Fragments steered to several queues");
+		zassert_equal(after[i] - before[i], 2,
+			      "Fragments steered to several queues");
+		queue = i;
+	}
+
+	zassert_not_equal(queue, -1, "Fragments not counted");
+}
+
+ZTEST(net_rx_flow_steering, test_non_ip_first_queue)
+{
+	static const uint8_t data[] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05 };
+	net_stats_t before[NET_RX_QUEUE_COUNT];
+	net_stats_t after[NET_RX_QUEUE_COUNT];
+
+	get_queue_pkts(before);
+
+	recv_raw(data, sizeof(data));
+
+	get_queue_pkts(after);
+
+	zassert_equal(after[0] - before[0], 1,
+		      "Non IP packet not steered to the first queue");
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_PORT),
+		.sin_addr = { { { 192, 0, 2, 1 } } },
+	};
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No dummy interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &udp_ctx);
+	zassert_ok(ret, "Cannot get UDP context (%d)", ret);
+
+	ret = net_context_bind(udp_ctx, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_ok(ret, "Cannot bind UDP context (%d)", ret);
+
+	ret = net_context_recv(udp_ctx, recv_cb, K_NO_WAIT, NULL);
+	zassert_ok(ret, "Cannot receive on UDP context (%d)", ret);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_rx_flow_steering, NULL, setup, NULL, NULL, NULL);
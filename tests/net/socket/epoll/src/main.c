@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+#if defined(CONFIG_EVENTFD)
+#include <zephyr/posix/sys/eventfd.h>
+#endif
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait with a timeout takes +10ms from the requested time. */
+#define FUZZ 10
+
+#define TCP_TEARDOWN_TIMEOUT K_SECONDS(3)
+
+static void epoll_add(int epfd, int fd, uint32_t events)
+{
+	struct epoll_event event = { .events = events, .data.fd = fd };
+	int res;
+
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event);
+	zassert_equal(res, 0, "epoll_ctl ADD failed (%d)", errno);
+}
+
+ZTEST(net_socket_epoll, test_epoll_udp)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct epoll_event events[2];
+	uint32_t tstamp;
+	char buf[10];
+	int c_sock;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, c_sock, EPOLLIN);
+	epoll_add(epfd, s_sock, EPOLLIN);
+
+	/* Wait for non-ready fd's with timeout of 0 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	/* Wait for non-ready fd's with timeout of 30 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "");
+	zassert_equal(res, 0, "");
+
+	/* Only the ready fd is returned */
+	res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "send failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	/* Level triggered, reported until the data is read */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	res = recv(s_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "recv failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* UDP sockets are always writable */
+	events[0].events = EPOLLOUT;
+	events[0].data.u32 = 42;
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, c_sock, &events[0]);
+	zassert_equal(res, 0, "epoll_ctl MOD failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.u32, 42, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl DEL failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_epoll_tcp)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct epoll_event events[2];
+	char buf[10];
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = listen(s_sock, 1);
+	zassert_equal(res, 0, "listen failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, s_sock, EPOLLIN);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* A pending connection makes the listening socket readable */
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 1000);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	new_sock = accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "accept failed");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl DEL failed");
+
+	epoll_add(epfd, new_sock, EPOLLIN);
+	epoll_add(epfd, c_sock, EPOLLOUT);
+
+	/* The connected socket has room in its send window */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 1000);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, c_sock, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl DEL failed");
+
+	res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "send failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 1000);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, new_sock, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	res = recv(new_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "recv failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* The end of the stream is readable too */
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 1000);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, new_sock, "");
+
+	res = recv(new_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, 0, "");
+
+	res = close(new_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_epoll, test_epoll_ctl_errors)
+{
+	struct epoll_event event = { .events = EPOLLIN };
+	int sv[2];
+	int epfd;
+	int epfd2;
+	int res;
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	res = epoll_create1(1);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	epoll_add(epfd, sv[0], EPOLLIN);
+
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, sv[0], &event);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, sv[1], &event);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, sv[1], NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, epfd, &event);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, 1000, &event);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EBADF, "");
+
+	res = epoll_ctl(sv[1], EPOLL_CTL_ADD, sv[0], &event);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	/* Nesting epoll instances is not supported */
+	epfd2 = epoll_create1(0);
+	zassert_true(epfd2 >= 0, "epoll_create1 failed");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, epfd2, &event);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EPERM, "");
+
+	res = epoll_wait(epfd, &event, 0, 0);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	res = epoll_wait(sv[0], &event, 1, 0);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	close(epfd2);
+	close(epfd);
+	close(sv[0]);
+	close(sv[1]);
+}
+
+ZTEST(net_socket_epoll, test_epoll_socketpair)
+{
+	struct epoll_event events[2];
+	char buf[10];
+	int sv[2];
+	int first;
+	int epfd;
+	int res;
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, sv[0], EPOLLIN);
+	epoll_add(epfd, sv[1], EPOLLIN);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = send(sv[0], BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "send failed");
+	res = send(sv[1], BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "send failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 2, "");
+
+	/* With one event at a time, the ready fd's take turns */
+	res = epoll_wait(epfd, events, 1, 0);
+	zassert_equal(res, 1, "");
+	first = events[0].data.fd;
+
+	res = epoll_wait(epfd, events, 1, 0);
+	zassert_equal(res, 1, "");
+	zassert_not_equal(events[0].data.fd, first, "");
+
+	res = epoll_wait(epfd, events, 1, 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, first, "");
+
+	res = recv(sv[0], buf, sizeof(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "recv failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, sv[1], "");
+
+	/* A closed fd is dropped from the set, its peer sees the hang up */
+	res = close(sv[1]);
+	zassert_equal(res, 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, sv[0], "");
+	zassert_true(events[0].events & EPOLLIN, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, sv[1], NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	close(sv[0]);
+	close(epfd);
+}
+
+ZTEST(net_socket_epoll, test_epoll_oneshot)
+{
+	struct epoll_event event = { .events = EPOLLIN | EPOLLONESHOT };
+	int sv[2];
+	int epfd;
+	int res;
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, sv[0], EPOLLIN | EPOLLONESHOT);
+
+	res = send(sv[1], BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "send failed");
+
+	res = epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 1, "");
+
+	/* Disabled until re-armed, even though still readable */
+	res = epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 0, "");
+
+	event.events = EPOLLIN | EPOLLONESHOT;
+	event.data.fd = sv[0];
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, sv[0], &event);
+	zassert_equal(res, 0, "epoll_ctl MOD failed");
+
+	res = epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(event.data.fd, sv[0], "");
+
+	close(sv[0]);
+	close(sv[1]);
+	close(epfd);
+}
+
+static struct {
+	struct k_work_delayable work;
+	int epfd;
+	int fd;
+} ctl_work;
+
+static void ctl_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	epoll_add(ctl_work.epfd, ctl_work.fd, EPOLLIN);
+}
+
+ZTEST(net_socket_epoll, test_epoll_ctl_wakes_waiter)
+{
+	struct epoll_event event;
+	uint32_t tstamp;
+	int sv[2];
+	int epfd;
+	int res;
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair failed");
+
+	res = send(sv[1], BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "send failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	/* Adding a ready fd while waiting on an empty set ends the wait */
+	ctl_work.epfd = epfd;
+	ctl_work.fd = sv[0];
+	k_work_init_delayable(&ctl_work.work, ctl_work_handler);
+	k_work_schedule(&ctl_work.work, K_MSEC(10));
+
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, &event, 1, 1000);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_equal(res, 1, "");
+	zassert_equal(event.data.fd, sv[0], "");
+	zassert_true(tstamp < 500U, "");
+
+	close(sv[0]);
+	close(sv[1]);
+	close(epfd);
+}
+
+static struct {
+	struct k_work_delayable work;
+	int epfd;
+} close_work;
+
+static void close_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	close(close_work.epfd);
+}
+
+ZTEST(net_socket_epoll, test_epoll_close_wakes_waiter)
+{
+	struct epoll_event event;
+	struct k_work_sync sync;
+	uint32_t tstamp;
+	int sv[2];
+	int epfd;
+	int res;
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, sv[0], EPOLLIN);
+
+	/* Closing the instance while waiting on it fails the wait */
+	close_work.epfd = epfd;
+	k_work_init_delayable(&close_work.work, close_work_handler);
+	k_work_schedule(&close_work.work, K_MSEC(10));
+
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, &event, 1, 1000);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EBADF, "");
+	zassert_true(tstamp < 500U, "");
+
+	k_work_flush_delayable(&close_work.work, &sync);
+
+	/* The instance can be reused once closed */
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	close(epfd);
+	close(sv[0]);
+	close(sv[1]);
+}
+
+ZTEST(net_socket_epoll, test_epoll_eventfd)
+{
+#if defined(CONFIG_EVENTFD)
+	struct epoll_event event;
+	eventfd_t val;
+	int epfd;
+	int efd;
+	int res;
+
+	efd = eventfd(0, 0);
+	zassert_true(efd >= 0, "eventfd failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, efd, EPOLLIN);
+
+	res = epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 0, "");
+
+	res = eventfd_write(efd, 3);
+	zassert_equal(res, 0, "eventfd_write failed");
+
+	res = epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(event.data.fd, efd, "");
+	zassert_equal(event.events, EPOLLIN, "");
+
+	res = eventfd_read(efd, &val);
+	zassert_equal(res, 0, "eventfd_read failed");
+	zassert_equal(val, 3, "");
+
+	res = epoll_wait(epfd, &event, 1, 0);
+	zassert_equal(res, 0, "");
+
+	close(epfd);
+	close(efd);
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
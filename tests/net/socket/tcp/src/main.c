@@ -1188,6 +1188,64 @@ ZTEST(net_socket_tcp, test_so_protocol)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+static void test_congestion_get(int sock, const char *expected)
+{
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int rv;
+
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, strlen(expected) + 1, "getsockopt got invalid size");
+	zassert_equal(strcmp(name, expected), 0, "got %s instead of %s", name,
+		      expected);
+}
+
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	const char *algo = IS_ENABLED(CONFIG_NET_TCP_CC_CUBIC) ? "cubic" : "newreno";
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int rv;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_congestion_get(s_sock, IS_ENABLED(CONFIG_NET_TCP_CC_DEFAULT_CUBIC) ?
+				    "cubic" : "newreno");
+
+	rv = setsockopt(s_sock, IPPROTO_TCP, TCP_CONGESTION, "vegas",
+			strlen("vegas"));
+	zassert_equal(rv, -1, "unknown algorithm accepted");
+	zassert_equal(errno, ENOENT, "Unexpected errno value: %d", errno);
+
+	rv = setsockopt(s_sock, IPPROTO_TCP, TCP_CONGESTION, algo, strlen(algo));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	test_congestion_get(s_sock, algo);
+
+	/* The accepted connection uses the algorithm of the listener */
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	test_congestion_get(new_sock, algo);
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 ZTEST(net_socket_tcp, test_so_rcvbuf)
 {
 	struct sockaddr_in bind_addr4;
@@ -1277,6 +1335,92 @@ ZTEST(net_socket_tcp, test_so_rcvbuf_win_size)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+ZTEST(net_socket_tcp, test_recv_zerocopy)
+{
+	int rv;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	char tx_buf[] = TEST_STR_SMALL;
+	int buf_optval = sizeof(TEST_STR_SMALL);
+	struct iovec iov[2];
+	struct zsock_recv_zc zc = { .iov = iov, .iovlen = ARRAY_SIZE(iov) };
+	size_t total = 0;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	rv = zsock_recv_zerocopy(new_sock, &zc, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "Unexpected return code %d", rv);
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	/* Lower server-side RX window size. */
+	rv = setsockopt(new_sock, SOL_SOCKET, SO_RCVBUF, &buf_optval,
+			sizeof(buf_optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	test_send(c_sock, tx_buf, sizeof(tx_buf), 0);
+
+	rv = zsock_recv_zerocopy(new_sock, &zc, 0);
+	zassert_equal(rv, sizeof(tx_buf), "Unexpected return code %d", rv);
+	zassert_true(zc.iovlen > 0 && zc.iovlen <= ARRAY_SIZE(iov),
+		     "Unexpected iovlen %zu", zc.iovlen);
+
+	for (size_t i = 0; i < zc.iovlen; i++) {
+		zassert_mem_equal(iov[i].iov_base, tx_buf + total,
+				  iov[i].iov_len, "Invalid data received");
+		total += iov[i].iov_len;
+	}
+
+	zassert_equal(total, sizeof(tx_buf), "Unexpected length %zu", total);
+
+	/* The window stays closed while the application holds the data */
+	k_msleep(150);
+
+	rv = send(c_sock, tx_buf, 1, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "Unexpected return code %d", rv);
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	zsock_recv_zerocopy_release(&zc);
+	zassert_is_null(zc.pkt, "Buffers not released");
+
+	/* Giving the buffers back opens it again */
+	k_msleep(150);
+
+	test_send(c_sock, tx_buf, 1, MSG_DONTWAIT);
+
+	zc.iovlen = ARRAY_SIZE(iov);
+	rv = zsock_recv_zerocopy(new_sock, &zc, 0);
+	zassert_equal(rv, 1, "Unexpected return code %d", rv);
+	zassert_equal(*(char *)iov[0].iov_base, tx_buf[0], "Invalid data received");
+	zsock_recv_zerocopy_release(&zc);
+
+	test_close(c_sock);
+
+	zc.iovlen = ARRAY_SIZE(iov);
+	rv = zsock_recv_zerocopy(new_sock, &zc, 0);
+	zassert_equal(rv, 0, "Unexpected return code %d", rv);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZEROCOPY */
+
 ZTEST(net_socket_tcp, test_so_sndbuf)
 {
 	struct sockaddr_in bind_addr4;
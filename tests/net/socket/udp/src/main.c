@@ -1286,4 +1286,212 @@ ZTEST(net_socket_udp, test_23_v6_dgram_overflow)
 			    BUF_AND_SIZE(test_str_all_tx_bufs));
 }
 
+static void test_recvmsg_pktinfo(int sock_c, int sock_s,
+				 struct sockaddr *addr_c, socklen_t addrlen_c,
+				 struct sockaddr *addr_s, socklen_t addrlen_s)
+{
+	int rv;
+	int optval = 1;
+	char buf_a[4];
+	char buf_b[64];
+	struct iovec iov[2];
+	struct msghdr msg;
+	struct sockaddr_storage src;
+	struct cmsghdr *cmsg;
+	union {
+		struct cmsghdr hdr;
+		unsigned char buf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+	} cmsgbuf;
+
+	rv = bind(sock_s, addr_s, addrlen_s);
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(sock_c, addr_c, addrlen_c);
+	zassert_equal(rv, 0, "client bind failed");
+
+	if (addr_s->sa_family == AF_INET) {
+		rv = setsockopt(sock_s, IPPROTO_IP, IP_PKTINFO, &optval,
+				sizeof(optval));
+	} else {
+		rv = setsockopt(sock_s, IPPROTO_IPV6, IPV6_RECVPKTINFO, &optval,
+				sizeof(optval));
+	}
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = sendto(sock_c, BUF_AND_SIZE(TEST_STR2), 0, addr_s, addrlen_s);
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	/* The datagram is scattered over both buffers */
+	iov[0].iov_base = buf_a;
+	iov[0].iov_len = sizeof(buf_a);
+	iov[1].iov_base = buf_b;
+	iov[1].iov_len = sizeof(buf_b);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = ARRAY_SIZE(iov);
+	msg.msg_name = &src;
+	msg.msg_namelen = sizeof(src);
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+
+	rv = recvmsg(sock_s, &msg, 0);
+	zassert_equal(rv, sizeof(buf_a) + sizeof(buf_b), "recvmsg failed (%d)",
+		      errno);
+	zassert_mem_equal(buf_a, TEST_STR2, sizeof(buf_a), "invalid rx data");
+	zassert_mem_equal(buf_b, TEST_STR2 + sizeof(buf_a), sizeof(buf_b),
+			  "invalid rx data");
+	zassert_equal(msg.msg_flags, MSG_TRUNC, "datagram not truncated");
+	zassert_equal(msg.msg_namelen, addrlen_c, "unexpected addrlen");
+	zassert_equal(src.ss_family, addr_c->sa_family, "unexpected family");
+
+	cmsg = CMSG_FIRSTHDR(&msg);
+	zassert_not_null(cmsg, "no ancillary data");
+
+	if (addr_s->sa_family == AF_INET) {
+		struct in_pktinfo *info = (struct in_pktinfo *)CMSG_DATA(cmsg);
+
+		zassert_equal(cmsg->cmsg_level, IPPROTO_IP, "invalid level");
+		zassert_equal(cmsg->cmsg_type, IP_PKTINFO, "invalid type");
+		zassert_true(net_ipv4_addr_cmp(&info->ipi_addr,
+					       &net_sin(addr_s)->sin_addr),
+			     "invalid destination address");
+		zassert_true(info->ipi_ifindex > 0, "invalid interface");
+	} else {
+		struct in6_pktinfo *info = (struct in6_pktinfo *)CMSG_DATA(cmsg);
+
+		zassert_equal(cmsg->cmsg_level, IPPROTO_IPV6, "invalid level");
+		zassert_equal(cmsg->cmsg_type, IPV6_PKTINFO, "invalid type");
+		zassert_true(net_ipv6_addr_cmp(&info->ipi6_addr,
+					       &net_sin6(addr_s)->sin6_addr),
+			     "invalid destination address");
+		zassert_true(info->ipi6_ifindex > 0, "invalid interface");
+	}
+
+	/* Without room for the ancillary data it is dropped */
+	rv = sendto(sock_c, BUF_AND_SIZE(TEST_STR_SMALL), 0, addr_s, addrlen_s);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	msg.msg_name = NULL;
+	msg.msg_control = NULL;
+	msg.msg_controllen = 0;
+
+	rv = recvmsg(sock_s, &msg, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recvmsg failed (%d)", errno);
+	zassert_mem_equal(buf_a, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL),
+			  "invalid rx data");
+	zassert_equal(msg.msg_flags, MSG_CTRUNC, "ancillary data not dropped");
+
+	rv = close(sock_c);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock_s);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST_USER(net_socket_udp, test_24_v4_recvmsg_pktinfo)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	test_recvmsg_pktinfo(client_sock, server_sock,
+			     (struct sockaddr *)&client_addr, sizeof(client_addr),
+			     (struct sockaddr *)&server_addr, sizeof(server_addr));
+}
+
+ZTEST_USER(net_socket_udp, test_25_v6_recvmsg_pktinfo)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	test_recvmsg_pktinfo(client_sock, server_sock,
+			     (struct sockaddr *)&client_addr, sizeof(client_addr),
+			     (struct sockaddr *)&server_addr, sizeof(server_addr));
+}
+
+#define MMSG_COUNT 4
+
+ZTEST_USER(net_socket_udp, test_26_v4_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct mmsghdr msgs[MMSG_COUNT * 2];
+	struct iovec iov[MMSG_COUNT * 2];
+	char bufs[MMSG_COUNT * 2][8];
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = connect(client_sock, (struct sockaddr *)&server_addr,
+		     sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	/* Datagrams of 1 to MMSG_COUNT bytes */
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		memset(bufs[i], 'a' + i, sizeof(bufs[i]));
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = i + 1;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, i + 1, "unexpected sent length");
+	}
+
+	/* Let all of them arrive */
+	k_msleep(100);
+
+	/* Ask for more than were sent, but only wait for the first one */
+	memset(msgs, 0, sizeof(msgs));
+	memset(bufs, 0, sizeof(bufs));
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, i + 1,
+			      "unexpected received length");
+		for (int j = 0; j <= i; j++) {
+			zassert_equal(bufs[i][j], 'a' + i, "invalid rx data");
+		}
+	}
+
+	/* Nothing left, so even the first one isn't there */
+	rv = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should've failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 ZTEST_SUITE(net_socket_udp, NULL, NULL, NULL, NULL, NULL);
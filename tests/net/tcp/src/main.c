@@ -30,7 +30,8 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "tcp.h"
-#include "tcp_private.h"
+#include "tcp_internal.h"
+#include "net_private.h"
 #include "net_stats.h"
 
 #include <zephyr/ztest.h>
@@ -125,6 +126,11 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_client_lossy_test(struct net_pkt *pkt, struct tcphdr *th);
+static void handle_gso_test(struct net_pkt *pkt, struct tcphdr *th);
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+static void handle_congestion_test(struct net_pkt *pkt, struct tcphdr *th);
+#endif
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -213,23 +219,22 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
-static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
-					      uint16_t src_port,
-					      uint16_t dst_port,
-					      uint8_t flags,
-					      const uint8_t *data,
-					      size_t len)
+/* The window is given in network byte order, opts_len is a multiple of 4 */
+static struct net_pkt *tester_prepare_tcp_pkt_ext(sa_family_t af,
+						  uint16_t src_port,
+						  uint16_t dst_port,
+						  uint8_t flags,
+						  uint16_t win,
+						  const uint8_t *opts,
+						  size_t opts_len,
+						  const uint8_t *data,
+						  size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
-	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		opts_len = sizeof(tcp_options);
-	}
-
 	/* Allocate buffer */
 	pkt = net_pkt_alloc_with_buffer(iface,
 					sizeof(struct tcphdr) + len + opts_len,
@@ -262,14 +267,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
-
+	th->th_off = 5U + opts_len / 4U;
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = win;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -281,9 +281,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -316,6 +316,26 @@ fail:
 	return NULL;
 }
 
+static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
+					      uint16_t src_port,
+					      uint16_t dst_port,
+					      uint8_t flags,
+					      const uint8_t *data,
+					      size_t len)
+{
+	const uint8_t *opts = NULL;
+	size_t opts_len = 0;
+
+	if ((test_case_no == 4U) && (flags & SYN)) {
+		opts = tcp_options;
+		opts_len = sizeof(tcp_options);
+	}
+
+	return tester_prepare_tcp_pkt_ext(af, src_port, dst_port, flags,
+					  NET_IPV6_MTU, opts, opts_len, data,
+					  len);
+}
+
 static struct net_pkt *prepare_syn_packet(sa_family_t af, uint16_t src_port,
 					  uint16_t dst_port)
 {
@@ -420,6 +440,18 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_client_lossy_test(pkt, &th);
+		break;
+	case 11:
+	case 12:
+		handle_gso_test(pkt, &th);
+		break;
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	case 13:
+		handle_congestion_test(pkt, &th);
+		break;
+#endif
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1410,8 +1442,8 @@ static struct out_of_order_check_struct out_of_order_check_list[] = {
 	{ 30, 10, 0, 0}, /* First packet will be out-of-order */
 	{ 20, 12, 0, 0},
 	{ 10,  9, 0, 0}, /* Section with a gap */
-	{ 0,  10, 10, 0},
-	{ 10, 10, 40, 0}, /* First sequence complete */
+	{ 0,  10, 19, 0}, /* Complete up to the gap */
+	{ 10, 10, 40, 0}, /* Partly resent, fills the gap */
 	{ 50,  6, 40, 0},
 	{ 50,  3, 40, 0}, /* Discardable packet */
 	{ 55,  5, 40, 0},
@@ -1539,4 +1571,765 @@ ZTEST(net_tcp, test_server_out_of_order_data)
 	test_server_timeout_out_of_order_data();
 }
 
+/* Less than the MSS the test interface allows */
+#define LOSSY_MSS 64
+#define LOSSY_DATA_LEN (5 * LOSSY_MSS)
+
+static uint32_t lossy_data_seq;
+static size_t lossy_sent_max;
+static size_t lossy_resent;
+static bool lossy_sack;
+static uint16_t lossy_port;
+static bool lossy_received[LOSSY_DATA_LEN];
+
+/* The first transmission of the second and the fourth segment is lost */
+static bool lossy_drop(size_t offset)
+{
+	return offset >= lossy_sent_max &&
+	       (offset == LOSSY_MSS || offset == 3 * LOSSY_MSS);
+}
+
+static void lossy_send_ack(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[4 + 3 * 8] = { NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+				    NET_TCP_SACK_OPT };
+	size_t opts_len = 0;
+	struct net_pkt *reply;
+	size_t cum = 0;
+	int ret;
+
+	while (cum < LOSSY_DATA_LEN && lossy_received[cum]) {
+		cum++;
+	}
+
+	/* Report the ranges received after the first hole */
+	for (size_t i = cum; lossy_sack && i < LOSSY_DATA_LEN; i++) {
+		if (!lossy_received[i] || (i > cum && lossy_received[i - 1])) {
+			continue;
+		}
+
+		if (opts_len == 0) {
+			opts_len = 4;
+		} else if (opts_len == sizeof(opts)) {
+			break;
+		}
+
+		UNALIGNED_PUT(htonl(lossy_data_seq + i),
+			      (uint32_t *)&opts[opts_len]);
+
+		while (i < LOSSY_DATA_LEN && lossy_received[i]) {
+			i++;
+		}
+
+		UNALIGNED_PUT(htonl(lossy_data_seq + i),
+			      (uint32_t *)&opts[opts_len + 4]);
+		opts_len += 8;
+	}
+
+	opts[3] = opts_len - 2;
+	ack = lossy_data_seq + cum;
+
+	reply = tester_prepare_tcp_pkt_ext(net_pkt_family(pkt), htons(MY_PORT),
+					   th->th_sport, ACK, htons(2048),
+					   opts, opts_len, NULL, 0);
+	zassert_not_null(reply, "Cannot create pkt");
+
+	ret = net_recv_data(iface, reply);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	if (cum == LOSSY_DATA_LEN) {
+		test_sem_give();
+	}
+}
+
+static void handle_client_lossy_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[40];
+	size_t opts_len = (th->th_off - 5) * 4;
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct tcphdr) + opts_len;
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	struct net_pkt *reply;
+	size_t offset;
+	int ret;
+
+	if (th->th_flags & SYN) {
+		static const uint8_t syn_ack_opts[] = {
+			NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE,
+			LOSSY_MSS >> 8, LOSSY_MSS & 0xff,
+			NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+			NET_TCP_SACK_PERM_OPT, NET_TCP_SACK_PERM_SIZE,
+		};
+
+		net_pkt_set_overwrite(pkt, true);
+		net_pkt_skip(pkt, hdr_len - opts_len);
+		zassert_ok(net_pkt_read(pkt, opts, opts_len), "No options");
+
+		/* Only answer SACK permitted if it was offered */
+		lossy_sack = false;
+		for (size_t i = 0; i < opts_len && opts[i] != NET_TCP_END_OPT; ) {
+			if (opts[i] == NET_TCP_NOP_OPT) {
+				i++;
+				continue;
+			}
+
+			if (opts[i] == NET_TCP_SACK_PERM_OPT) {
+				lossy_sack = true;
+			}
+
+			zassert_true(opts[i + 1] >= 2, "Invalid option");
+			i += opts[i + 1];
+		}
+
+		zassert_equal(lossy_sack, IS_ENABLED(CONFIG_NET_TCP_SACK),
+			      "SACK permitted option %s",
+			      lossy_sack ? "sent" : "missing");
+
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		lossy_data_seq = ack;
+		lossy_port = th->th_sport;
+
+		reply = tester_prepare_tcp_pkt_ext(
+			net_pkt_family(pkt), htons(MY_PORT), th->th_sport,
+			SYN | ACK, htons(2048), syn_ack_opts,
+			lossy_sack ? sizeof(syn_ack_opts) : NET_TCP_MSS_SIZE,
+			NULL, 0);
+		zassert_not_null(reply, "Cannot create pkt");
+
+		seq++;
+
+		ret = net_recv_data(iface, reply);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+		return;
+	}
+
+	if (len == 0) {
+		if (t_state == T_SYN_ACK) {
+			/* Connected */
+			t_state = T_DATA;
+			test_sem_give();
+		}
+
+		return;
+	}
+
+	offset = ntohl(th->th_seq) - lossy_data_seq;
+	zassert_true(offset + len <= LOSSY_DATA_LEN, "Unexpected data");
+
+	if (offset < lossy_sent_max) {
+		lossy_resent += MIN(len, lossy_sent_max - offset);
+	}
+
+	if (lossy_drop(offset)) {
+		lossy_sent_max = MAX(lossy_sent_max, offset + len);
+		return;
+	}
+
+	lossy_sent_max = MAX(lossy_sent_max, offset + len);
+	memset(&lossy_received[offset], true, len);
+
+	lossy_send_ack(pkt, th);
+}
+
+/* Test case scenario IPv4
+ *   send SYN with SACK permitted,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send five segments of data, of which the second and the fourth get
+ *   lost, so two duplicate ACKs come back: not enough for a fast
+ *   retransmit,
+ *   resend after the retransmission timeout until all data is acked.
+ * Without SACK, everything after the first lost segment is sent again.
+ * With SACK, only the two lost segments are.
+ */
+ZTEST(net_tcp, test_client_lossy_retransmit)
+{
+	size_t expected_resent = IS_ENABLED(CONFIG_NET_TCP_SACK) ?
+				 2 * LOSSY_MSS : 3 * LOSSY_MSS;
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	int ret;
+
+	t_state = T_SYN_ACK;
+	test_case_no = 10;
+	seq = ack = 0;
+	lossy_sent_max = 0;
+	lossy_resent = 0;
+	memset(lossy_received, 0, sizeof(lossy_received));
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_send(ctx, lorem_ipsum, LOSSY_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer");
+
+	/* Peer will release the semaphore after all the data is acked */
+	test_sem_take(K_MSEC(2000), __LINE__);
+
+	zassert_equal(lossy_resent, expected_resent,
+		      "%zu bytes resent, expected %zu", lossy_resent,
+		      expected_resent);
+
+	/* Abort the connection with a RST, so that the test does not need
+	 * to implement the closing handshake.
+	 */
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), lossy_port);
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
+#define GSO_MSS 64
+#define GSO_DATA_LEN (4 * GSO_MSS + 20)
+
+static uint32_t gso_data_seq;
+static size_t gso_received;
+static uint16_t gso_port;
+
+/* Every segment must fit in the MSS, follow the previous one and carry
+ * valid lengths and checksums.
+ */
+static void gso_check_segment(struct net_pkt *pkt, struct tcphdr *th,
+			      size_t hdr_len, size_t len)
+{
+	size_t offset = ntohl(th->th_seq) - gso_data_seq;
+	uint8_t data[GSO_MSS];
+
+	zassert_true(len <= GSO_MSS, "Segment of %zu bytes", len);
+	zassert_equal(offset, gso_received, "Segment at %zu, expected %zu",
+		      offset, gso_received);
+
+	zassert_equal(net_calc_chksum_tcp(pkt), 0, "Invalid TCP checksum");
+
+	if (net_pkt_family(pkt) == AF_INET) {
+		zassert_equal(net_calc_chksum_ipv4(pkt), 0,
+			      "Invalid IPv4 checksum");
+		zassert_equal(ntohs(NET_IPV4_HDR(pkt)->len),
+			      net_pkt_get_len(pkt), "Invalid IPv4 length");
+	} else {
+		zassert_equal(ntohs(NET_IPV6_HDR(pkt)->len) + NET_IPV6H_LEN,
+			      net_pkt_get_len(pkt), "Invalid IPv6 length");
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, hdr_len);
+	zassert_ok(net_pkt_read(pkt, data, len), "Cannot read data");
+	zassert_mem_equal(data, lorem_ipsum + offset, len, "Invalid data");
+
+	/* Only the last segment cut from a large packet keeps PSH */
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && offset < 3 * GSO_MSS) {
+		zassert_false(th->th_flags & PSH, "PSH in segment at %zu",
+			      offset);
+	}
+
+	gso_received += len;
+}
+
+static void handle_gso_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 th->th_off * 4;
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	struct net_pkt *reply;
+	int ret;
+
+	if (th->th_flags & SYN) {
+		static const uint8_t syn_ack_opts[] = {
+			NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE,
+			GSO_MSS >> 8, GSO_MSS & 0xff,
+		};
+
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		gso_data_seq = ack;
+		gso_port = th->th_sport;
+
+		reply = tester_prepare_tcp_pkt_ext(
+			net_pkt_family(pkt), htons(MY_PORT), th->th_sport,
+			SYN | ACK, htons(2048), syn_ack_opts,
+			sizeof(syn_ack_opts), NULL, 0);
+		zassert_not_null(reply, "Cannot create pkt");
+
+		seq++;
+
+		ret = net_recv_data(iface, reply);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+		return;
+	}
+
+	if (len == 0) {
+		if (t_state == T_SYN_ACK) {
+			/* Connected */
+			t_state = T_DATA;
+			test_sem_give();
+		}
+
+		return;
+	}
+
+	gso_check_segment(pkt, th, hdr_len, len);
+
+	if (test_case_no == 11) {
+		ack = gso_data_seq + gso_received;
+
+		reply = prepare_ack_packet(net_pkt_family(pkt), htons(MY_PORT),
+					   th->th_sport);
+		zassert_not_null(reply, "Cannot create pkt");
+
+		ret = net_recv_data(iface, reply);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+	}
+
+	if (gso_received == GSO_DATA_LEN) {
+		test_sem_give();
+	}
+}
+
+/* Test case scenario IPv4
+ *   send SYN with an MSS of 64,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send four segments and a partial one, acking each segment.
+ * With segmentation offload the first four go down the stack as one
+ * large packet, which is cut before reaching the test interface. The
+ * partial segment follows once they are acked, as Nagle's algorithm
+ * holds it back.
+ */
+ZTEST(net_tcp, test_client_gso_ipv4)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	int ret;
+
+	t_state = T_SYN_ACK;
+	test_case_no = 11;
+	seq = ack = 0;
+	gso_received = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_send(ctx, lorem_ipsum, GSO_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer");
+
+	/* Peer will release the semaphore after it got all the data */
+	test_sem_take(K_MSEC(1000), __LINE__);
+
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), gso_port);
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
+/* A large IPv6 packet whose payload buffers do not match the segment
+ * boundaries is cut by copying the data.
+ */
+ZTEST(net_tcp, test_gso_unaligned_ipv6)
+{
+	struct tcphdr th = {
+		.th_sport = htons(MY_PORT),
+		.th_dport = htons(PEER_PORT),
+		.th_seq = htonl(1000U),
+		.th_off = 5,
+		.th_flags = PSH | ACK,
+		.th_win = htons(2048),
+	};
+	struct net_pkt *pkt;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_GSO)) {
+		ztest_test_skip();
+	}
+
+	test_case_no = 12;
+	gso_data_seq = 1000U;
+	gso_received = 0;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(th) + GSO_DATA_LEN,
+					AF_INET6, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	ret = net_ipv6_create(pkt, &my_addr_v6, &peer_addr_v6);
+	zassert_ok(ret, "Cannot create IPv6 header");
+
+	ret = net_pkt_write(pkt, &th, sizeof(th));
+	zassert_ok(ret, "Cannot write TCP header");
+
+	ret = net_pkt_write(pkt, lorem_ipsum, GSO_DATA_LEN);
+	zassert_ok(ret, "Cannot write data");
+
+	net_pkt_set_gso_size(pkt, GSO_MSS);
+	net_pkt_cursor_init(pkt);
+
+	ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	zassert_ok(ret, "Cannot finalize pkt");
+
+	ret = net_send_data(pkt);
+	zassert_ok(ret, "Cannot send pkt");
+
+	test_sem_take(K_MSEC(1000), __LINE__);
+}
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+#define CC_MSS 64
+/* Fits in the initial window of ten segments, RFC 6928 */
+#define CC_DATA_LEN (8 * CC_MSS)
+/* CUBIC multiplicative decrease, 0.7 in units of 1/1024 */
+#define CC_CUBIC_BETA 717
+
+enum cc_loss {
+	CC_LOSS_NONE,
+	/* The second segment is lost and the rest produce duplicate ACKs */
+	CC_LOSS_DUP_ACK,
+	/* Everything after the first segment is lost, until the timeout */
+	CC_LOSS_RTO,
+};
+
+static enum cc_loss cc_loss;
+static struct tcp *cc_conn;
+static uint32_t cc_data_seq;
+static size_t cc_sent_max;
+static uint16_t cc_port;
+static bool cc_received[CC_DATA_LEN];
+static bool cc_resent;
+/* Sender state when the first segment is sent again */
+static uint32_t cc_resend_cwnd;
+static uint32_t cc_resend_ssthresh;
+static bool cc_resend_in_recovery;
+
+static bool cc_drop(size_t offset)
+{
+	switch (cc_loss) {
+	case CC_LOSS_DUP_ACK:
+		return offset == CC_MSS;
+	case CC_LOSS_RTO:
+		return offset >= CC_MSS;
+	default:
+		return false;
+	}
+}
+
+static void handle_congestion_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	static const uint8_t syn_ack_opts[] = {
+		NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE, CC_MSS >> 8, CC_MSS & 0xff,
+	};
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 th->th_off * 4U;
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	struct net_pkt *reply;
+	size_t offset;
+	size_t cum = 0;
+	int ret;
+
+	if (th->th_flags & SYN) {
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		cc_data_seq = ack;
+		cc_port = th->th_sport;
+
+		reply = tester_prepare_tcp_pkt_ext(
+			net_pkt_family(pkt), htons(MY_PORT), th->th_sport,
+			SYN | ACK, htons(2048), syn_ack_opts,
+			sizeof(syn_ack_opts), NULL, 0);
+		zassert_not_null(reply, "Cannot create pkt");
+
+		seq++;
+
+		ret = net_recv_data(iface, reply);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+		return;
+	}
+
+	if (len == 0) {
+		if (t_state == T_SYN_ACK) {
+			/* Connected */
+			t_state = T_DATA;
+			test_sem_give();
+		}
+
+		return;
+	}
+
+	offset = ntohl(th->th_seq) - cc_data_seq;
+	zassert_true(offset + len <= CC_DATA_LEN, "Unexpected data");
+
+	if (offset < cc_sent_max && !cc_resent) {
+		cc_resent = true;
+		cc_resend_cwnd = cc_conn->cwnd;
+		cc_resend_ssthresh = cc_conn->ssthresh;
+		cc_resend_in_recovery = cc_conn->in_recovery;
+	}
+
+	if (offset >= cc_sent_max && cc_drop(offset)) {
+		cc_sent_max = offset + len;
+		return;
+	}
+
+	cc_sent_max = MAX(cc_sent_max, offset + len);
+	memset(&cc_received[offset], true, len);
+
+	while (cum < CC_DATA_LEN && cc_received[cum]) {
+		cum++;
+	}
+
+	ack = cc_data_seq + cum;
+
+	reply = tester_prepare_tcp_pkt_ext(net_pkt_family(pkt), htons(MY_PORT),
+					   th->th_sport, ACK, htons(2048),
+					   NULL, 0, NULL, 0);
+	zassert_not_null(reply, "Cannot create pkt");
+
+	ret = net_recv_data(iface, reply);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	if (cum == CC_DATA_LEN) {
+		test_sem_give();
+	}
+}
+
+/* ssthresh the algorithm sets on a loss with the given window and
+ * amount of data in flight.
+ */
+static uint32_t cc_loss_ssthresh(const char *algo, uint32_t cwnd,
+				 uint32_t flight)
+{
+	if (strcmp(algo, "cubic") == 0) {
+		return MAX(cwnd * CC_CUBIC_BETA / 1024, 2U * CC_MSS);
+	}
+
+	return MAX(flight / 2U, 2U * CC_MSS);
+}
+
+/* Sends eight segments over a connection using @a algo, with the given
+ * losses. With @a avoid, the connection starts in congestion avoidance
+ * instead of slow start. Returns the initial congestion window, the
+ * connection is left in cc_conn until cc_close().
+ */
+static uint32_t cc_send(struct net_context **ctx, const char *algo,
+			enum cc_loss loss, bool avoid)
+{
+	uint32_t cwnd;
+	int ret;
+
+	t_state = T_SYN_ACK;
+	test_case_no = 13;
+	seq = ack = 0;
+	cc_loss = loss;
+	cc_sent_max = 0;
+	cc_resent = false;
+	memset(cc_received, 0, sizeof(cc_received));
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_tcp_set_option(*ctx, TCP_OPT_CONGESTION, algo, strlen(algo));
+	zassert_equal(ret, 0, "Cannot select %s", algo);
+
+	cc_conn = (*ctx)->tcp;
+
+	ret = net_context_connect(*ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_mutex_lock(&cc_conn->lock, K_FOREVER);
+	cwnd = cc_conn->cwnd;
+	zassert_equal(cwnd, 10U * CC_MSS, "Unexpected initial window %u", cwnd);
+	if (avoid) {
+		/* Small enough that the data acks a window and a half */
+		cwnd = CC_DATA_LEN / 2U;
+		cc_conn->cwnd = cwnd;
+		cc_conn->ssthresh = cwnd;
+	}
+	k_mutex_unlock(&cc_conn->lock);
+
+	ret = net_context_send(*ctx, lorem_ipsum, CC_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, CC_DATA_LEN, "Failed to send data to peer");
+
+	/* Peer will release the semaphore after all the data is acked */
+	test_sem_take(K_MSEC(2000), __LINE__);
+
+	/* Let the receiving thread process the last ACK */
+	k_msleep(50);
+
+	return cwnd;
+}
+
+static void cc_close(struct net_context *ctx)
+{
+	struct net_pkt *rst;
+	int ret;
+
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), cc_port);
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
+/* In slow start every ACK grows the window by the data it acknowledges,
+ * in congestion avoidance the window grows by less.
+ */
+static void cc_check_growth(const char *algo)
+{
+	struct net_context *ctx;
+	uint32_t cwnd;
+
+	cwnd = cc_send(&ctx, algo, CC_LOSS_NONE, false);
+	zassert_equal(cc_conn->cwnd, cwnd + CC_DATA_LEN,
+		      "%s: slow start cwnd %u, expected %u", algo,
+		      cc_conn->cwnd, cwnd + CC_DATA_LEN);
+	cc_close(ctx);
+
+	cwnd = cc_send(&ctx, algo, CC_LOSS_NONE, true);
+	if (strcmp(algo, "newreno") == 0) {
+		/* One segment per window of acknowledged data */
+		zassert_equal(cc_conn->cwnd, cwnd + CC_MSS,
+			      "newreno: cwnd %u, expected %u",
+			      cc_conn->cwnd, cwnd + CC_MSS);
+	} else {
+		/* At most half as fast as slow start */
+		zassert_true(cc_conn->cwnd > cwnd &&
+			     cc_conn->cwnd <= cwnd + CC_DATA_LEN / 2U,
+			     "%s: cwnd %u after %u, started at %u", algo,
+			     cc_conn->cwnd, CC_DATA_LEN, cwnd);
+	}
+	cc_close(ctx);
+}
+
+/* Three duplicate ACKs start fast recovery with a reduced window, which
+ * ends deflated to at most ssthresh once the lost segment is acked.
+ */
+static void cc_check_dup_ack(const char *algo)
+{
+	struct net_context *ctx;
+	uint32_t ssthresh;
+	uint32_t cwnd;
+
+	cwnd = cc_send(&ctx, algo, CC_LOSS_DUP_ACK, false);
+
+	/* The first segment was acked in slow start before the loss */
+	ssthresh = cc_loss_ssthresh(algo, cwnd + CC_MSS, CC_DATA_LEN - CC_MSS);
+
+	zassert_true(cc_resent, "%s: lost segment not resent", algo);
+	zassert_true(cc_resend_in_recovery, "%s: not in fast recovery", algo);
+	zassert_equal(cc_resend_ssthresh, ssthresh,
+		      "%s: ssthresh %u, expected %u", algo,
+		      cc_resend_ssthresh, ssthresh);
+	zassert_true(cc_resend_cwnd >= ssthresh + 3U * CC_MSS,
+		     "%s: cwnd %u in fast recovery", algo, cc_resend_cwnd);
+	zassert_false(cc_conn->in_recovery, "%s: fast recovery not left", algo);
+	zassert_true(cc_conn->cwnd <= ssthresh, "%s: cwnd %u after recovery",
+		     algo, cc_conn->cwnd);
+	cc_close(ctx);
+}
+
+/* A retransmission timeout lowers ssthresh the same way and restarts
+ * slow start from a single segment.
+ */
+static void cc_check_rto(const char *algo)
+{
+	struct net_context *ctx;
+	uint32_t ssthresh;
+	uint32_t cwnd;
+
+	cwnd = cc_send(&ctx, algo, CC_LOSS_RTO, false);
+	ssthresh = cc_loss_ssthresh(algo, cwnd + CC_MSS, CC_DATA_LEN - CC_MSS);
+
+	zassert_true(cc_resent, "%s: lost segments not resent", algo);
+	zassert_false(cc_resend_in_recovery, "%s: fast recovery on RTO", algo);
+	zassert_equal(cc_resend_cwnd, CC_MSS, "%s: cwnd %u after RTO", algo,
+		      cc_resend_cwnd);
+	zassert_equal(cc_resend_ssthresh, ssthresh,
+		      "%s: ssthresh %u, expected %u", algo,
+		      cc_resend_ssthresh, ssthresh);
+	zassert_true(cc_conn->cwnd < cwnd + CC_MSS,
+		     "%s: cwnd %u after the lost data was acked", algo,
+		     cc_conn->cwnd);
+	cc_close(ctx);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+/* Test case scenario IPv4
+ *   send SYN with an MSS of 64,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send eight segments, acking each one received, with NewReno:
+ *   - without loss, in slow start and in congestion avoidance,
+ *   - with the second segment lost, so that the others produce
+ *     duplicate ACKs,
+ *   - with all but the first segment lost, until they time out.
+ * Check the congestion window and ssthresh after each.
+ */
+ZTEST(net_tcp, test_congestion_newreno)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	cc_check_growth("newreno");
+	cc_check_dup_ack("newreno");
+	cc_check_rto("newreno");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* As above, with CUBIC */
+ZTEST(net_tcp, test_congestion_cubic)
+{
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+	cc_check_growth("cubic");
+	cc_check_dup_ack("cubic");
+	cc_check_rto("cubic");
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
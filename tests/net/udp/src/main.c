@@ -433,7 +433,7 @@ ZTEST(udp_fn_tests, test_udp)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface;
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *ud2;
 	int ret, i = 0;
 	bool st;
 
@@ -628,6 +628,15 @@ ZTEST(udp_fn_tests, test_udp)
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4242);
 	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1234, 4243);
 
+	/* Connected handlers sharing the local port get their own peer's
+	 * packets, whichever was registered last.
+	 */
+	ud2 = ud;
+	ud = REGISTER(AF_INET, &peer_addr4, &my_addr4, 1235, 4242);
+	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1235, 4242);
+	TEST_IPV4_OK(ud2, &in4addr_peer, &in4addr_my, 1234, 4242);
+	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1236, 4242);
+
 	ud = REGISTER(AF_UNSPEC, NULL, NULL, 1234, 42423);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 42423);
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 42423);
@@ -923,4 +923,59 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+static uint16_t chksum_field(const uint8_t *data, size_t len)
+{
+	uint16_t sum = calc_chksum(0, data, len);
+
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	uint8_t old_data[16];
+	uint16_t chksum;
+	uint16_t old_val;
+
+	for (int i = 0; i < 64; i++) {
+		testdata[i] = (uint8_t)(i * 37 + 5);
+	}
+
+	chksum = chksum_field(testdata, 64);
+
+	for (int i = 0; i < 256; i++) {
+		/* A 16-bit field, like the IPv4 total length */
+		memcpy(&old_val, &testdata[2], sizeof(old_val));
+		testdata[2] = (uint8_t)i;
+		testdata[3] = (uint8_t)(i * 7);
+		chksum = net_chksum_update(chksum, &old_val, &testdata[2],
+					   sizeof(old_val));
+
+		zassert_equal(chksum, chksum_field(testdata, 64),
+			      "Mismatch after updating a 16-bit field\n");
+
+		/* An address at an odd 16-bit word */
+		memcpy(old_data, &testdata[22], sizeof(old_data));
+		for (int j = 0; j < sizeof(old_data); j++) {
+			testdata[22 + j] = (uint8_t)(i + j * 29);
+		}
+
+		chksum = net_chksum_update(chksum, old_data, &testdata[22],
+					   sizeof(old_data));
+
+		zassert_equal(chksum, chksum_field(testdata, 64),
+			      "Mismatch after updating an address\n");
+	}
+
+	/* Zeroing all of the data yields the checksum of all zeroes */
+	memcpy(old_data, testdata, sizeof(old_data));
+	memset(testdata, 0, sizeof(old_data));
+	chksum = net_chksum_update(chksum_field(old_data, sizeof(old_data)),
+				   old_data, testdata, sizeof(old_data));
+
+	zassert_equal(chksum, chksum_field(testdata, sizeof(old_data)),
+		      "Mismatch after zeroing the data\n");
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
@@ -869,3 +869,252 @@ ZTEST_F(nvs, test_nvs_cache_gc)
 	zassert_equal(num, 2, "invalid cache content after gc");
 #endif
 }
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+#define GC_INCR_MAX_ID 10
+
+/* Write the next value of each id, the value is the write number */
+static void gc_incr_write(struct nvs_fs *fs, uint32_t *writes)
+{
+	ssize_t len;
+
+	for (uint16_t id = 0; id < GC_INCR_MAX_ID; id++, (*writes)++) {
+		len = nvs_write(fs, id, writes, sizeof(*writes));
+		zassert_equal(len, sizeof(*writes), "nvs_write failed: %d", len);
+	}
+}
+
+static void gc_incr_check(struct nvs_fs *fs, uint32_t writes)
+{
+	uint32_t data;
+	ssize_t len;
+
+	for (uint16_t id = 0; id < GC_INCR_MAX_ID; id++) {
+		len = nvs_read(fs, id, &data, sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_read failed: %d", len);
+		zassert_equal(data, writes - GC_INCR_MAX_ID + id,
+			      "incorrect data read");
+	}
+}
+
+static void gc_steps(struct nvs_fs *fs)
+{
+	int err;
+
+	do {
+		err = nvs_gc_step(fs);
+	} while (err > 0);
+
+	zassert_equal(err, 0, "nvs_gc_step call failure: %d", err);
+}
+
+/* Rewrite the ids many times, running the incremental gc after each write
+ * if gc is set. Returns the worst-case write latency.
+ */
+static uint32_t write_worst_case_us(struct nvs_fixture *fixture, bool gc,
+				    uint32_t *write_erases)
+{
+	uint32_t *flash_erase_stat;
+	uint32_t worst = 0U;
+	uint32_t writes = 0U;
+	ssize_t len;
+	int err;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find,
+		   &flash_erase_stat);
+	*write_erases = 0U;
+
+	while (writes < 1000U) {
+		uint32_t erases = *flash_erase_stat;
+		uint32_t start = k_cycle_get_32();
+
+		len = nvs_write(&fixture->fs, writes % GC_INCR_MAX_ID, &writes,
+				sizeof(writes));
+		zassert_equal(len, sizeof(writes), "nvs_write failed: %d", len);
+
+		worst = MAX(worst, k_cycle_get_32() - start);
+		*write_erases += *flash_erase_stat - erases;
+		writes++;
+
+		if (gc) {
+			gc_steps(&fixture->fs);
+		}
+	}
+
+	gc_incr_check(&fixture->fs, writes);
+
+	return k_cyc_to_us_ceil32(worst);
+}
+#endif
+
+/*
+ * Test that nvs_write() does not erase sectors when the incremental gc runs
+ * between writes, and report the worst-case write latency with and without it.
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	uint32_t fg_us, incr_us, fg_erases, incr_erases;
+	int err;
+
+	fg_us = write_worst_case_us(fixture, false, &fg_erases);
+
+	err = nvs_clear(&fixture->fs);
+	zassert_true(err == 0, "nvs_clear call failure: %d", err);
+
+	incr_us = write_worst_case_us(fixture, true, &incr_erases);
+
+	TC_PRINT("worst-case nvs_write: %u us with gc in nvs_write(), "
+		 "%u us with incremental gc\n", fg_us, incr_us);
+
+	zassert_not_equal(fg_erases, 0, "nvs_write() did not gc");
+	zassert_equal(incr_erases, 0, "nvs_write() erased %u sectors",
+		      incr_erases);
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	zassert_true(incr_us < fg_us, "worst-case latency not reduced");
+#endif
+#endif
+}
+
+/*
+ * Test writing and remounting while the incremental gc moves entries
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental_interrupted)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	uint32_t write_sector;
+	uint32_t writes = 0U;
+	int err;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Write until a gc has entries to move */
+	do {
+		gc_incr_write(&fixture->fs, &writes);
+
+		err = nvs_gc_step(&fixture->fs);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+		if (fixture->fs.gc_state == NVS_GC_ERASE) {
+			gc_steps(&fixture->fs);
+		}
+	} while (fixture->fs.gc_state != NVS_GC_MOVE);
+
+	/* A write moves the remaining entries first */
+	gc_incr_write(&fixture->fs, &writes);
+	zassert_equal(fixture->fs.gc_state, NVS_GC_ERASE,
+		      "write did not finish moving entries");
+	gc_incr_check(&fixture->fs, writes);
+
+	/* Power loss before the erase: the gc done ate is found on mount */
+	write_sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, write_sector,
+		      "unexpected write sector");
+	gc_incr_check(&fixture->fs, writes);
+
+	/* Power loss while moving entries: gc is restarted on mount */
+	do {
+		gc_incr_write(&fixture->fs, &writes);
+
+		err = nvs_gc_step(&fixture->fs);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	} while (fixture->fs.gc_state != NVS_GC_MOVE);
+
+	err = nvs_gc_step(&fixture->fs);
+	zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	zassert_equal(fixture->fs.gc_state, NVS_GC_MOVE,
+		      "entries moved in a single step");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	gc_incr_check(&fixture->fs, writes);
+
+	gc_incr_write(&fixture->fs, &writes);
+	gc_incr_check(&fixture->fs, writes);
+#endif
+}
+
+#define FOREACH_MAX_ID 8
+
+struct foreach_found {
+	struct nvs_entry latest[FOREACH_MAX_ID];
+	int count;
+};
+
+static int foreach_cb(struct nvs_fs *fs, const struct nvs_entry *entry,
+		      void *arg)
+{
+	struct foreach_found *found = arg;
+
+	zassert_true(entry->id < FOREACH_MAX_ID, "unexpected id %u", entry->id);
+
+	if (found->latest[entry->id].len == 0U &&
+	    found->latest[entry->id].ate_addr == 0U) {
+		found->latest[entry->id] = *entry;
+	}
+	found->count++;
+
+	return 0;
+}
+
+/*
+ * Test that nvs_foreach() finds the most recent entry of each id first and
+ * that nvs_entry_read() still reads it after a gc moved it.
+ */
+ZTEST_F(nvs, test_nvs_foreach)
+{
+	struct foreach_found found;
+	uint32_t data;
+	ssize_t len;
+	int err;
+
+	fixture->fs.sector_count = 2;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Three versions of each id, then delete id 0 */
+	for (data = 0; data < 3 * FOREACH_MAX_ID; data++) {
+		len = nvs_write(&fixture->fs, data % FOREACH_MAX_ID, &data,
+				sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_write failed: %d", len);
+	}
+
+	err = nvs_delete(&fixture->fs, 0);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+
+	memset(&found, 0, sizeof(found));
+	err = nvs_foreach(&fixture->fs, foreach_cb, &found);
+	zassert_true(err == 0, "nvs_foreach call failure: %d", err);
+	zassert_equal(found.count, 3 * FOREACH_MAX_ID + 1,
+		      "unexpected number of entries");
+	zassert_equal(found.latest[0].len, 0, "deleted entry not found first");
+
+	for (uint16_t id = 1; id < FOREACH_MAX_ID; id++) {
+		len = nvs_entry_read(&fixture->fs, &found.latest[id], &data,
+				     sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_entry_read failed: %d", len);
+		zassert_equal(data, 2 * FOREACH_MAX_ID + id, "not the latest entry");
+	}
+
+	/* Rewrite id 1 until its entries were gc'ed */
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 0U) {
+		len = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_write failed: %d", len);
+		data++;
+	}
+
+	for (uint16_t id = 2; id < FOREACH_MAX_ID; id++) {
+		len = nvs_entry_read(&fixture->fs, &found.latest[id], &data,
+				     sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_entry_read failed: %d", len);
+		zassert_equal(data, 2 * FOREACH_MAX_ID + id,
+			      "moved entry not read");
+	}
+}
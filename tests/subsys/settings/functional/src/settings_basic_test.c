@@ -228,14 +228,6 @@ static struct settings_handler val3_settings = {
 	.h_commit = val3_commit,
 };
 
-/* helper routine to remove a handler from settings */
-int settings_deregister(struct settings_handler *handler)
-{
-	extern sys_slist_t settings_handlers;
-
-	return sys_slist_find_and_remove(&settings_handlers, &handler->node);
-}
-
 ZTEST(settings_functional, test_register_and_loading)
 {
 	int rc, err;
@@ -356,6 +348,83 @@ ZTEST(settings_functional, test_register_and_loading)
 	zassert_true(rc, "deregistering val3_settings failed");
 }
 
+static struct settings_handler val4_settings = {
+	.name = "ps/s",
+	.h_set = val1_set,
+};
+
+static struct settings_handler val5_settings = {
+	.name = "psx",
+	.h_set = val1_set,
+};
+
+static void check_lookup(const char *name, struct settings_handler *handler,
+			 const char *next)
+{
+	struct settings_handler_static *found;
+	const char *found_next;
+
+	found = settings_parse_and_lookup(name, &found_next);
+	zassert_equal_ptr(found, (struct settings_handler_static *)handler,
+			  "wrong handler found for %s", name);
+
+	if (next) {
+		zassert_not_null(found_next, "no next for %s", name);
+		zassert_true(strcmp(found_next, next) == 0,
+			     "wrong next for %s", name);
+	} else {
+		zassert_is_null(found_next, "wrong next for %s", name);
+	}
+}
+
+ZTEST(settings_functional, test_handler_lookup)
+{
+	int rc;
+
+	rc = settings_subsys_init();
+	zassert_true(rc == 0, "subsys init failed");
+
+	zassert_ok(settings_register(&val1_settings), "register failed");
+	zassert_ok(settings_register(&val2_settings), "register failed");
+	zassert_ok(settings_register(&val3_settings), "register failed");
+	zassert_ok(settings_register(&val4_settings), "register failed");
+	zassert_ok(settings_register(&val5_settings), "register failed");
+
+	/* The handler with the longest name matching whole name parts */
+	check_lookup("ps", &val1_settings, NULL);
+	check_lookup("ps=", &val1_settings, NULL);
+	check_lookup("ps/val1", &val1_settings, "val1");
+	check_lookup("ps/sss", &val1_settings, "sss");
+	check_lookup("ps/s/val4", &val4_settings, "val4");
+	check_lookup("ps/ss", &val3_settings, NULL);
+	check_lookup("ps/ss/val3", &val3_settings, "val3");
+	check_lookup("ps/ss/ss/val2", &val2_settings, "val2");
+	check_lookup("psx=", &val5_settings, NULL);
+	check_lookup("psy", NULL, NULL);
+	check_lookup("p", NULL, NULL);
+	check_lookup("", NULL, NULL);
+
+	zassert_true(settings_deregister(&val3_settings),
+		     "deregistering val3_settings failed");
+	zassert_false(settings_deregister(&val3_settings),
+		      "val3_settings deregistered twice");
+
+	check_lookup("ps/ss/val3", &val1_settings, "ss/val3");
+	check_lookup("ps/ss/ss/val2", &val2_settings, "val2");
+	check_lookup("ps/s/val4", &val4_settings, "val4");
+
+	zassert_true(settings_deregister(&val1_settings),
+		     "deregistering val1_settings failed");
+	zassert_true(settings_deregister(&val2_settings),
+		     "deregistering val2_settings failed");
+	zassert_true(settings_deregister(&val4_settings),
+		     "deregistering val4_settings failed");
+	zassert_true(settings_deregister(&val5_settings),
+		     "deregistering val5_settings failed");
+
+	check_lookup("ps/s/val4", NULL, NULL);
+}
+
 int val123_set(const char *key, size_t len,
 	       settings_read_cb read_cb, void *cb_arg)
 {
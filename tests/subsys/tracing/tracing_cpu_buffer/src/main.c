@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <tracing_buffer.h>
+
+/* Timestamp and length put before each packet in the buffer of a CPU */
+#define RECORD_HEADER_SIZE 8
+
+/* Not a multiple of anything, so that packets straddle the buffer ends */
+#define RECORD_SIZE 13
+
+#define NUM_PRODUCERS 4
+#define PRODUCER_RECORDS 100
+#define PRODUCER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+BUILD_ASSERT(CONFIG_TRACING_BUFFER_SIZE + RECORD_HEADER_SIZE <
+	     CONFIG_TRACING_PER_CPU_BUFFER_SIZE,
+	     "A packet too large for the tracing buffer must fit a CPU buffer");
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, NUM_PRODUCERS,
+				   PRODUCER_STACK_SIZE);
+static struct k_thread producer_threads[NUM_PRODUCERS];
+static struct k_sem producer_turns[NUM_PRODUCERS];
+static K_SEM_DEFINE(producer_done, 0, NUM_PRODUCERS);
+
+static uint8_t big_record[CONFIG_TRACING_BUFFER_SIZE + 2];
+
+/* A packet is made of its producer, its sequence number and a pattern
+ * depending on both.
+ */
+static uint8_t record_byte(uint8_t id, uint16_t seq, uint32_t i)
+{
+	return (uint8_t)(id * 31U + seq * 7U + i);
+}
+
+static bool record_put(uint8_t id, uint16_t seq, uint8_t *rec, uint32_t size)
+{
+	bool before_put_is_empty;
+	tracing_data_t data[2];
+
+	rec[0] = id;
+	sys_put_le16(seq, &rec[1]);
+	for (uint32_t i = 3U; i < size; i++) {
+		rec[i] = record_byte(id, seq, i);
+	}
+
+	/* Put as two pieces, as the tracing formats do */
+	data[0].data = rec;
+	data[0].length = 3U;
+	data[1].data = &rec[3];
+	data[1].length = size - 3U;
+
+	return tracing_cpu_buffer_put(data, ARRAY_SIZE(data),
+				      &before_put_is_empty);
+}
+
+static void record_check(const uint8_t *rec, uint32_t size, uint8_t id,
+			 uint16_t seq)
+{
+	zassert_equal(rec[0], id, "packet of %u instead of %u", rec[0], id);
+	zassert_equal(sys_get_le16(&rec[1]), seq, "packet %u instead of %u",
+		      sys_get_le16(&rec[1]), seq);
+
+	for (uint32_t i = 3U; i < size; i++) {
+		zassert_equal(rec[i], record_byte(id, seq, i),
+			      "packet %u corrupted at %u", seq, i);
+	}
+}
+
+/* Reads a packet from the tracing buffer, which may wrap in it */
+static uint32_t record_get(uint8_t *rec, uint32_t size)
+{
+	uint32_t length = 0U;
+	uint32_t got;
+
+	do {
+		got = tracing_buffer_get(&rec[length], size - length);
+		length += got;
+	} while ((got > 0U) && (length < size));
+
+	return length;
+}
+
+static uint32_t drops_total(void)
+{
+	uint32_t drops = 0U;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		drops += tracing_cpu_buffer_drops_get(cpu);
+	}
+
+	return drops;
+}
+
+static void *tracing_cpu_buffer_setup(void)
+{
+	/* Let the tracing thread run its first merge and wait for an output
+	 * trigger, which never comes as tracing is disabled: the test does
+	 * the merges from now on.
+	 */
+	k_sleep(K_MSEC(10));
+
+	return NULL;
+}
+
+static void tracing_cpu_buffer_before(void *fixture)
+{
+	uint8_t *data;
+	uint32_t length;
+
+	ARG_UNUSED(fixture);
+
+	do {
+		tracing_cpu_buffer_merge();
+		length = tracing_buffer_get_claim(&data,
+						  tracing_buffer_capacity_get());
+		tracing_buffer_get_finish(length);
+	} while (length > 0U);
+}
+
+ZTEST(tracing_cpu_buffer, test_put_merge_wraparound)
+{
+	uint8_t rec[RECORD_SIZE];
+	uint32_t drops = drops_total();
+	uint16_t seq;
+
+	/* Stay on one CPU, so that the packets keep their order */
+	k_sched_lock();
+
+	/* Both the buffer of the CPU and the tracing buffer wrap several
+	 * times over, in the middle of packets.
+	 */
+	for (seq = 0U; seq < 64U; seq++) {
+		zassert_true(record_put(0, seq, rec, sizeof(rec)), "put failed");
+
+		if ((seq % 3U) != 2U) {
+			continue;
+		}
+
+		tracing_cpu_buffer_merge();
+
+		for (uint16_t i = seq - 2U; i <= seq; i++) {
+			zassert_equal(record_get(rec, sizeof(rec)), sizeof(rec),
+				      "packet %u missing", i);
+			record_check(rec, sizeof(rec), 0, i);
+		}
+
+		zassert_true(tracing_buffer_is_empty(), "");
+	}
+
+	k_sched_unlock();
+
+	zassert_equal(drops_total(), drops, "");
+}
+
+ZTEST(tracing_cpu_buffer, test_drops)
+{
+	uint8_t rec[RECORD_SIZE];
+	uint32_t fit = CONFIG_TRACING_PER_CPU_BUFFER_SIZE /
+		       (RECORD_HEADER_SIZE + RECORD_SIZE);
+	uint32_t drops;
+	unsigned int cpu;
+	uint16_t seq;
+
+	k_sched_lock();
+
+	cpu = _current_cpu->id;
+	drops = tracing_cpu_buffer_drops_get(cpu);
+
+	for (seq = 0U; seq < fit; seq++) {
+		zassert_true(record_put(0, seq, rec, sizeof(rec)), "put failed");
+	}
+
+	/* The buffer of the CPU is full */
+	zassert_false(record_put(0, seq, rec, sizeof(rec)), "");
+	zassert_false(record_put(0, seq, rec, sizeof(rec)), "");
+	zassert_equal(tracing_cpu_buffer_drops_get(cpu), drops + 2U, "");
+
+	/* The tracing buffer takes fewer packets, each merge moves what fits
+	 * and leaves the rest.
+	 */
+	zassert_true(fit * RECORD_SIZE > tracing_buffer_capacity_get(), "");
+
+	for (seq = 0U; seq < fit; seq++) {
+		tracing_cpu_buffer_merge();
+		zassert_equal(record_get(rec, sizeof(rec)), sizeof(rec),
+			      "packet %u missing", seq);
+		record_check(rec, sizeof(rec), 0, seq);
+	}
+
+	tracing_cpu_buffer_merge();
+	zassert_true(tracing_buffer_is_empty(), "");
+
+	/* Room again */
+	zassert_true(record_put(0, seq, rec, sizeof(rec)), "put failed");
+	tracing_cpu_buffer_merge();
+	zassert_equal(record_get(rec, sizeof(rec)), sizeof(rec), "");
+	record_check(rec, sizeof(rec), 0, seq);
+
+	zassert_equal(tracing_cpu_buffer_drops_get(cpu), drops + 2U, "");
+
+	k_sched_unlock();
+}
+
+ZTEST(tracing_cpu_buffer, test_packet_too_large)
+{
+	uint32_t capacity = tracing_buffer_capacity_get();
+	uint8_t rec[RECORD_SIZE];
+	uint32_t drops;
+	unsigned int cpu;
+
+	zassert_true(capacity + 1U <= sizeof(big_record), "");
+
+	k_sched_lock();
+
+	cpu = _current_cpu->id;
+	drops = tracing_cpu_buffer_drops_get(cpu);
+
+	/* Fits the buffer of the CPU, but could never be merged */
+	zassert_false(record_put(1, 0, big_record, capacity + 1U), "");
+	zassert_equal(tracing_cpu_buffer_drops_get(cpu), drops + 1U, "");
+
+	/* Fills the whole tracing buffer */
+	zassert_true(record_put(1, 1, big_record, capacity), "put failed");
+	tracing_cpu_buffer_merge();
+	zassert_equal(tracing_buffer_space_get(), 0U, "");
+
+	/* Waits in the buffer of the CPU until there is room */
+	zassert_true(record_put(0, 2, rec, sizeof(rec)), "put failed");
+	tracing_cpu_buffer_merge();
+	zassert_equal(tracing_buffer_space_get(), 0U, "");
+
+	zassert_equal(record_get(big_record, capacity), capacity, "");
+	record_check(big_record, capacity, 1, 1);
+
+	tracing_cpu_buffer_merge();
+	zassert_equal(record_get(rec, sizeof(rec)), sizeof(rec), "");
+	record_check(rec, sizeof(rec), 0, 2);
+	zassert_true(tracing_buffer_is_empty(), "");
+
+	zassert_equal(tracing_cpu_buffer_drops_get(cpu), drops + 1U, "");
+
+	k_sched_unlock();
+}
+
+static void ordered_producer(void *p1, void *p2, void *p3)
+{
+	uint8_t id = POINTER_TO_UINT(p1);
+	uint32_t count = POINTER_TO_UINT(p2);
+	uint8_t rec[RECORD_SIZE];
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0U; i < count; i++) {
+		k_sem_take(&producer_turns[id], K_FOREVER);
+		zassert_true(record_put(id, i * NUM_PRODUCERS + id, rec,
+					sizeof(rec)), "put failed");
+		k_sem_give(&producer_done);
+	}
+}
+
+ZTEST(tracing_cpu_buffer, test_merge_order)
+{
+	const uint32_t total = 10U * NUM_PRODUCERS;
+	int prio = k_thread_priority_get(k_current_get());
+	uint8_t rec[RECORD_SIZE];
+	uint32_t drops = drops_total();
+	uint16_t seq;
+
+	zassert_true(NUM_PRODUCERS * RECORD_SIZE <=
+		     tracing_buffer_capacity_get(), "");
+
+	k_sem_reset(&producer_done);
+
+	/* The packets are put one after the other, in turn by threads which
+	 * may run on different CPUs, so the merge has to follow their
+	 * timestamps across the buffers to keep their order.
+	 */
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_sem_init(&producer_turns[i], 0, 1);
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				PRODUCER_STACK_SIZE, ordered_producer,
+				UINT_TO_POINTER(i),
+				UINT_TO_POINTER(total / NUM_PRODUCERS), NULL,
+				prio - 1, 0, K_NO_WAIT);
+	}
+
+	for (seq = 0U; seq < total; seq++) {
+		k_sem_give(&producer_turns[seq % NUM_PRODUCERS]);
+		k_sem_take(&producer_done, K_FOREVER);
+
+		if ((seq % NUM_PRODUCERS) != NUM_PRODUCERS - 1) {
+			continue;
+		}
+
+		tracing_cpu_buffer_merge();
+
+		for (uint16_t i = seq + 1U - NUM_PRODUCERS; i <= seq; i++) {
+			zassert_equal(record_get(rec, sizeof(rec)), sizeof(rec),
+				      "packet %u missing", i);
+			record_check(rec, sizeof(rec), i % NUM_PRODUCERS, i);
+		}
+	}
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(drops_total(), drops, "");
+}
+
+static void free_producer(void *p1, void *p2, void *p3)
+{
+	uint8_t id = POINTER_TO_UINT(p1);
+	uint8_t rec[RECORD_SIZE];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint16_t seq = 0U; seq < PRODUCER_RECORDS; seq++) {
+		(void)record_put(id, seq, rec, sizeof(rec));
+		k_yield();
+	}
+
+	k_sem_give(&producer_done);
+}
+
+ZTEST(tracing_cpu_buffer, test_concurrent_producers)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	int next_seq[NUM_PRODUCERS] = { 0 };
+	uint8_t rec[RECORD_SIZE];
+	uint32_t drops = drops_total();
+	uint32_t received = 0U;
+	uint32_t done = 0U;
+	uint16_t seq;
+	uint8_t id;
+
+	k_sem_reset(&producer_done);
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				PRODUCER_STACK_SIZE, free_producer,
+				UINT_TO_POINTER(i), NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	/* Merged while the packets are put. The packets of each producer
+	 * come out in order, less the dropped ones.
+	 */
+	while (true) {
+		while (k_sem_take(&producer_done, K_NO_WAIT) == 0) {
+			done++;
+		}
+
+		tracing_cpu_buffer_merge();
+
+		if ((done == NUM_PRODUCERS) && tracing_buffer_is_empty()) {
+			break;
+		}
+
+		while (record_get(rec, sizeof(rec)) == sizeof(rec)) {
+			id = rec[0];
+			seq = sys_get_le16(&rec[1]);
+
+			zassert_true(id < NUM_PRODUCERS, "bad producer %u", id);
+			zassert_true(seq >= next_seq[id],
+				     "packet %u of %u after %u", seq, id,
+				     next_seq[id] - 1);
+			record_check(rec, sizeof(rec), id, seq);
+
+			next_seq[id] = seq + 1;
+			received++;
+		}
+
+		k_yield();
+	}
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+
+	zassert_true(received > 0U, "");
+	zassert_equal(received + drops_total() - drops,
+		      NUM_PRODUCERS * PRODUCER_RECORDS, "%u received, %u dropped",
+		      received, drops_total() - drops);
+}
+
+ZTEST_SUITE(tracing_cpu_buffer, NULL, tracing_cpu_buffer_setup,
+	    tracing_cpu_buffer_before, NULL, NULL);